@@ -0,0 +1,353 @@
+// -----------------------------------------------------------------
+// Audio Replay - The firmware's audio analysis on a Linux/macOS host
+//
+// Compiles goertzel.cpp, tempo.cpp, audio_frame.cpp and microphone.h
+// unchanged against the shims in host/shims, feeds a 16 kHz WAV file (or a
+// synthetic beat track) through the I2S ingest path one 128-sample chunk at
+// a time, and runs each frame through analyze_audio_frame() (audio_frame.h),
+// as audio_task does. Each published AudioDataSnapshot can be written to a
+// trace (audio_trace.h) and compared against a reference trace; the time
+// spent in each stage is reported as ns/frame.
+//
+// Host ns/frame are for comparing builds on one machine, not ESP32-S3
+// budgets (different core, -O2 instead of -Os, no cache misses on flash).
+//
+//   audio_replay song.wav --trace song.k1trace        reference run
+//   audio_replay song.wav --compare song.k1trace      after a DSP change
+//   audio_replay --synth 30 --engine cqt              benchmark, no input file
+
+#include <Arduino.h>
+#include <driver/i2s_std.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "audio/goertzel.h"
+#include "audio/tempo.h"
+#include "audio/audio_frame.h"
+#include "audio/microphone.h"
+#include "test_utils/wav_io.h"
+#include "audio_trace.h"
+
+static_assert(NOVELTY_PERIOD_US == AUDIO_FRAME_US, "tempo bins are labelled for one novelty sample per audio frame");
+
+// Per-frame stages, timed separately: ingest, then the analyze_audio_frame() stages
+#define STAGE_INGEST 0           // acquire_sample_chunk(): I2S read, DC block, histories
+#define STAGE_COUNT (1 + AUDIO_STAGE_COUNT)
+
+static const char* stage_name(int stage) {
+	return stage == STAGE_INGEST ? "ingest" : AUDIO_FRAME_STAGE_NAMES[stage - 1];
+}
+
+typedef struct {
+	const char* input;
+	float synth_seconds;
+	const char* save_input;
+	const char* trace;
+	const char* compare;
+	float tolerance;
+	int engine;
+	int quality;
+	float expect_bpm;
+	bool quiet;
+} replay_options;
+
+static uint64_t host_ns() {
+	using namespace std::chrono;
+	return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void usage() {
+	fprintf(stderr,
+	        "usage: audio_replay (<input.wav> | --synth SECONDS) [options]\n"
+	        "  --trace OUT          write every published snapshot to OUT\n"
+	        "  --compare REF        compare against trace REF, fail above --tolerance\n"
+	        "  --tolerance X        largest allowed difference per feature (default 0)\n"
+	        "  --engine NAME        goertzel (default) or cqt\n"
+	        "  --quality LEVEL      hold the quality governor level 0-%d (default 0)\n"
+	        "  --save-input OUT     write the replayed input as 16-bit WAV (e.g. the synth track)\n"
+	        "  --expect-bpm BPM     fail unless the strongest tempo bin ends within 3 BPM\n"
+	        "  --quiet              timing table only\n",
+	        QUALITY_LEVELS - 1);
+}
+
+static bool parse_options(int argc, char** argv, replay_options& options) {
+	options = {};
+	options.engine = SPECTRAL_ENGINE_GOERTZEL;
+	for (int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		if (strcmp(arg, "--synth") == 0 && has_value) {
+			options.synth_seconds = (float)atof(argv[++i]);
+		} else if (strcmp(arg, "--trace") == 0 && has_value) {
+			options.trace = argv[++i];
+		} else if (strcmp(arg, "--compare") == 0 && has_value) {
+			options.compare = argv[++i];
+		} else if (strcmp(arg, "--tolerance") == 0 && has_value) {
+			options.tolerance = (float)atof(argv[++i]);
+		} else if (strcmp(arg, "--engine") == 0 && has_value) {
+			const char* name = argv[++i];
+			if (strcmp(name, "goertzel") == 0) {
+				options.engine = SPECTRAL_ENGINE_GOERTZEL;
+			} else if (strcmp(name, "cqt") == 0) {
+				options.engine = SPECTRAL_ENGINE_CQT;
+			} else {
+				return false;
+			}
+		} else if (strcmp(arg, "--quality") == 0 && has_value) {
+			options.quality = atoi(argv[++i]);
+			if (options.quality < 0 || options.quality >= QUALITY_LEVELS) {
+				return false;
+			}
+		} else if (strcmp(arg, "--save-input") == 0 && has_value) {
+			options.save_input = argv[++i];
+		} else if (strcmp(arg, "--expect-bpm") == 0 && has_value) {
+			options.expect_bpm = (float)atof(argv[++i]);
+		} else if (strcmp(arg, "--quiet") == 0) {
+			options.quiet = true;
+		} else if (arg[0] != '-' && options.input == NULL) {
+			options.input = arg;
+		} else {
+			return false;
+		}
+	}
+	return (options.input != NULL) != (options.synth_seconds > 0.0f);
+}
+
+// 120 BPM: kick on the beat, hi-hat off the beat, a quiet A minor pad
+// Quantized to the 16-bit grid so a saved copy replays bit-identically
+static std::vector<float> synth_track(float seconds) {
+	const uint32_t count = (uint32_t)(seconds * SAMPLE_RATE);
+	const float beat_s = 0.5f;
+	std::vector<float> samples(count);
+	uint32_t noise = 22222;
+	for (uint32_t n = 0; n < count; n++) {
+		const float t = (float)n / SAMPLE_RATE;
+		const float in_beat = fmodf(t, beat_s);
+		const float off_beat = fmodf(t + beat_s / 2.0f, beat_s);
+
+		float x = 0.04f * (sinf(2.0f * (float)M_PI * 220.0f * t) + sinf(2.0f * (float)M_PI * 261.63f * t) +
+		                   sinf(2.0f * (float)M_PI * 329.63f * t));
+
+		// Kick: pitch drops 120 -> 50 Hz over its decay
+		const float kick_freq = 50.0f + 70.0f * expf(-in_beat * 30.0f);
+		x += 0.6f * expf(-in_beat * 12.0f) * sinf(2.0f * (float)M_PI * kick_freq * in_beat);
+
+		noise = noise * 1664525u + 1013904223u;
+		const float white = (float)(int32_t)noise / 2147483648.0f;
+		x += 0.15f * expf(-off_beat * 60.0f) * white;
+
+		samples[n] = roundf(fmaxf(-1.0f, fminf(x, 32767.0f / 32768.0f)) * 32768.0f) / 32768.0f;
+	}
+	return samples;
+}
+
+// -1.0 to 1.0 sample to the SPH0645's 18-bit left-justified I2S slot
+static int32_t sample_to_slot(float sample) {
+	int32_t value = (int32_t)lrintf(sample * I2S_SAMPLE_LIMIT);
+	value = value > I2S_SAMPLE_LIMIT - 1 ? I2S_SAMPLE_LIMIT - 1 : (value < -I2S_SAMPLE_LIMIT ? -I2S_SAMPLE_LIMIT : value);
+	return (int32_t)((uint32_t)value << I2S_SAMPLE_SHIFT);
+}
+
+// Boot order of setup() in main.cpp
+static void init_audio_pipeline(const replay_options& options) {
+	host_clock_set_us(0);
+	init_audio_stubs();
+	init_i2s_microphone();
+	init_audio_data_sync();
+	init_window_lookup();
+	init_goertzel_constants_musical();
+	init_noise_profile();
+	init_tempo_goertzel_constants();
+	configuration.spectral_engine = (uint8_t)options.engine;
+
+	const audio_quality quality = audio_quality_for_level((uint8_t)options.quality);
+	set_spectral_quality(quality);
+	set_tempo_quality(quality);
+	attach_sample_chunk_consumer(xTaskGetCurrentTaskHandle());
+}
+
+// analyze_audio_frame() hook: time since the previous stage finished
+typedef struct {
+	uint64_t last_ns;
+	uint64_t* stage_ns;
+} stage_timer;
+
+static void time_stage(audio_frame_stage finished, void* context) {
+	stage_timer* timer = (stage_timer*)context;
+	const uint64_t now = host_ns();
+	timer->stage_ns[1 + finished] = now - timer->last_ns;
+	timer->last_ns = now;
+}
+
+static uint64_t percentile_ns(std::vector<uint64_t>& values, float fraction) {
+	const size_t rank = (size_t)(fraction * (values.size() - 1));
+	std::nth_element(values.begin(), values.begin() + rank, values.end());
+	return values[rank];
+}
+
+int main(int argc, char** argv) {
+	replay_options options;
+	if (!parse_options(argc, argv, options)) {
+		usage();
+		return 1;
+	}
+
+	std::vector<float> samples;
+	if (options.input != NULL) {
+		WavData wav;
+		const char* error = NULL;
+		if (!wav_load(options.input, wav, &error)) {
+			fprintf(stderr, "%s: %s\n", options.input, error);
+			return 1;
+		}
+		if (wav.sample_rate != SAMPLE_RATE) {
+			fprintf(stderr, "%s: %u Hz, the analysis needs %u Hz (sox %s -r %u out.wav)\n",
+			        options.input, wav.sample_rate, SAMPLE_RATE, options.input, SAMPLE_RATE);
+			return 1;
+		}
+		samples.swap(wav.samples);
+	} else {
+		samples = synth_track(options.synth_seconds);
+	}
+	if (options.save_input != NULL && !wav_save_mono16(options.save_input, samples.data(), samples.size(), SAMPLE_RATE)) {
+		fprintf(stderr, "%s: cannot write\n", options.save_input);
+		return 1;
+	}
+
+	audio_trace trace = {};
+	if (options.trace != NULL && !audio_trace_create(trace, options.trace, AUDIO_FRAME_US)) {
+		fprintf(stderr, "%s: cannot write\n", options.trace);
+		return 1;
+	}
+	audio_trace reference = {};
+	audio_trace_difference differences[AUDIO_TRACE_FEATURE_COUNT] = {};
+	if (options.compare != NULL) {
+		const char* error = NULL;
+		if (!audio_trace_open(reference, options.compare, &error)) {
+			fprintf(stderr, "%s: %s\n", options.compare, error);
+			return 1;
+		}
+	}
+
+	init_audio_pipeline(options);
+
+	// audio_task, one DMA buffer at a time on the virtual clock
+	const uint32_t chunks = (uint32_t)(samples.size() / CHUNK_SIZE);
+	std::vector<uint64_t> stage_ns[STAGE_COUNT];
+	std::vector<uint64_t> frame_ns;
+	uint32_t frames = 0;
+	uint32_t reference_frames = 0;
+	int32_t slots[CHUNK_SIZE];
+	for (uint32_t c = 0; c < chunks; c++) {
+		for (uint16_t i = 0; i < CHUNK_SIZE; i++) {
+			slots[i] = sample_to_slot(samples[c * CHUNK_SIZE + i]);
+		}
+		host_clock_set_us((int64_t)(c + 1) * AUDIO_CHUNK_US);
+		host_i2s_receive(slots, CHUNK_SIZE);
+
+		uint32_t newest_us = 0;
+		const uint32_t found = wait_for_sample_chunks(AUDIO_CHUNKS_PER_FRAME, pdMS_TO_TICKS(AUDIO_CHUNK_TIMEOUT_MS), &newest_us);
+		if (found < AUDIO_CHUNKS_PER_FRAME) {
+			continue;
+		}
+
+		uint64_t ns[STAGE_COUNT] = {};
+		const uint64_t ingest_start = host_ns();
+		uint32_t taken = 0;
+		while (taken < found && acquire_sample_chunk()) {
+			taken++;
+		}
+		consume_sample_chunks(found);
+		ns[STAGE_INGEST] = host_ns() - ingest_start;
+
+		stage_timer timer = { host_ns(), ns };
+		analyze_audio_frame(taken > 0 ? newest_us : 0, time_stage, &timer);
+		uint64_t total = 0;
+		for (int s = 0; s < STAGE_COUNT; s++) {
+			stage_ns[s].push_back(ns[s]);
+			total += ns[s];
+		}
+		frame_ns.push_back(total);
+
+		if (options.trace != NULL && !audio_trace_write(trace, audio_front)) {
+			fprintf(stderr, "%s: write failed\n", options.trace);
+			return 1;
+		}
+		AudioDataSnapshot expected;
+		if (options.compare != NULL && audio_trace_read(reference, expected)) {
+			audio_trace_compare(audio_front, expected, frames, differences);
+			reference_frames++;
+		}
+		frames++;
+	}
+
+	if (options.trace != NULL && !audio_trace_close(trace)) {
+		fprintf(stderr, "%s: write failed\n", options.trace);
+		return 1;
+	}
+	if (frames == 0) {
+		fprintf(stderr, "no complete %u-sample chunk in the input\n", CHUNK_SIZE);
+		return 1;
+	}
+
+	// Timing table
+	const char* engine = options.engine == SPECTRAL_ENGINE_CQT ? "cqt" : "goertzel";
+	printf("%u frames (%.1f s of audio), engine %s, quality level %d%s\n",
+	       frames, frames * AUDIO_FRAME_US / 1e6f, engine, options.quality, AUDIO_FIXED_POINT ? ", fixed point" : "");
+	printf("%-22s %10s %10s %10s\n", "stage", "mean ns", "p99 ns", "max ns");
+	for (int s = 0; s <= STAGE_COUNT; s++) {
+		std::vector<uint64_t>& values = s < STAGE_COUNT ? stage_ns[s] : frame_ns;
+		uint64_t sum = 0;
+		for (uint64_t v : values) {
+			sum += v;
+		}
+		const uint64_t max_ns = *std::max_element(values.begin(), values.end());
+		printf("%-22s %10llu %10llu %10llu\n", s < STAGE_COUNT ? stage_name(s) : "frame",
+		       (unsigned long long)(sum / values.size()), (unsigned long long)percentile_ns(values, 0.99f),
+		       (unsigned long long)max_ns);
+	}
+	uint64_t frame_sum = 0;
+	for (uint64_t v : frame_ns) {
+		frame_sum += v;
+	}
+	printf("%.0fx real time on this host\n", (double)AUDIO_FRAME_US * 1000.0 * frames / frame_sum);
+
+	// Where the tempo tracker ended up
+	uint16_t strongest = 0;
+	for (uint16_t i = 1; i < NUM_TEMPI; i++) {
+		if (audio_front.tempo_magnitude[i] > audio_front.tempo_magnitude[strongest]) {
+			strongest = i;
+		}
+	}
+	const float strongest_bpm = tempi_bpm_values_hz[strongest] * 60.0f;
+	if (!options.quiet) {
+		printf("strongest tempo %.1f BPM (confidence %.2f), vu %.3f\n", strongest_bpm, audio_front.tempo_confidence, audio_front.vu_level);
+	}
+
+	int status = 0;
+	if (options.compare != NULL) {
+		if (reference_frames != frames || reference.header.frames != frames) {
+			printf("compare: %u frames replayed, reference has %u\n", frames, reference.header.frames);
+			status = 2;
+		}
+		for (size_t f = 0; f < AUDIO_TRACE_FEATURE_COUNT; f++) {
+			const bool over = differences[f].max_difference > options.tolerance;
+			if (over || !options.quiet) {
+				printf("compare: %-20s max difference %.3g (frame %u, index %u)%s\n", AUDIO_TRACE_FEATURES[f].name,
+				       differences[f].max_difference, differences[f].worst_frame, differences[f].worst_index,
+				       over ? "  OVER TOLERANCE" : "");
+			}
+			if (over) {
+				status = 2;
+			}
+		}
+		fclose(reference.file);
+	}
+	if (options.expect_bpm > 0.0f && fabsf(strongest_bpm - options.expect_bpm) > 3.0f) {
+		printf("expected %.1f BPM, strongest tempo is %.1f BPM\n", options.expect_bpm, strongest_bpm);
+		status = 2;
+	}
+	return status;
+}
@@ -0,0 +1,163 @@
+// -----------------------------------------------------------------
+// Audio Trace - Per-frame AudioDataSnapshot dump of a host replay
+//
+// A trace is a header followed by one raw AudioDataSnapshot per analysis
+// frame (the slot published by finish_audio_frame()). Records are the
+// host's in-memory layout, so traces are compared by the same build
+// that wrote them (the header carries the record size and array lengths
+// to catch a layout change).
+//
+// audio_trace_compare() is the regression oracle: it walks two traces
+// feature by feature and reports the largest difference in each, so a
+// DSP optimization can be checked against a reference replay of the same
+// recording before it goes near hardware.
+//
+// Host only (stdio); include after goertzel.h.
+
+#ifndef AUDIO_TRACE_H
+#define AUDIO_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define AUDIO_TRACE_MAGIC 0x5441314Bu      // "K1AT"
+#define AUDIO_TRACE_VERSION 1
+
+typedef struct {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t header_bytes;
+	uint32_t record_bytes;               // sizeof(AudioDataSnapshot)
+	uint16_t num_freqs;
+	uint16_t num_tempi;
+	uint16_t num_fft_bins;
+	uint16_t fixed_point;                // AUDIO_FIXED_POINT of the writing build
+	uint32_t sample_rate;
+	uint32_t frame_us;
+	uint32_t frames;                     // Filled in by audio_trace_close()
+} audio_trace_header;
+
+typedef struct {
+	FILE* file;
+	audio_trace_header header;
+} audio_trace;
+
+inline audio_trace_header audio_trace_expected_header(uint32_t frame_us) {
+	audio_trace_header header = {};
+	header.magic = AUDIO_TRACE_MAGIC;
+	header.version = AUDIO_TRACE_VERSION;
+	header.header_bytes = sizeof(audio_trace_header);
+	header.record_bytes = sizeof(AudioDataSnapshot);
+	header.num_freqs = NUM_FREQS;
+	header.num_tempi = NUM_TEMPI;
+	header.num_fft_bins = NUM_FFT_BINS;
+	header.fixed_point = AUDIO_FIXED_POINT;
+	header.sample_rate = SAMPLE_RATE;
+	header.frame_us = frame_us;
+	return header;
+}
+
+inline bool audio_trace_create(audio_trace& trace, const char* path, uint32_t frame_us) {
+	trace.file = fopen(path, "wb");
+	trace.header = audio_trace_expected_header(frame_us);
+	return trace.file != NULL && fwrite(&trace.header, sizeof(trace.header), 1, trace.file) == 1;
+}
+
+inline bool audio_trace_write(audio_trace& trace, const AudioDataSnapshot& snapshot) {
+	trace.header.frames++;
+	return fwrite(&snapshot, sizeof(snapshot), 1, trace.file) == 1;
+}
+
+// Rewrites the header with the frame count
+inline bool audio_trace_close(audio_trace& trace) {
+	bool ok = fseek(trace.file, 0, SEEK_SET) == 0 && fwrite(&trace.header, sizeof(trace.header), 1, trace.file) == 1;
+	ok = fclose(trace.file) == 0 && ok;
+	trace.file = NULL;
+	return ok;
+}
+
+// Opens a trace for reading; false if missing or written by a build with another layout
+inline bool audio_trace_open(audio_trace& trace, const char* path, const char** error) {
+	trace.file = fopen(path, "rb");
+	if (trace.file == NULL) {
+		*error = "cannot open trace";
+		return false;
+	}
+	const audio_trace_header expected = audio_trace_expected_header(0);
+	if (fread(&trace.header, sizeof(trace.header), 1, trace.file) != 1 || trace.header.magic != AUDIO_TRACE_MAGIC) {
+		*error = "not an audio trace";
+	} else if (trace.header.version != AUDIO_TRACE_VERSION || trace.header.header_bytes != expected.header_bytes ||
+	           trace.header.record_bytes != expected.record_bytes || trace.header.num_freqs != expected.num_freqs ||
+	           trace.header.num_tempi != expected.num_tempi || trace.header.num_fft_bins != expected.num_fft_bins) {
+		*error = "trace written by a build with a different snapshot layout";
+	} else {
+		return true;
+	}
+	fclose(trace.file);
+	trace.file = NULL;
+	return false;
+}
+
+inline bool audio_trace_read(audio_trace& trace, AudioDataSnapshot& snapshot) {
+	return fread(&snapshot, sizeof(snapshot), 1, trace.file) == 1;
+}
+
+// Features the oracle compares (float arrays inside the snapshot)
+typedef struct {
+	const char* name;
+	size_t offset;
+	uint16_t count;
+	bool phase;                          // Radians, compared around the circle
+} audio_trace_feature;
+
+#define AUDIO_TRACE_FEATURE(field, count) { #field, offsetof(AudioDataSnapshot, field), (uint16_t)(count), false }
+#define AUDIO_TRACE_PHASE(field, count) { #field, offsetof(AudioDataSnapshot, field), (uint16_t)(count), true }
+
+static const audio_trace_feature AUDIO_TRACE_FEATURES[] = {
+	AUDIO_TRACE_FEATURE(spectrogram, NUM_FREQS),
+	AUDIO_TRACE_FEATURE(spectrogram_smooth, NUM_FREQS),
+	AUDIO_TRACE_FEATURE(chromagram, 12),
+	AUDIO_TRACE_FEATURE(vu_level, 1),
+	AUDIO_TRACE_FEATURE(novelty_curve, 1),
+	AUDIO_TRACE_FEATURE(tempo_confidence, 1),
+	AUDIO_TRACE_FEATURE(tempo_magnitude, NUM_TEMPI),
+	AUDIO_TRACE_PHASE(tempo_phase, NUM_TEMPI),
+	AUDIO_TRACE_FEATURE(fft_smooth, NUM_FFT_BINS),
+	AUDIO_TRACE_FEATURE(pitch_hz, 1),
+	AUDIO_TRACE_FEATURE(pitch_clarity, 1),
+};
+#define AUDIO_TRACE_FEATURE_COUNT (sizeof(AUDIO_TRACE_FEATURES) / sizeof(AUDIO_TRACE_FEATURES[0]))
+
+typedef struct {
+	float max_difference;
+	uint32_t worst_frame;
+	uint16_t worst_index;
+} audio_trace_difference;
+
+// Largest difference per feature between two snapshots, folded into `result`
+inline void audio_trace_compare(const AudioDataSnapshot& a, const AudioDataSnapshot& b, uint32_t frame,
+                                audio_trace_difference result[AUDIO_TRACE_FEATURE_COUNT]) {
+	for (size_t f = 0; f < AUDIO_TRACE_FEATURE_COUNT; f++) {
+		const float* values_a = (const float*)((const uint8_t*)&a + AUDIO_TRACE_FEATURES[f].offset);
+		const float* values_b = (const float*)((const uint8_t*)&b + AUDIO_TRACE_FEATURES[f].offset);
+		for (uint16_t i = 0; i < AUDIO_TRACE_FEATURES[f].count; i++) {
+			float difference = fabsf(values_a[i] - values_b[i]);
+			if (AUDIO_TRACE_FEATURES[f].phase && difference > (float)M_PI) {
+				difference = 2.0f * (float)M_PI - fmodf(difference, 2.0f * (float)M_PI);
+			}
+			if (isnan(difference)) {
+				difference = INFINITY;
+			}
+			if (difference > result[f].max_difference) {
+				result[f].max_difference = difference;
+				result[f].worst_frame = frame;
+				result[f].worst_index = i;
+			}
+		}
+	}
+}
+
+#endif  // AUDIO_TRACE_H
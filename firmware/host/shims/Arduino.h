@@ -0,0 +1,45 @@
+// -----------------------------------------------------------------
+// Host shim: the slice of Arduino-ESP32 the audio sources use
+//
+// Timing comes from the replay's virtual clock (esp_timer.h); Serial
+// (logger output) goes to stderr so stdout stays free for reports.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+
+using std::min;
+using std::max;
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define PROGMEM
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+inline uint32_t micros() { return (uint32_t)esp_timer_get_time(); }
+inline uint32_t millis() { return (uint32_t)(esp_timer_get_time() / 1000); }
+inline void delay(uint32_t) {}
+
+class HostSerial {
+public:
+	void begin(unsigned long) {}
+	void print(const char* text) { fputs(text, stderr); }
+	void println(const char* text = "") { fputs(text, stderr); fputc('\n', stderr); }
+	template <typename... Args> void printf(const char* format, Args... args) { fprintf(stderr, format, args...); }
+	void flush() { fflush(stderr); }
+	explicit operator bool() const { return true; }
+};
+extern HostSerial Serial;
+
+#endif  // HOST_ARDUINO_H
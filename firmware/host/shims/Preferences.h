@@ -0,0 +1,24 @@
+// -----------------------------------------------------------------
+// Host shim: NVS-backed Preferences with nothing stored
+//
+// init_noise_profile() finds no profile and calibrates on the first
+// NOISE_CALIBRATION_FRAMES of the replay, as a freshly flashed unit does.
+
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Preferences {
+public:
+	bool begin(const char*, bool = false) { return true; }
+	void end() {}
+	size_t putBytes(const char*, const void*, size_t length) { return length; }
+	size_t getBytes(const char*, void*, size_t) { return 0; }
+	size_t getBytesLength(const char*) { return 0; }
+	bool putBool(const char*, bool) { return true; }
+	bool getBool(const char*, bool fallback = false) { return fallback; }
+};
+
+#endif  // HOST_PREFERENCES_H
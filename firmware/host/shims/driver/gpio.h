@@ -0,0 +1,9 @@
+// -----------------------------------------------------------------
+// Host shim: GPIO types live in i2s_std.h
+
+#ifndef HOST_DRIVER_GPIO_H
+#define HOST_DRIVER_GPIO_H
+
+#include "i2s_std.h"
+
+#endif  // HOST_DRIVER_GPIO_H
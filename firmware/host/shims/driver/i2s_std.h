@@ -0,0 +1,95 @@
+// -----------------------------------------------------------------
+// Host shim: ESP-IDF v5 I2S standard-mode RX channel
+//
+// Stands in for the DMA queue behind microphone.h. The replay hands raw
+// 32-bit I2S slots to host_i2s_receive(), which queues them (dropping the
+// oldest buffer when the queue is full, like the driver) and runs the RX
+// callbacks; i2s_channel_read() copies out of the queue without waiting.
+
+#ifndef HOST_DRIVER_I2S_STD_H
+#define HOST_DRIVER_I2S_STD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_ERR_TIMEOUT 0x107
+
+typedef int gpio_num_t;
+typedef struct i2s_channel_obj_t* i2s_chan_handle_t;
+
+typedef enum { I2S_ROLE_MASTER = 0 } i2s_role_t;
+typedef struct {
+	int id;
+	i2s_role_t role;
+	uint32_t dma_desc_num;
+	uint32_t dma_frame_num;
+} i2s_chan_config_t;
+
+#define I2S_NUM_AUTO (-1)
+#define I2S_CHANNEL_DEFAULT_CONFIG(num, rl) { (int)(num), (rl), 6, 240 }
+
+typedef enum { I2S_DATA_BIT_WIDTH_32BIT = 32 } i2s_data_bit_width_t;
+typedef enum { I2S_SLOT_BIT_WIDTH_32BIT = 32 } i2s_slot_bit_width_t;
+typedef enum { I2S_SLOT_MODE_STEREO = 2 } i2s_slot_mode_t;
+
+#define I2S_STD_SLOT_RIGHT (1u << 1)
+#define I2S_GPIO_UNUSED ((gpio_num_t)-1)
+
+typedef struct {
+	uint32_t sample_rate_hz;
+} i2s_std_clk_config_t;
+#define I2S_STD_CLK_DEFAULT_CONFIG(rate) { (rate) }
+
+typedef struct {
+	i2s_data_bit_width_t data_bit_width;
+	i2s_slot_bit_width_t slot_bit_width;
+	i2s_slot_mode_t slot_mode;
+	uint32_t slot_mask;
+	uint32_t ws_width;
+	bool ws_pol;
+	bool bit_shift;
+	bool left_align;
+	bool big_endian;
+	bool bit_order_lsb;
+} i2s_std_slot_config_t;
+
+typedef struct {
+	int mclk;
+	gpio_num_t bclk;
+	gpio_num_t ws;
+	int dout;
+	gpio_num_t din;
+	struct { bool mclk_inv; bool bclk_inv; bool ws_inv; } invert_flags;
+} i2s_std_gpio_config_t;
+
+typedef struct {
+	i2s_std_clk_config_t clk_cfg;
+	i2s_std_slot_config_t slot_cfg;
+	i2s_std_gpio_config_t gpio_cfg;
+} i2s_std_config_t;
+
+typedef struct {
+	void* data;
+	size_t size;
+} i2s_event_data_t;
+typedef bool (*i2s_isr_callback_t)(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx);
+typedef struct {
+	i2s_isr_callback_t on_recv;
+	i2s_isr_callback_t on_recv_q_ovf;
+	i2s_isr_callback_t on_sent;
+	i2s_isr_callback_t on_send_q_ovf;
+} i2s_event_callbacks_t;
+
+esp_err_t i2s_new_channel(const i2s_chan_config_t* cfg, i2s_chan_handle_t* tx_handle, i2s_chan_handle_t* rx_handle);
+esp_err_t i2s_channel_init_std_mode(i2s_chan_handle_t handle, const i2s_std_config_t* std_cfg);
+esp_err_t i2s_channel_enable(i2s_chan_handle_t handle);
+esp_err_t i2s_channel_read(i2s_chan_handle_t handle, void* data, size_t size, size_t* bytes_read, uint32_t timeout_ticks);
+esp_err_t i2s_channel_register_event_callback(i2s_chan_handle_t handle, const i2s_event_callbacks_t* callbacks, void* user_data);
+
+// Replay side: one DMA buffer of raw I2S slots has completed
+void host_i2s_receive(const int32_t* slots, size_t count);
+
+#endif  // HOST_DRIVER_I2S_STD_H
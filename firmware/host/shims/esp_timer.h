@@ -0,0 +1,18 @@
+// -----------------------------------------------------------------
+// Host shim: esp_timer on the replay's virtual clock
+//
+// The replay sets the clock to each chunk's DMA completion time, so
+// timestamps, the measured novelty rate and every trace are reproducible
+// regardless of how fast the host runs the analysis.
+
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time();
+
+// Replay side
+void host_clock_set_us(int64_t now_us);
+
+#endif  // HOST_ESP_TIMER_H
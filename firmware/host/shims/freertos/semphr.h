@@ -0,0 +1,13 @@
+// -----------------------------------------------------------------
+// Host shim: mutexes (always available, single-threaded replay)
+
+#ifndef HOST_FREERTOS_SEMPHR_H
+#define HOST_FREERTOS_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { static int mutex; return &mutex; }
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+
+#endif  // HOST_FREERTOS_SEMPHR_H
@@ -0,0 +1,18 @@
+// -----------------------------------------------------------------
+// Host shim: task notifications
+//
+// The replay pushes a chunk before it asks for one, so a wait never has
+// to block: ulTaskNotifyTake() reports one notification and the caller
+// re-checks the chunk clock.
+
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+inline void vTaskDelay(TickType_t) {}
+inline void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t*) {}
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 1; }
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return NULL; }
+
+#endif  // HOST_FREERTOS_TASK_H
@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------
+// Host Platform - Definitions behind the shims
+//
+// Virtual clock, Serial and the I2S RX queue for the host replay build.
+// Everything here is single-threaded: the replay plays both the DMA
+// interrupt (host_i2s_receive) and the audio task.
+
+#include <Arduino.h>
+#include <driver/i2s_std.h>
+#include <deque>
+#include <vector>
+
+HostSerial Serial;
+
+static int64_t host_now_us = 0;
+
+int64_t esp_timer_get_time() {
+	return host_now_us;
+}
+
+void host_clock_set_us(int64_t now_us) {
+	host_now_us = now_us;
+}
+
+// One RX channel, as on the board
+static struct {
+	i2s_chan_config_t config;
+	i2s_event_callbacks_t callbacks;
+	void* user_data;
+	bool enabled;
+	std::deque<std::vector<int32_t>> buffers;   // Completed DMA buffers, oldest first
+	size_t read_offset;                         // Bytes already read from the oldest
+} host_rx = {};
+
+static i2s_chan_handle_t host_rx_handle() {
+	return (i2s_chan_handle_t)&host_rx;
+}
+
+esp_err_t i2s_new_channel(const i2s_chan_config_t* cfg, i2s_chan_handle_t* tx_handle, i2s_chan_handle_t* rx_handle) {
+	host_rx.config = *cfg;
+	if (tx_handle != NULL) {
+		*tx_handle = NULL;
+	}
+	if (rx_handle != NULL) {
+		*rx_handle = host_rx_handle();
+	}
+	return ESP_OK;
+}
+
+esp_err_t i2s_channel_init_std_mode(i2s_chan_handle_t, const i2s_std_config_t*) {
+	return ESP_OK;
+}
+
+esp_err_t i2s_channel_enable(i2s_chan_handle_t) {
+	host_rx.enabled = true;
+	return ESP_OK;
+}
+
+esp_err_t i2s_channel_register_event_callback(i2s_chan_handle_t, const i2s_event_callbacks_t* callbacks, void* user_data) {
+	host_rx.callbacks = *callbacks;
+	host_rx.user_data = user_data;
+	return ESP_OK;
+}
+
+esp_err_t i2s_channel_read(i2s_chan_handle_t, void* data, size_t size, size_t* bytes_read, uint32_t) {
+	uint8_t* out = (uint8_t*)data;
+	size_t copied = 0;
+	while (copied < size && !host_rx.buffers.empty()) {
+		const std::vector<int32_t>& buffer = host_rx.buffers.front();
+		const size_t available = buffer.size() * sizeof(int32_t) - host_rx.read_offset;
+		const size_t take = std::min(available, size - copied);
+		memcpy(out + copied, (const uint8_t*)buffer.data() + host_rx.read_offset, take);
+		copied += take;
+		host_rx.read_offset += take;
+		if (host_rx.read_offset == buffer.size() * sizeof(int32_t)) {
+			host_rx.buffers.pop_front();
+			host_rx.read_offset = 0;
+		}
+	}
+	*bytes_read = copied;
+	return copied == size ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+void host_i2s_receive(const int32_t* slots, size_t count) {
+	if (!host_rx.enabled) {
+		return;
+	}
+
+	i2s_event_data_t event = {};
+	if (host_rx.buffers.size() >= host_rx.config.dma_desc_num) {
+		host_rx.buffers.pop_front();
+		host_rx.read_offset = 0;
+		if (host_rx.callbacks.on_recv_q_ovf != NULL) {
+			host_rx.callbacks.on_recv_q_ovf(host_rx_handle(), &event, host_rx.user_data);
+		}
+	}
+
+	host_rx.buffers.emplace_back(slots, slots + count);
+	event.data = host_rx.buffers.back().data();
+	event.size = count * sizeof(int32_t);
+	if (host_rx.callbacks.on_recv != NULL) {
+		host_rx.callbacks.on_recv(host_rx_handle(), &event, host_rx.user_data);
+	}
+}
@@ -0,0 +1,129 @@
+// -----------------------------------------------------------------
+// Audio Cadence - Chunk clock and frame timing for the audio task
+//
+// The audio task sleeps until the I2S RX-done callback has delivered a
+// frame's worth of chunks, instead of blocking inside i2s_channel_read()
+// and then sleeping a fixed tick. The callback side (chunk_clock_on_dma)
+// only counts bytes: DMA buffers need not line up with chunks, so each
+// completed chunk is stamped with the time its last sample arrived,
+// interpolated back from the interrupt time.
+//
+// The task side records how each frame went: late frames (more chunks
+// were waiting than one frame consumes, i.e. the previous frame overran),
+// dropped chunks, slack (time left before the next frame's chunks are
+// due) and latency (last sample in to frame published). Everything is a
+// counter or a min/max, so nothing is logged from the audio path. Readers
+// start a new min/max window with audio_cadence_request_window_reset(); the
+// task resets before its next frame, so the extremes are only written by it.
+
+#ifndef AUDIO_CADENCE_H
+#define AUDIO_CADENCE_H
+
+#include <stdint.h>
+
+// Written by the I2S callback, read by the audio task
+typedef struct {
+	uint32_t chunk_bytes;                // Bytes per chunk (as read by the task)
+	uint32_t chunk_us;                   // Duration of one chunk
+	uint32_t bytes_accum;                // Callback only: bytes towards the next chunk
+	volatile uint32_t chunks_ready;      // Callback: completed chunks (wraps)
+	volatile uint32_t chunk_time_us;     // Callback: arrival of the latest chunk's last sample
+	uint32_t chunks_taken;               // Task only: chunks consumed (wraps)
+} chunk_clock;
+
+// Frame timing counters (task writes; API reads, requests window resets)
+typedef struct {
+	volatile uint32_t frames;            // Frames analysed
+	volatile uint32_t chunks;            // Chunks ingested
+	volatile uint32_t late_frames;       // Frames that found a backlog
+	volatile uint32_t dropped_chunks;    // Chunks reported but no longer held by the driver
+	volatile uint32_t dma_overruns;      // I2S callback: buffers the driver dropped (queue full)
+	volatile uint32_t timeouts;          // Waits that ended without a chunk (microphone stalled)
+	volatile uint32_t read_errors;       // i2s_channel_read() failures
+	volatile int32_t slack_us_last;      // Next frame due minus frame done (< 0: overrun)
+	volatile int32_t slack_us_min;       // Window minimum
+	volatile uint32_t latency_us_last;   // Last sample in to frame published
+	volatile uint32_t latency_us_max;    // Window maximum
+	volatile bool window_reset_requested; // Set by a reader, honoured by the task
+} audio_cadence_stats;
+
+inline void chunk_clock_init(chunk_clock& clock, uint32_t chunk_bytes, uint32_t chunk_us) {
+	clock.chunk_bytes = chunk_bytes;
+	clock.chunk_us = chunk_us;
+	clock.bytes_accum = 0;
+	clock.chunks_ready = 0;
+	clock.chunk_time_us = 0;
+	clock.chunks_taken = 0;
+}
+
+// One DMA buffer of `bytes` completed at `now_us`; true if a chunk completed
+// (ISR context: arithmetic only)
+inline bool chunk_clock_on_dma(chunk_clock& clock, uint32_t bytes, uint32_t now_us) {
+	uint32_t accum = clock.bytes_accum + bytes;
+	if (accum < clock.chunk_bytes) {
+		clock.bytes_accum = accum;
+		return false;
+	}
+
+	uint32_t completed = accum / clock.chunk_bytes;
+	accum -= completed * clock.chunk_bytes;
+	clock.bytes_accum = accum;
+
+	// Bytes past the last chunk boundary arrived after it
+	clock.chunk_time_us = now_us - (uint32_t)(((uint64_t)accum * clock.chunk_us) / clock.chunk_bytes);
+	clock.chunks_ready = clock.chunks_ready + completed;
+	return true;
+}
+
+// Chunks delivered but not yet taken by the task
+inline uint32_t chunk_clock_pending(const chunk_clock& clock) {
+	return clock.chunks_ready - clock.chunks_taken;
+}
+
+inline void chunk_clock_take(chunk_clock& clock, uint32_t count) {
+	clock.chunks_taken += count;
+}
+
+// Start of a stats window (task side: boot, or a requested reset)
+inline void audio_cadence_reset_window(audio_cadence_stats& stats) {
+	stats.slack_us_min = INT32_MAX;
+	stats.latency_us_max = 0;
+	stats.window_reset_requested = false;
+}
+
+// Reader side: start a new window at the task's next frame
+inline void audio_cadence_request_window_reset(audio_cadence_stats& stats) {
+	stats.window_reset_requested = true;
+}
+
+// One frame done: `found` chunks were waiting, `taken` were ingested (the
+// rest dropped), the newest arrived at `chunk_time_us`, and the frame was
+// published at `done_us`. The next frame is due `frame_period_us` after
+// the newest chunk.
+inline void audio_cadence_frame(audio_cadence_stats& stats, uint32_t found, uint32_t taken, uint32_t chunks_per_frame,
+                                uint32_t chunk_time_us, uint32_t done_us, uint32_t frame_period_us) {
+	if (stats.window_reset_requested) {
+		audio_cadence_reset_window(stats);
+	}
+	stats.frames = stats.frames + 1;
+	stats.chunks = stats.chunks + taken;
+	if (found > chunks_per_frame) {
+		stats.late_frames = stats.late_frames + 1;
+	}
+	if (found > taken) {
+		stats.dropped_chunks = stats.dropped_chunks + (found - taken);
+	}
+
+	const uint32_t latency = done_us - chunk_time_us;
+	const int32_t slack = (int32_t)frame_period_us - (int32_t)latency;
+	stats.latency_us_last = latency;
+	stats.slack_us_last = slack;
+	if (latency > stats.latency_us_max) {
+		stats.latency_us_max = latency;
+	}
+	if (slack < stats.slack_us_min) {
+		stats.slack_us_min = slack;
+	}
+}
+
+#endif  // AUDIO_CADENCE_H
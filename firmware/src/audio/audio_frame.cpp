@@ -0,0 +1,65 @@
+// -----------------------------------------------------------------
+// Audio Frame Implementation
+// The per-frame analysis sequence shared by audio_task and the host replay
+
+#include "audio_frame.h"
+#include "goertzel.h"
+#include "tempo.h"
+
+const char* const AUDIO_FRAME_STAGE_NAMES[AUDIO_STAGE_COUNT] = {
+	"calculate_magnitudes", "get_chromagram", "calculate_pitch", "update_novelty_curve",
+	"smooth_tempi_curve", "detect_beats", "publish",
+};
+
+static inline void stage_done(audio_frame_hook hook, audio_frame_stage stage, void* context) {
+	if (hook != NULL) {
+		hook(stage, context);
+	}
+}
+
+void analyze_audio_frame(uint32_t capture_us, audio_frame_hook hook, void* context) {
+	calculate_magnitudes();        // ~15-25ms Goertzel computation
+	stage_done(hook, AUDIO_STAGE_MAGNITUDES, context);
+	get_chromagram();              // ~1ms pitch aggregation
+	stage_done(hook, AUDIO_STAGE_CHROMAGRAM, context);
+	calculate_pitch();             // Two 512-point FFTs (McLeod pitch tracker)
+	stage_done(hook, AUDIO_STAGE_PITCH, context);
+
+	// BEAT DETECTION PIPELINE
+	// Calculate spectral novelty as peak energy in current frame
+	float peak_energy = 0.0f;
+	for (int i = 0; i < NUM_FREQS; i++) {
+		peak_energy = fmaxf(peak_energy, audio_back.spectrogram[i]);
+	}
+
+	// Update novelty curve with spectral peak
+	update_novelty_curve(peak_energy);
+	stage_done(hook, AUDIO_STAGE_NOVELTY, context);
+
+	// Smooth tempo magnitudes and detect beats
+	smooth_tempi_curve();          // ~2-5ms tempo magnitude calculation
+	stage_done(hook, AUDIO_STAGE_SMOOTH_TEMPI, context);
+	detect_beats();                // ~1ms beat confidence calculation
+	stage_done(hook, AUDIO_STAGE_DETECT_BEATS, context);
+
+	// SYNC TEMPO CONFIDENCE TO AUDIO SNAPSHOT
+	// Copy calculated tempo_confidence to audio_back so patterns can access it
+	audio_back.tempo_confidence = tempo_confidence;
+
+	// SYNC TEMPO MAGNITUDE AND PHASE ARRAYS
+	// Copy per-tempo-bin magnitude and phase data from tempo calculation to audio snapshot
+	// This enables Tempiscope and Beat_Tunnel patterns to access individual tempo bin data
+	for (uint16_t i = 0; i < NUM_TEMPI; i++) {
+		audio_back.tempo_magnitude[i] = tempi[i].magnitude;  // 0.0-1.0 per bin
+		audio_back.tempo_phase[i] = tempi[i].phase;          // -π to +π per bin
+		audio_back.tempo_phase_velocity[i] = tempi[i].phase_velocity;
+	}
+	audio_back.tempo_phase_time_us = tempo_phase_time_us;  // Beat clock reference (see beat_clock.h)
+
+	// Latency tag travels with the frame to the render task
+	audio_back.capture_us = capture_us;
+
+	// Lock-free buffer synchronization with Core 0
+	finish_audio_frame();          // ~0-5ms buffer swap
+	stage_done(hook, AUDIO_STAGE_PUBLISH, context);
+}
@@ -0,0 +1,35 @@
+// -----------------------------------------------------------------
+// Audio Frame - One analysis frame over the chunks ingested so far
+//
+// The sequence audio_task runs after each ingest: spectrum, chromagram,
+// pitch, novelty, tempo, beats, then the tempo copy into audio_back and
+// the snapshot publish. The host replay (host/audio_replay.cpp) calls the
+// same function, so both always run the same pipeline.
+//
+// An optional hook is called as each stage finishes, for per-stage timing
+// (latency histograms on target, the timing table on the host).
+
+#ifndef AUDIO_FRAME_H
+#define AUDIO_FRAME_H
+
+#include <stdint.h>
+
+enum audio_frame_stage {
+	AUDIO_STAGE_MAGNITUDES = 0,  // calculate_magnitudes()
+	AUDIO_STAGE_CHROMAGRAM,      // get_chromagram()
+	AUDIO_STAGE_PITCH,           // calculate_pitch()
+	AUDIO_STAGE_NOVELTY,         // Spectral peak + update_novelty_curve()
+	AUDIO_STAGE_SMOOTH_TEMPI,    // smooth_tempi_curve()
+	AUDIO_STAGE_DETECT_BEATS,    // detect_beats()
+	AUDIO_STAGE_PUBLISH,         // Tempo copy + finish_audio_frame()
+	AUDIO_STAGE_COUNT
+};
+extern const char* const AUDIO_FRAME_STAGE_NAMES[AUDIO_STAGE_COUNT];
+
+typedef void (*audio_frame_hook)(audio_frame_stage finished, void* context);
+
+// capture_us: DMA completion of the newest chunk ingested (0 for a silent frame)
+// hook: called after each stage, may be NULL
+void analyze_audio_frame(uint32_t capture_us, audio_frame_hook hook, void* context);
+
+#endif  // AUDIO_FRAME_H
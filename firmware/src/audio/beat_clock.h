@@ -0,0 +1,50 @@
+// -----------------------------------------------------------------
+// Beat Clock - Tempo phase at any instant between audio frames
+//
+// Tempo phases are measured once per audio frame and reach the render
+// loop through the snapshot, so a pattern running at 120+ FPS would see
+// them step every frame. Each tempo bin's phase advances at a known rate:
+// sliding the novelty window by one sample turns the phase of DFT bin k by
+// 2 pi k / B. The audio core publishes phase, that rate (rad/s, from the
+// measured novelty period) and the time the phase was measured; the render
+// side extrapolates analytically to its own timestamp.
+//
+// Extrapolation is capped at BEAT_CLOCK_MAX_EXTRAPOLATION_US so a stalled
+// audio core leaves the phase parked instead of spinning on stale data.
+
+#ifndef BEAT_CLOCK_H
+#define BEAT_CLOCK_H
+
+#include <stdint.h>
+#include <math.h>
+
+#define BEAT_CLOCK_MAX_EXTRAPOLATION_US 250000
+
+// Phase velocity (rad/s) of DFT bin `dft_bin` over a `block_size` novelty
+// window fed one sample every `novelty_period_us`
+inline float beat_clock_velocity(uint16_t dft_bin, uint16_t block_size, float novelty_period_us) {
+	return (2.0f * (float)M_PI * dft_bin / block_size) * (1000000.0f / novelty_period_us);
+}
+
+// Wrap to -pi..pi (the tempo phase convention)
+inline float beat_clock_wrap(float phase) {
+	phase = fmodf(phase + (float)M_PI, 2.0f * (float)M_PI);
+	if (phase < 0.0f) {
+		phase += 2.0f * (float)M_PI;
+	}
+	return phase - (float)M_PI;
+}
+
+// Phase measured at `reference_us`, advanced to `now_us`
+inline float beat_clock_phase(float phase, float velocity, uint32_t reference_us, uint32_t now_us) {
+	int32_t elapsed_us = (int32_t)(now_us - reference_us);
+	if (elapsed_us <= 0) {
+		return phase;
+	}
+	if (elapsed_us > BEAT_CLOCK_MAX_EXTRAPOLATION_US) {
+		elapsed_us = BEAT_CLOCK_MAX_EXTRAPOLATION_US;
+	}
+	return beat_clock_wrap(phase + velocity * (elapsed_us * 1e-6f));
+}
+
+#endif  // BEAT_CLOCK_H
@@ -0,0 +1,82 @@
+// -----------------------------------------------------------------
+// Beat Events - Lock-free beat/onset queue from the audio core to render
+//
+// detect_beats() knows the instant a beat or onset happens; the render
+// loop only sees snapshots, and thresholding a snapshot value every frame
+// fires repeatedly while the value stays high and misses events that fall
+// between snapshots. Instead the audio task pushes one timestamped event
+// per beat/onset into a single-producer / single-consumer ring that the
+// active pattern drains once per frame.
+//
+// The producer owns write_index, the consumer owns read_index; each side
+// only reads the other's index, and a barrier orders the event data
+// before the index that publishes it. A full queue drops the new event
+// (counted) rather than overwrite one the consumer may be reading.
+
+#ifndef BEAT_EVENTS_H
+#define BEAT_EVENTS_H
+
+#include <stdint.h>
+
+#define BEAT_EVENT_QUEUE_LENGTH 16       // Power of two; ~1 s of events at 8 per second
+#define BEAT_EVENT_MAX_AGE_US 100000     // Older events are skipped by the consumer
+
+enum beat_event_type {
+	BEAT_EVENT_BEAT = 0,                 // Dominant tempo bin crossed its beat phase
+	BEAT_EVENT_ONSET = 1,                // Novelty spike
+};
+
+typedef struct {
+	uint32_t timestamp_us;               // When it happened (esp_timer)
+	float strength;                      // 0.0-1.0 (beat: tempo confidence, onset: normalized novelty)
+	uint16_t tempo_bin;                  // Dominant tempo bin at the time
+	uint8_t type;                        // beat_event_type
+	uint8_t pitch_class;                 // Dominant chromagram note (0 = C .. 11 = B)
+} beat_event;
+
+typedef struct {
+	beat_event events[BEAT_EVENT_QUEUE_LENGTH];
+	volatile uint32_t write_index;       // Producer only (wraps)
+	volatile uint32_t read_index;        // Consumer only (wraps)
+	volatile uint32_t dropped;           // Producer: events lost to a full queue
+} beat_event_queue;
+
+// Producer side (audio task); false if the queue was full
+inline bool beat_event_push(beat_event_queue& queue, const beat_event& event) {
+	const uint32_t write = queue.write_index;
+	if (write - queue.read_index >= BEAT_EVENT_QUEUE_LENGTH) {
+		queue.dropped = queue.dropped + 1;
+		return false;
+	}
+	queue.events[write & (BEAT_EVENT_QUEUE_LENGTH - 1)] = event;
+	__sync_synchronize();   // Event data visible before the index that publishes it
+	queue.write_index = write + 1;
+	return true;
+}
+
+// Consumer side (render task); false if empty
+inline bool beat_event_pop(beat_event_queue& queue, beat_event* event) {
+	const uint32_t read = queue.read_index;
+	if (read == queue.write_index) {
+		return false;
+	}
+	__sync_synchronize();   // Index read before the event data it publishes
+	*event = queue.events[read & (BEAT_EVENT_QUEUE_LENGTH - 1)];
+	__sync_synchronize();   // Copy done before the slot is handed back
+	queue.read_index = read + 1;
+	return true;
+}
+
+// Consumer side: next event no older than `max_age_us` at `now_us`;
+// older ones (e.g. queued while another pattern was active) are discarded
+inline bool beat_event_pop_recent(beat_event_queue& queue, beat_event* event, uint32_t now_us, uint32_t max_age_us) {
+	while (beat_event_pop(queue, event)) {
+		// Signed: an event stamped just after now_us was taken is fresh
+		if ((int32_t)(now_us - event->timestamp_us) <= (int32_t)max_age_us) {
+			return true;
+		}
+	}
+	return false;
+}
+
+#endif  // BEAT_EVENTS_H
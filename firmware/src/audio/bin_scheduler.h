@@ -0,0 +1,98 @@
+// -----------------------------------------------------------------
+// Bin Scheduler - Interlaced magnitude updates driven by block length
+//
+// A bin integrating over N samples only sees N / hop new samples per audio
+// frame worth of change, so recomputing it every frame is mostly wasted
+// work. Each schedulable unit (a kernel group or a single bin) gets a
+// power-of-two update period such that at most 1 / BIN_SCHEDULE_OVERLAP of
+// its window is new between updates, and a phase inside that period.
+//
+// Phases are assigned greedily (most expensive unit first, into the
+// currently lightest slot of a BIN_SCHEDULE_MAX_PERIOD-frame cycle), so the
+// work per frame stays close to the cycle average instead of bunching up
+// on frames where every long bin comes due together.
+
+#ifndef BIN_SCHEDULER_H
+#define BIN_SCHEDULER_H
+
+#include <stdint.h>
+
+#ifndef BIN_SCHEDULE_MAX_PERIOD
+#define BIN_SCHEDULE_MAX_PERIOD 8        // Frames; power of two, 1 disables interlacing
+#endif
+#define BIN_SCHEDULE_OVERLAP 2           // Update once half the window is new (50% overlap, as in an STFT)
+
+static_assert((BIN_SCHEDULE_MAX_PERIOD & (BIN_SCHEDULE_MAX_PERIOD - 1)) == 0, "BIN_SCHEDULE_MAX_PERIOD must be a power of two");
+
+// Largest power-of-two period (<= max_period) that keeps the overlap target
+// window_samples: block length in input-rate samples; hop: new samples per frame
+// overlap: 1 lets the whole window be new between updates (quality_governor.h)
+// min_period (power of two): floor for short windows that would update every frame
+inline uint8_t bin_schedule_period(uint32_t window_samples, uint16_t hop, uint8_t max_period,
+                                   uint8_t overlap = BIN_SCHEDULE_OVERLAP, uint8_t min_period = 1) {
+	uint8_t period = min_period < max_period ? min_period : max_period;
+	while (period < max_period && (uint32_t)(period * 2) * hop * overlap <= window_samples) {
+		period *= 2;
+	}
+	return period;
+}
+
+// Phase for every unit (count <= 256), balancing `costs` across the max_period-frame cycle
+// slot_load (max_period entries) receives the resulting work per frame slot
+inline void bin_schedule_assign(const uint8_t* periods, const uint32_t* costs, uint16_t count,
+                                uint8_t max_period, uint8_t* phases_out, uint32_t* slot_load) {
+	for (uint8_t s = 0; s < max_period; s++) {
+		slot_load[s] = 0;
+	}
+
+	bool placed[256] = { false };
+	for (uint16_t n = 0; n < count; n++) {
+		// Most expensive unplaced unit, longest period first on ties
+		int16_t unit = -1;
+		for (uint16_t u = 0; u < count; u++) {
+			if (placed[u]) continue;
+			if (unit < 0 || costs[u] > costs[unit] || (costs[u] == costs[unit] && periods[u] > periods[unit])) {
+				unit = u;
+			}
+		}
+
+		// Phase whose busiest slot ends up lightest
+		const uint8_t period = periods[unit];
+		uint8_t best_phase = 0;
+		uint32_t best_peak = UINT32_MAX;
+		for (uint8_t phase = 0; phase < period; phase++) {
+			uint32_t peak = 0;
+			for (uint8_t s = phase; s < max_period; s += period) {
+				if (slot_load[s] + costs[unit] > peak) peak = slot_load[s] + costs[unit];
+			}
+			if (peak < best_peak) {
+				best_peak = peak;
+				best_phase = phase;
+			}
+		}
+
+		for (uint8_t s = best_phase; s < max_period; s += period) {
+			slot_load[s] += costs[unit];
+		}
+		phases_out[unit] = best_phase;
+		placed[unit] = true;
+	}
+}
+
+inline bool bin_schedule_due(uint8_t period, uint8_t phase, uint32_t frame) {
+	return (frame & (period - 1)) == phase;
+}
+
+// Frames since the unit was last computed (0 on the frame it is due)
+inline uint8_t bin_schedule_age(uint8_t period, uint8_t phase, uint32_t frame) {
+	return (uint8_t)((frame - phase) & (period - 1));
+}
+
+// Magnitude to publish between updates: ramps from the previous result to
+// the latest one over one period, so stale bins move smoothly instead of
+// stepping once per period (adds at most one period of lag to that bin)
+inline float bin_schedule_interpolate(float previous, float latest, uint8_t period, uint8_t age) {
+	return previous + (latest - previous) * (float)(age + 1) / (float)period;
+}
+
+#endif  // BIN_SCHEDULER_H
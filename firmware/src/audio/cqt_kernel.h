@@ -0,0 +1,158 @@
+// -----------------------------------------------------------------
+// Constant-Q Kernels - Shared FFT + sparse spectral kernels (Brown-Puckette)
+//
+// Each musical bin's windowed complex exponential (the same window,
+// block and frequency the Goertzel filter uses) is placed at the end of
+// an FFT frame and transformed once, when the engine is selected. By
+// Parseval, the bin's DFT value is then the inner product of the frame
+// spectrum with that kernel spectrum. Entries below a relative threshold
+// are dropped.
+//
+// Kernel length follows the frame, not the bin: the Goertzel window (two
+// Gaussian humps with a ~0.46 pedestal at the block edges) has slowly
+// decaying spectral sidelobes, so at any threshold that keeps the engines
+// within 1% of each other most of a frame's entries survive. Each bin
+// therefore uses the smallest power-of-two frame that holds its block
+// (cqt_frame_size), 32-256 points, and bins sharing a decimation stage and
+// frame size share one FFT.
+
+#ifndef CQT_KERNEL_H
+#define CQT_KERNEL_H
+
+#include <stdint.h>
+#include <math.h>
+
+typedef struct {
+	float re;
+	float im;
+} cqt_complex;
+
+// One non-zero spectral kernel weight
+typedef struct {
+	uint16_t index;   // FFT bin
+	float re;
+	float im;
+} cqt_kernel_entry;
+
+// Span of a bin's weights inside the shared entry table
+typedef struct {
+	uint16_t first;
+	uint16_t count;
+	uint16_t frame_size;   // FFT frame the weights index (cqt_frame_size of the block)
+} cqt_bin_kernel;
+
+// Smallest power-of-two frame holding a block
+inline uint16_t cqt_frame_size(uint16_t block_size) {
+	uint16_t size = 1;
+	while (size < block_size) {
+		size <<= 1;
+	}
+	return size;
+}
+
+// Twiddle table for an n-point forward FFT (n / 2 entries)
+inline void cqt_fft_init_twiddles(cqt_complex* twiddles, uint16_t n) {
+	for (uint16_t i = 0; i < n / 2; i++) {
+		double angle = -2.0 * M_PI * i / n;
+		twiddles[i].re = (float)cos(angle);
+		twiddles[i].im = (float)sin(angle);
+	}
+}
+
+// In-place iterative radix-2 forward FFT, n a power of two
+// twiddles: from cqt_fft_init_twiddles(twiddles, table_n), table_n a multiple of n
+inline void cqt_fft(cqt_complex* data, uint16_t n, const cqt_complex* twiddles, uint16_t table_n = 0) {
+	if (table_n == 0) {
+		table_n = n;
+	}
+
+	// Bit-reversal permutation
+	for (uint16_t i = 1, j = 0; i < n; i++) {
+		uint16_t bit = n >> 1;
+		for (; j & bit; bit >>= 1) {
+			j ^= bit;
+		}
+		j ^= bit;
+		if (i < j) {
+			cqt_complex tmp = data[i];
+			data[i] = data[j];
+			data[j] = tmp;
+		}
+	}
+
+	for (uint16_t len = 2; len <= n; len <<= 1) {
+		const uint16_t half = len >> 1;
+		const uint16_t twiddle_step = table_n / len;
+		for (uint16_t start = 0; start < n; start += len) {
+			for (uint16_t k = 0; k < half; k++) {
+				const cqt_complex w = twiddles[k * twiddle_step];
+				cqt_complex* a = &data[start + k];
+				cqt_complex* b = &data[start + k + half];
+				float t_re = b->re * w.re - b->im * w.im;
+				float t_im = b->re * w.im + b->im * w.re;
+				b->re = a->re - t_re;
+				b->im = a->im - t_im;
+				a->re += t_re;
+				a->im += t_im;
+			}
+		}
+	}
+}
+
+// Spectral kernel of one bin.
+// window: block_size weights (the bin's walk through window_lookup)
+// omega: bin frequency in radians per sample at the frame's rate
+// The temporal kernel window[n] * e^(-j omega n) occupies the last block_size
+// samples of the fft_size frame, matching the Goertzel block alignment.
+// Writes entries with |K| >= threshold * max|K| to `out` (pass NULL to only count).
+// scratch: fft_size complex values; twiddles: table of table_n points (0: fft_size)
+inline uint16_t cqt_build_kernel(cqt_kernel_entry* out, uint16_t fft_size, uint16_t block_size,
+                                 const float* window, float omega, float threshold,
+                                 cqt_complex* scratch, const cqt_complex* twiddles, uint16_t table_n = 0) {
+	const uint16_t start = fft_size - block_size;
+	for (uint16_t m = 0; m < fft_size; m++) {
+		scratch[m].re = 0.0f;
+		scratch[m].im = 0.0f;
+	}
+	for (uint16_t n = 0; n < block_size; n++) {
+		scratch[start + n].re = window[n] * (float)cos(omega * n);
+		scratch[start + n].im = -window[n] * (float)sin(omega * n);
+	}
+
+	cqt_fft(scratch, fft_size, twiddles, table_n);
+
+	float max_magnitude = 0.0f;
+	for (uint16_t j = 0; j < fft_size; j++) {
+		max_magnitude = fmaxf(max_magnitude, sqrtf(scratch[j].re * scratch[j].re + scratch[j].im * scratch[j].im));
+	}
+
+	// Parseval: sum x[m] y[m] = (1 / N) sum X[j] Y[-j]
+	uint16_t count = 0;
+	const float limit = threshold * max_magnitude;
+	for (uint16_t j = 0; j < fft_size; j++) {
+		const cqt_complex& y = scratch[(fft_size - j) & (fft_size - 1)];
+		if (sqrtf(y.re * y.re + y.im * y.im) >= limit) {
+			if (out != NULL) {
+				out[count].index = j;
+				out[count].re = y.re / fft_size;
+				out[count].im = y.im / fft_size;
+			}
+			count++;
+		}
+	}
+	return count;
+}
+
+// |sum X[j] K[j]|^2 - equals the Goertzel magnitude_squared of the bin
+inline float cqt_apply_kernel(const cqt_complex* spectrum, const cqt_kernel_entry* entries, uint16_t count) {
+	float re = 0.0f;
+	float im = 0.0f;
+	for (uint16_t e = 0; e < count; e++) {
+		const cqt_complex& x = spectrum[entries[e].index];
+		re += x.re * entries[e].re - x.im * entries[e].im;
+		im += x.re * entries[e].im + x.im * entries[e].re;
+	}
+	return re * re + im * im;
+}
+
+#endif  // CQT_KERNEL_H
@@ -0,0 +1,75 @@
+// -----------------------------------------------------------------
+// Feature Interpolation - Audio features at render rate
+//
+// The render loop runs faster than audio analysis, so a pattern reading
+// spectrogram, chromagram or VU straight from the snapshot sees them hold
+// for a frame or two and then jump. Each snapshot also carries the
+// previous analysis frame and its timestamp; the render side blends
+// previous -> current with a weight evaluated at its own timestamp:
+//
+// - FEATURE_INTERP_LINEAR: plays the frames back one analysis period
+//   late, reaching the current frame just as the next one is due. Exact
+//   continuity when frames arrive on time, at the cost of one frame of
+//   latency (8 ms at the default cadence).
+// - FEATURE_INTERP_DAMPED: the step response of a critically damped
+//   follower released at the current frame's timestamp, starting from the
+//   previous frame with zero velocity. Starts moving as soon as a frame
+//   lands, so it lags less (2 / omega, 0.4 of a period on average) and is
+//   within 4% of the current frame when the next one is due
+//   (FEATURE_INTERP_DAMPED_RATE).
+//
+// Both weights depend only on the two timestamps and now, so they are
+// computed once per render frame and every feature read is one lerp.
+// Gaps longer than FEATURE_INTERP_MAX_GAP_US (first frame, stalled audio)
+// snap to the current frame.
+
+#ifndef FEATURE_INTERP_H
+#define FEATURE_INTERP_H
+
+#include <stdint.h>
+#include <math.h>
+
+#define FEATURE_INTERP_MAX_GAP_US 100000
+#define FEATURE_INTERP_DAMPED_RATE 5.0f          // omega * analysis period; (1 + 5) e^-5 = 4% left at the next frame
+
+enum feature_interp_mode {
+	FEATURE_INTERP_LINEAR = 0,
+	FEATURE_INTERP_DAMPED = 1,
+};
+
+typedef struct {
+	float linear;                        // Blend weight, previous (0) -> current (1)
+	float damped;
+} feature_interp;
+
+// Weights at `now_us` for a frame at `current_us` following one at `previous_us`
+inline feature_interp feature_interp_weights(uint32_t previous_us, uint32_t current_us, uint32_t now_us) {
+	feature_interp weights = {1.0f, 1.0f};
+	const int32_t period_us = (int32_t)(current_us - previous_us);
+	if (period_us <= 0 || period_us > FEATURE_INTERP_MAX_GAP_US) {
+		return weights;
+	}
+
+	float elapsed = (float)(int32_t)(now_us - current_us) / period_us;
+	if (elapsed <= 0.0f) {
+		weights.linear = 0.0f;
+		weights.damped = 0.0f;
+		return weights;
+	}
+
+	weights.linear = elapsed < 1.0f ? elapsed : 1.0f;
+
+	const float x = FEATURE_INTERP_DAMPED_RATE * elapsed;
+	weights.damped = 1.0f - (1.0f + x) * expf(-x);
+	return weights;
+}
+
+inline float feature_interp_weight(const feature_interp& weights, uint8_t mode) {
+	return mode == FEATURE_INTERP_DAMPED ? weights.damped : weights.linear;
+}
+
+inline float feature_interp_blend(float previous, float current, float weight) {
+	return previous + (current - previous) * weight;
+}
+
+#endif  // FEATURE_INTERP_H
@@ -12,9 +12,17 @@
 // Frequency domain analysis via constant-Q Goertzel filter
 
 #include "goertzel.h"
+#include "goertzel_kernel.h"
+#include "octave_decimator.h"
+#include "cqt_kernel.h"
+#include "pitch_tracker.h"
+#include "bin_scheduler.h"
+#include "running_mean.h"
+#include "noise_profile.h"
 #include <cmath>
 #include <cstring>
 #include <Arduino.h>
+#include <Preferences.h>
 #include "../logging/logger.h"
 
 // ============================================================================
@@ -25,27 +33,87 @@
 float spectrogram[NUM_FREQS];
 float spectrogram_smooth[NUM_FREQS] = {0.0f};
 float chromagram[12];
+float fft_smooth[NUM_FFT_BINS] = {0.0f};
 float audio_level = 0.0f;
 
 // Tempo/beat detection
 tempo tempi[NUM_TEMPI];
 float tempi_smooth[NUM_TEMPI] = {0};
 
-// Sample history buffer
-float sample_history[SAMPLE_HISTORY_LENGTH] = {0};
+// Sample history buffer (every sample stored twice, see mirrored_ring.h)
+static_assert((SAMPLE_HISTORY_LENGTH & (SAMPLE_HISTORY_LENGTH - 1)) == 0, "sample history ring needs a power-of-two length");
+static audio_sample_t sample_history_storage[SAMPLE_HISTORY_LENGTH * 2] = {0};
+audio_sample_ring sample_history = { sample_history_storage, SAMPLE_HISTORY_LENGTH, 0 };
+
+// Decimated histories (8 kHz, 4 kHz, 2 kHz) fed by a half-band filter per stage
+static_assert((OCTAVE_HISTORY_LENGTH & (OCTAVE_HISTORY_LENGTH - 1)) == 0, "octave history ring needs a power-of-two length");
+static audio_sample_t octave_history_storage[NUM_OCTAVE_STAGES - 1][OCTAVE_HISTORY_LENGTH * 2] = {{0}};
+audio_sample_ring octave_history[NUM_OCTAVE_STAGES - 1] = {
+	{ octave_history_storage[0], OCTAVE_HISTORY_LENGTH, 0 },
+	{ octave_history_storage[1], OCTAVE_HISTORY_LENGTH, 0 },
+	{ octave_history_storage[2], OCTAVE_HISTORY_LENGTH, 0 },
+};
+static halfband_decimator octave_filters[NUM_OCTAVE_STAGES - 1] = {};
 
 // Goertzel state
 freq frequencies_musical[NUM_FREQS];
-float window_lookup[4096];
+window_weight_t window_lookup[4096];
 uint16_t max_goertzel_block_size = 0;
 volatile bool magnitudes_locked = false;
 
+// Multi-bin kernel state (see goertzel_kernel.h)
+// Storage stays NULL if allocation failed; calculate_magnitudes() then falls back to the single-bin loop
+static goertzel_bin_group goertzel_groups[NUM_FREQS / GOERTZEL_LANES];
+static int16_t* goertzel_window_storage = NULL;
+static_assert(NUM_FREQS % GOERTZEL_LANES == 0, "NUM_FREQS must be a multiple of GOERTZEL_LANES");
+
+// Interlaced scheduling state (see bin_scheduler.h), one period and phase per kernel group
+// Engines write fresh results for due bins only; the rest ramp between their last two results
+static uint8_t group_periods[NUM_FREQS / GOERTZEL_LANES];
+static uint8_t group_phases[NUM_FREQS / GOERTZEL_LANES];
+static uint32_t schedule_frame = 0;
+static float magnitudes_previous[NUM_FREQS];
+static float magnitudes_latest[NUM_FREQS];
+volatile uint32_t audio_work_units_last = 0;
+volatile uint32_t audio_work_units_peak = 0;
+volatile bool audio_work_units_peak_reset_requested = false;
+uint32_t audio_work_units_unscheduled = 0;
+audio_cadence_stats audio_cadence = {};
+quality_governor audio_governor;
+
+// Spectral side of the governor's level (see quality_governor.h)
+static audio_quality spectral_quality = audio_quality_for_level(0);
+
+// CQT engine state (see cqt_kernel.h)
+// Entries are built by update_cqt_engine() while the engine is selected and freed when it is not;
+// NULL means the Goertzel engine runs
+static_assert(NUM_FFT_BINS * 2 == CQT_FFT_SIZE, "fft_smooth holds the positive half of the CQT frame");
+static cqt_complex cqt_twiddles[CQT_FFT_SIZE / 2];
+static cqt_complex cqt_frame[CQT_FFT_SIZE];
+static cqt_bin_kernel cqt_bin_kernels[NUM_FREQS];
+static cqt_kernel_entry* cqt_kernel_entries = NULL;
+
+// Pitch tracker state (see pitch_tracker.h)
+static_assert(PITCH_WINDOW <= OCTAVE_HISTORY_LENGTH, "pitch window must fit the octave history");
+static pitch_tracker pitch_state;
+static pitch_estimate pitch_latest = {0.0f, 0.0f, 0.0f};
+static uint32_t pitch_frame = 0;
+
 // Audio processing state
 uint32_t noise_calibration_active_frames_remaining = 0;
 float noise_spectrum[64] = {0};
+uint32_t noise_probe_frames_remaining = 0;
+volatile float noise_profile_drift_last = -1.0f;
+volatile bool noise_profile_stale = false;
+// Boot probe waits out the zero-filled history and the interpolation ramp of the longest scheduled bins
+#define NOISE_PROBE_SETTLE_FRAMES (SAMPLE_HISTORY_LENGTH / AUDIO_HOP_SAMPLES + BIN_SCHEDULE_MAX_PERIOD)
+static float noise_level[NUM_FREQS] = {0};       // Mean raw magnitude during calibration (see noise_profile.h)
+static float noise_level_sum[NUM_FREQS] = {0};   // Accumulates calibration or probe frames
+static_assert(NOISE_PROFILE_BINS == NUM_FREQS, "noise profile must cover every bin");
 AudioConfiguration configuration = {
 	.vu_floor = 0.0f,
-	.microphone_gain = 1.0f  // Default: no amplification (0dB)
+	.microphone_gain = 1.0f,  // Default: no amplification (0dB)
+	.spectral_engine = SPECTRAL_ENGINE_DEFAULT
 };
 bool EMOTISCOPE_ACTIVE = true;
 bool audio_recording_live = false;
@@ -55,10 +123,11 @@ int16_t audio_debug_recording[MAX_AUDIO_RECORDING_SAMPLES];
 // Spectrogram averaging (NUM_SPECTROGRAM_AVERAGE_SAMPLES defined in goertzel.h)
 float spectrogram_average[NUM_SPECTROGRAM_AVERAGE_SAMPLES][NUM_FREQS];
 uint8_t spectrogram_average_index = 0;
+static float spectrogram_average_sum[NUM_FREQS] = {0};   // Running sums over spectrogram_average (see running_mean.h)
 
-// Double-buffering for thread-safe audio sync
-AudioDataSnapshot audio_front;
-AudioDataSnapshot audio_back;
+// Triple-buffering for thread-safe audio sync (see triple_buffer.h)
+AudioDataSnapshot audio_snapshots[TRIPLE_BUFFER_SLOTS];
+triple_buffer audio_snapshot_slots;
 SemaphoreHandle_t audio_swap_mutex = NULL;
 SemaphoreHandle_t audio_read_mutex = NULL;
 static bool audio_sync_initialized = false;
@@ -89,23 +158,46 @@ void init_audio_data_sync() {
 		return;
 	}
 
-	// Initialize both buffers to zero
-	memset(&audio_front, 0, sizeof(AudioDataSnapshot));
-	memset(&audio_back, 0, sizeof(AudioDataSnapshot));
+	// Initialize all slots to zero, invalid until the first audio update
+	memset(audio_snapshots, 0, sizeof(audio_snapshots));
+	triple_buffer_init(audio_snapshot_slots);
 
-	// Mark buffers as invalid until first audio update
-	audio_front.is_valid = false;
-	audio_back.is_valid = false;
+	// The slot being filled carries an odd sequence until it is published
+	audio_back.sequence = 1;
 
 	audio_sync_initialized = true;
 
 	LOG_INFO(TAG_SYNC, "Initialized successfully");
-	LOG_DEBUG(TAG_SYNC, "Buffer size: %d bytes per snapshot", sizeof(AudioDataSnapshot));
-	LOG_DEBUG(TAG_SYNC, "Total memory: %d bytes (2x buffers)", sizeof(AudioDataSnapshot) * 2);
+	LOG_DEBUG(TAG_SYNC, "Buffer size: %u bytes per snapshot", (unsigned)sizeof(AudioDataSnapshot));
+	LOG_DEBUG(TAG_SYNC, "Total memory: %u bytes (%dx buffers)", (unsigned)sizeof(audio_snapshots), TRIPLE_BUFFER_SLOTS);
 }
 
 // =============================================================================
-// Get thread-safe snapshot of current audio data
+// Latest published audio frame, by pointer (render task only)
+// Returns a zeroed, invalid snapshot before init_audio_data_sync()
+//
+// Usage:
+//   const AudioDataSnapshot* audio = acquire_audio_snapshot();
+//   if (audio->is_valid) {
+//     // Use audio->spectrogram, audio->chromagram, etc.
+//   }
+//
+// SYNCHRONIZATION STRATEGY:
+// No copy and no retry: the slot returned is neither published over nor
+// refilled by the audio task until the render task acquires again, so the
+// pointer stays valid (and the data intact) for the whole render frame.
+// Single reader: a second task calling this would release the first's slot.
+// =============================================================================
+const AudioDataSnapshot* acquire_audio_snapshot() {
+	static const AudioDataSnapshot empty = {};
+	if (!audio_sync_initialized) {
+		return &empty;
+	}
+	return &audio_snapshots[triple_buffer_acquire(audio_snapshot_slots)];
+}
+
+// =============================================================================
+// Get thread-safe copy of the latest audio frame (any task)
 // Returns: true if snapshot copied successfully, false on timeout
 //
 // Usage:
@@ -115,9 +207,10 @@ void init_audio_data_sync() {
 //   }
 //
 // SYNCHRONIZATION STRATEGY:
-// Uses sequence counter to detect torn reads (Core 0 reading while Core 1 writing)
-// - Reader (Core 0): Read sequence, copy data, read sequence again - retry if changed
-// - Writer (Core 1): Increment sequence (mark dirty), write data, increment again (mark clean)
+// Copies the published slot without claiming it, so the render task keeps
+// sole use of acquire_audio_snapshot(). The audio task may start refilling
+// that slot two frames later; its sequence goes odd while it does, so:
+// - Read sequence, copy data, re-read sequence - retry if changed or odd
 // - Memory barriers ensure cache coherency between ESP32-S3 cores
 // =============================================================================
 bool get_audio_snapshot(AudioDataSnapshot* snapshot) {
@@ -126,123 +219,145 @@ bool get_audio_snapshot(AudioDataSnapshot* snapshot) {
 	}
 
 	// LOCK-FREE READ with sequence counter validation
-	// Retry if sequence changes during copy (torn read detection)
+	// Retry if the slot is reclaimed during copy (torn read detection)
 	uint32_t seq1, seq2;
-    // Increase retry budget to reduce spurious warnings under temporary contention
-    int max_retries = 1000;  // Prevent infinite loop in extreme contention
+	const int max_retries = 1000;  // Prevent infinite loop in extreme contention
 	int retry_count = 0;
 
 	do {
+		const AudioDataSnapshot& published = audio_snapshots[audio_snapshot_slots.published];
+
 		// Read sequence counter before copy
-		seq1 = audio_front.sequence;
+		seq1 = published.sequence;
 
 		// Memory barrier: Ensure sequence read completes before data copy
-		// ESP32-S3 requires explicit cache synchronization between cores
 		__sync_synchronize();
 
-		// Copy data from front buffer (may be interrupted by writer)
-		memcpy(snapshot, &audio_front, sizeof(AudioDataSnapshot));
+		memcpy(snapshot, &published, sizeof(AudioDataSnapshot));
 
 		// Memory barrier: Ensure data copy completes before sequence check
 		__sync_synchronize();
 
-		// Read sequence counter after copy
-		seq2 = audio_front.sequence_end;
+		seq2 = published.sequence;
 
 		// Retry if:
-		// 1. Sequence changed during copy (torn read)
-		// 2. Sequence is odd (writer is in progress)
-		// 3. Start/end sequences don't match (partial write)
+		// 1. Sequence changed during copy (slot reclaimed by the writer)
+		// 2. Sequence is odd (writer is filling the slot)
+		// 3. Copied start/end sequences don't match (partial write)
 		if (++retry_count > max_retries) {
-			// Extreme contention - return stale data rather than infinite loop
 			LOG_WARN(TAG_SYNC, "Max retries exceeded, using potentially stale data");
-			return audio_front.is_valid;
+			return false;
 		}
-	} while (seq1 != seq2 || (seq1 & 1) || seq1 != audio_front.sequence);
+	} while (seq1 != seq2 || (seq1 & 1) || snapshot->sequence_end != seq1);
 
-	return audio_front.is_valid;
+	return snapshot->is_valid;
 }
 
 // =============================================================================
-// Commit audio data from back buffer to front buffer (atomic swap)
+// Publish the back slot (filled by this frame) and claim the next one
 // Called by audio processing thread after updating audio_back
 //
 // SYNCHRONIZATION STRATEGY:
-// Uses sequence counter to signal write in progress
-// - Increment sequence (odd = writing in progress, signals readers to retry)
-// - Memory barrier (flush Core 1 cache, ensure readers see sequence change)
-// - Copy data from back to front buffer
-// - Memory barrier (ensure data written before final sequence update)
-// - Increment sequence again (even = valid data available)
+// - The back slot's sequence is odd while it is being filled
+// - Make it even (sequence_end to match), then publish the slot index
+// - Claim a slot that is neither published nor being rendered, and make its
+//   sequence odd before writing to it (get_audio_snapshot() may be copying it)
 //
-// Memory barriers are CRITICAL for ESP32-S3 dual-core cache coherency
+// No full copy: every snapshot field is rewritten each frame, except
+// update_counter, which is carried over from the published frame, and the
+// previous-frame features used for render-rate interpolation
 // =============================================================================
 void commit_audio_data() {
 	if (!audio_sync_initialized) {
 		return;
 	}
 
-	// LOCK-FREE WRITE with sequence counter synchronization
-	// Step 1: Increment sequence to ODD value (signals "writing in progress")
-	audio_front.sequence++;
+	// Step 1: Mark the filled slot valid (even sequence)
+	audio_back.publish_us = (uint32_t)esp_timer_get_time();
+	audio_back.sequence++;
+	audio_back.sequence_end = audio_back.sequence;
+	audio_back.is_valid = true;
 
-	// Memory barrier: Ensure sequence write is visible to Core 0 before data copy
-	// This flushes Core 1's cache and invalidates Core 0's cache for audio_front
-	__sync_synchronize();
+	// Step 2: Publish it (barriers inside)
+	triple_buffer_publish(audio_snapshot_slots);
 
-	// Step 2: Copy data from back buffer to front buffer
-	// This is a large (1,300+ byte) non-atomic operation that may take microseconds
-	// Readers will detect the odd sequence and retry
-	memcpy(&audio_front, &audio_back, sizeof(AudioDataSnapshot));
-
-	// Step 3: Restore sequence counter (must match the incremented value)
-	// We just overwrote it with memcpy, so restore it
-	audio_front.sequence = audio_back.sequence + 1;
-
-	// Memory barrier: Ensure data copy completes before marking as valid
+	// Step 3: Claim the next slot: odd sequence before any data write
+	audio_back.sequence = audio_front.sequence + 1;
 	__sync_synchronize();
+	audio_back.update_counter = audio_front.update_counter;
+
+	// Step 4: The frame just published becomes the new slot's previous frame
+	memcpy(audio_back.spectrogram_prev, audio_front.spectrogram, sizeof(float) * NUM_FREQS);
+	memcpy(audio_back.spectrogram_smooth_prev, audio_front.spectrogram_smooth, sizeof(float) * NUM_FREQS);
+	memcpy(audio_back.chromagram_prev, audio_front.chromagram, sizeof(float) * 12);
+	audio_back.vu_level_prev = audio_front.vu_level;
+	audio_back.timestamp_prev_us = audio_front.timestamp_us;
+}
 
-	// Step 4: Increment sequence to EVEN value (signals "valid data")
-	// Also update sequence_end to match (reader validates both match)
-	audio_front.sequence++;
-	audio_front.sequence_end = audio_front.sequence;
-
-	// Step 5: Mark front buffer as valid (first-time initialization flag)
-	audio_front.is_valid = true;
-
-	// Final memory barrier: Ensure all writes are visible to Core 0
-	__sync_synchronize();
+void feed_octave_histories(const float* samples, uint16_t count) {
+	float stage_in[HALFBAND_MAX_CHUNK];
+	float stage_out[HALFBAND_MAX_CHUNK / 2];
+
+	memcpy(stage_in, samples, count * sizeof(float));
+	for (uint8_t s = 0; s < NUM_OCTAVE_STAGES - 1; s++) {
+		halfband_decimate(octave_filters[s], stage_in, count, stage_out);
+		count /= 2;
+#if AUDIO_FIXED_POINT
+		int16_t stage_out_q15[HALFBAND_MAX_CHUNK / 2];
+		goertzel_float_to_q15_block(stage_out, stage_out_q15, count);
+		mirrored_ring_write(octave_history[s], stage_out_q15, count);
+#else
+		mirrored_ring_write(octave_history[s], stage_out, count);
+#endif
+		memcpy(stage_in, stage_out, count * sizeof(float));
+	}
 }
 
 void init_goertzel(uint16_t frequency_slot, float frequency, float bandwidth) {
 	// Calculate the block size based on the desired bandwidth
-	frequencies_musical[frequency_slot].block_size = SAMPLE_RATE / (bandwidth);
+	uint16_t full_rate_block_size = SAMPLE_RATE / (bandwidth);
 
 	// Adjust the block size to be divisible by 4
-	while (frequencies_musical[frequency_slot].block_size % 4 != 0) {
-		frequencies_musical[frequency_slot].block_size -= 1;
+	while (full_rate_block_size % 4 != 0) {
+		full_rate_block_size -= 1;
 	}
 
 	// Limit the block size to the maximum sample history length
-	if (frequencies_musical[frequency_slot].block_size > SAMPLE_HISTORY_LENGTH - 1) {
-		frequencies_musical[frequency_slot].block_size = SAMPLE_HISTORY_LENGTH - 1;
+	if (full_rate_block_size > SAMPLE_HISTORY_LENGTH - 1) {
+		full_rate_block_size = SAMPLE_HISTORY_LENGTH - 1;
 	}
 
 	// Update the maximum goertzel block size
-	max_goertzel_block_size = max(max_goertzel_block_size, frequencies_musical[frequency_slot].block_size);
+	max_goertzel_block_size = max(max_goertzel_block_size, full_rate_block_size);
+
+	// Pick the DFT bin at full rate so decimated bins analyse the exact same frequency
+	float k = (int)(0.5 + ((full_rate_block_size * frequencies_musical[frequency_slot].target_freq) / SAMPLE_RATE));
+
+	// Run at the bin's decimation stage (octave set by init_goertzel_constants_musical):
+	// same block duration, 2^octave fewer samples
+	const uint8_t octave = frequencies_musical[frequency_slot].octave;
+	frequencies_musical[frequency_slot].block_size = full_rate_block_size >> octave;
+	if (frequencies_musical[frequency_slot].block_size > get_octave_history_length(octave) - 1) {
+		frequencies_musical[frequency_slot].block_size = get_octave_history_length(octave) - 1;
+	}
 
 	// Calculate the window step size
 	frequencies_musical[frequency_slot].window_step = 4096.0 / frequencies_musical[frequency_slot].block_size;
 
 	// Calculate the coefficients for the goertzel algorithm
-	float k = (int)(0.5 + ((frequencies_musical[frequency_slot].block_size * frequencies_musical[frequency_slot].target_freq) / SAMPLE_RATE));
-	float w = (2.0 * PI * k) / frequencies_musical[frequency_slot].block_size;
+	float w = (2.0 * PI * k * (1 << octave)) / full_rate_block_size;
 	float cosine = cos(w);
-	float sine = sin(w);
 	frequencies_musical[frequency_slot].coeff = 2.0 * cosine;
+
+#if AUDIO_FIXED_POINT
+	frequencies_musical[frequency_slot].coeff_q30 = goertzel_coeff_to_q30(frequencies_musical[frequency_slot].coeff);
+	frequencies_musical[frequency_slot].fixed_shift = goertzel_fixed_shift(frequencies_musical[frequency_slot].block_size, frequencies_musical[frequency_slot].coeff);
+#endif
 }
 
 void init_goertzel_constants_musical() {
+	float bandwidths[NUM_FREQS];
+
 	for (uint16_t i = 0; i < NUM_FREQS; i++) {
 		// INIT MUSICAL FREQS
 		uint16_t note = BOTTOM_NOTE + (i * NOTE_STEP);
@@ -268,16 +383,218 @@ void init_goertzel_constants_musical() {
 			fabs(frequencies_musical[i].target_freq - neighbor_left),
 			fabs(frequencies_musical[i].target_freq - neighbor_right));
 
-		init_goertzel(i, frequencies_musical[i].target_freq, neighbor_distance_hz * 4.0);
+		bandwidths[i] = neighbor_distance_hz * 4.0;
 	}
+
+	// Pick the lowest sample rate each group of kernel lanes can run at.
+	// Lanes of a group share one history, so the group's highest bin decides
+	for (uint16_t g = 0; g < NUM_FREQS; g += GOERTZEL_LANES) {
+		float top_freq = 0.0;
+		float min_bandwidth = bandwidths[g];
+		for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+			top_freq = max(top_freq, frequencies_musical[g + lane].target_freq);
+			min_bandwidth = min(min_bandwidth, bandwidths[g + lane]);
+		}
+
+		uint8_t octave = octave_select_stage(top_freq, min_bandwidth, SAMPLE_RATE, NUM_OCTAVE_STAGES, OCTAVE_HISTORY_LENGTH);
+		for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+			frequencies_musical[g + lane].octave = octave;
+		}
+	}
+
+	for (uint16_t i = 0; i < NUM_FREQS; i++) {
+		init_goertzel(i, frequencies_musical[i].target_freq, bandwidths[i]);
+	}
+
+	init_goertzel_window_tables();
+	init_bin_schedule();
+	release_cqt_kernels();   // Keyed to the bin layout; rebuilt on the next CQT frame
+	init_pitch_tracker();
+}
+
+void init_bin_schedule() {
+	const uint16_t num_groups = NUM_FREQS / GOERTZEL_LANES;
+	uint32_t costs[num_groups];
+
+	audio_work_units_unscheduled = 0;
+	for (uint16_t g = 0; g < num_groups; g++) {
+		uint16_t length = 0;
+		for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+			length = max(length, frequencies_musical[g * GOERTZEL_LANES + lane].block_size);
+		}
+
+		// Period from the window length in full-rate samples, cost in bin-samples
+		const uint8_t octave = frequencies_musical[g * GOERTZEL_LANES].octave;
+		group_periods[g] = bin_schedule_period((uint32_t)length << octave, AUDIO_HOP_SAMPLES, BIN_SCHEDULE_MAX_PERIOD,
+		                                       spectral_quality.bin_overlap, spectral_quality.bin_min_period);
+		costs[g] = (uint32_t)length * GOERTZEL_LANES;
+		audio_work_units_unscheduled += costs[g];
+	}
+
+	uint32_t slot_load[BIN_SCHEDULE_MAX_PERIOD];
+	bin_schedule_assign(group_periods, costs, num_groups, BIN_SCHEDULE_MAX_PERIOD, group_phases, slot_load);
+
+	uint32_t peak_load = 0;
+	for (uint8_t s = 0; s < BIN_SCHEDULE_MAX_PERIOD; s++) {
+		peak_load = max(peak_load, slot_load[s]);
+	}
+	schedule_frame = 0;
+	audio_work_units_peak = 0;
+
+	LOG_INFO(TAG_AUDIO, "Bin schedule: peak %lu work units/frame (%lu unscheduled)", (unsigned long)peak_load, (unsigned long)audio_work_units_unscheduled);
+}
+
+void set_spectral_quality(const audio_quality& quality) {
+	const bool reschedule = quality.bin_overlap != spectral_quality.bin_overlap ||
+	                        quality.bin_min_period != spectral_quality.bin_min_period;
+	spectral_quality = quality;
+	if (reschedule) {
+		init_bin_schedule();
+	}
+}
+
+static inline bool group_due(uint16_t group) {
+	return bin_schedule_due(group_periods[group], group_phases[group], schedule_frame);
+}
+
+void init_goertzel_window_tables() {
+	const uint16_t num_groups = NUM_FREQS / GOERTZEL_LANES;
+
+	// Size every group by its longest block
+	uint32_t total_entries = 0;
+	for (uint16_t g = 0; g < num_groups; g++) {
+		uint16_t length = 0;
+		for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+			length = max(length, frequencies_musical[g * GOERTZEL_LANES + lane].block_size);
+		}
+		goertzel_groups[g].first_bin = g * GOERTZEL_LANES;
+		goertzel_groups[g].length = length;
+		total_entries += (uint32_t)length * GOERTZEL_LANES;
+	}
+
+	if (goertzel_window_storage != NULL) {
+		free(goertzel_window_storage);
+	}
+	goertzel_window_storage = (int16_t*)malloc(total_entries * sizeof(int16_t));
+	if (goertzel_window_storage == NULL) {
+		LOG_ERROR(TAG_AUDIO, "Goertzel window tables: alloc of %lu bytes failed, using single-bin path", (unsigned long)(total_entries * sizeof(int16_t)));
+		return;
+	}
+
+	// Bake each bin's window_lookup walk into its own Q15 lane
+	int16_t* table = goertzel_window_storage;
+	for (uint16_t g = 0; g < num_groups; g++) {
+		uint16_t lane_block_sizes[GOERTZEL_LANES];
+		float lane_window_steps[GOERTZEL_LANES];
+		for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+			const freq& bin = frequencies_musical[goertzel_groups[g].first_bin + lane];
+			lane_block_sizes[lane] = bin.block_size;
+			lane_window_steps[lane] = bin.window_step;
+		}
+
+		goertzel_build_group_window(table, goertzel_groups[g].length, lane_block_sizes, lane_window_steps, window_lookup);
+		goertzel_groups[g].window = table;
+		table += (uint32_t)goertzel_groups[g].length * GOERTZEL_LANES;
+	}
+
+	LOG_INFO(TAG_AUDIO, "Goertzel window tables: %u groups, %lu bytes", num_groups, (unsigned long)(total_entries * sizeof(int16_t)));
+}
+
+bool cqt_engine_supported() {
+	for (uint16_t i = 0; i < NUM_FREQS; i++) {
+		if (frequencies_musical[i].block_size > CQT_FFT_SIZE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void release_cqt_kernels() {
+	if (cqt_kernel_entries != NULL) {
+		free(cqt_kernel_entries);
+		cqt_kernel_entries = NULL;
+		LOG_INFO(TAG_AUDIO, "CQT kernels released");
+	}
+}
+
+static bool build_cqt_kernels() {
+	if (!cqt_engine_supported()) {
+		LOG_ERROR(TAG_AUDIO, "CQT: a bin block exceeds the %u-sample frame, engine unavailable", CQT_FFT_SIZE);
+		return false;
+	}
+
+	cqt_fft_init_twiddles(cqt_twiddles, CQT_FFT_SIZE);
+
+	// Two passes over the bins: count the surviving weights, then fill the shared table
+	float window[CQT_FFT_SIZE];
+	uint32_t total_entries = 0;
+	cqt_kernel_entry* entries = NULL;
+	for (uint8_t pass = 0; pass < 2; pass++) {
+		for (uint16_t i = 0; i < NUM_FREQS; i++) {
+			const freq& bin = frequencies_musical[i];
+
+			// Same window walk as the Goertzel loop
+			float window_pos = 0.0;
+			for (uint16_t n = 0; n < bin.block_size; n++) {
+#if AUDIO_FIXED_POINT
+				window[n] = window_lookup[uint32_t(window_pos)] / 32768.0f;
+#else
+				window[n] = window_lookup[uint32_t(window_pos)];
+#endif
+				window_pos += bin.window_step;
+			}
+
+			float omega = acos(bin.coeff * 0.5);
+			const uint16_t frame_size = cqt_frame_size(bin.block_size);
+			if (pass == 0) {
+				cqt_bin_kernels[i].first = total_entries;
+				cqt_bin_kernels[i].frame_size = frame_size;
+				cqt_bin_kernels[i].count = cqt_build_kernel(NULL, frame_size, bin.block_size, window, omega, CQT_KERNEL_THRESHOLD, cqt_frame, cqt_twiddles, CQT_FFT_SIZE);
+				total_entries += cqt_bin_kernels[i].count;
+			}
+			else {
+				cqt_build_kernel(&entries[cqt_bin_kernels[i].first], frame_size, bin.block_size, window, omega, CQT_KERNEL_THRESHOLD, cqt_frame, cqt_twiddles, CQT_FFT_SIZE);
+			}
+		}
+
+		if (pass == 0) {
+			entries = (cqt_kernel_entry*)malloc(total_entries * sizeof(cqt_kernel_entry));
+			if (entries == NULL) {
+				LOG_ERROR(TAG_AUDIO, "CQT kernels: alloc of %lu bytes failed, engine unavailable", (unsigned long)(total_entries * sizeof(cqt_kernel_entry)));
+				return false;
+			}
+		}
+	}
+
+	cqt_kernel_entries = entries;
+	LOG_INFO(TAG_AUDIO, "CQT kernels: %lu entries, %lu bytes", (unsigned long)total_entries, (unsigned long)(total_entries * sizeof(cqt_kernel_entry)));
+	return true;
+}
+
+void update_cqt_engine() {
+	if (configuration.spectral_engine != SPECTRAL_ENGINE_CQT) {
+		release_cqt_kernels();
+		return;
+	}
+	if (cqt_kernel_entries == NULL && !build_cqt_kernels()) {
+		configuration.spectral_engine = SPECTRAL_ENGINE_GOERTZEL;
+	}
+}
+
+bool cqt_engine_ready() {
+	return cqt_kernel_entries != NULL;
+}
+
+void init_pitch_tracker() {
+	pitch_tracker_init(pitch_state);
+	memset(&pitch_latest, 0, sizeof(pitch_latest));
+	pitch_frame = 0;
 }
 
 void init_window_lookup() {
     float sigma = 0.8; // For gaussian window
 
     for (uint16_t i = 0; i < 2048; i++) {
-        float ratio = i / 2047.0;
-
         float n_minus_halfN = i - 2048 / 2;
         float gaussian_weighing_factor = exp(-0.5 * pow((n_minus_halfN / (sigma * 2048 / 2)), 2));
 
@@ -290,8 +607,12 @@ void init_window_lookup() {
         // Gaussian window
         float weighing_factor = gaussian_weighing_factor;
 
+#if AUDIO_FIXED_POINT
+        window_lookup[i] = goertzel_float_to_q15(weighing_factor);
+#else
         window_lookup[i] = weighing_factor;
-        window_lookup[4095 - i] = weighing_factor; // Mirror the value for the second half
+#endif
+        window_lookup[4095 - i] = window_lookup[i]; // Mirror the value for the second half
     }
 }
 
@@ -335,23 +656,189 @@ void median_filter(float* spectrogram_column) {
 	memcpy(spectrogram_column, output, sizeof(output));
 }
 
+// Perceptual tilt applied to every bin (favours the top of the spectrum)
+static inline float bin_scale(uint16_t bin_number) {
+	float progress = float(bin_number) / NUM_FREQS;
+	progress *= progress;
+	progress *= progress;
+	return (progress * 0.995) + 0.005;
+}
+
+// Raw magnitudes for the bins due this frame, GOERTZEL_LANES bins per pass
+// Same result as calling calculate_magnitude_of_bin() for each of them; returns work units
+static uint32_t calculate_magnitudes_grouped(float* magnitudes_out) {
+	uint32_t work_units = 0;
+
+	profile_function([&]() {
+		for (uint16_t g = 0; g < NUM_FREQS / GOERTZEL_LANES; g++) {
+			if (!group_due(g)) {
+				continue;
+			}
+
+			const goertzel_bin_group& group = goertzel_groups[g];
+			const uint8_t octave = frequencies_musical[group.first_bin].octave;
+			const audio_sample_t* history = &get_octave_history(octave)[(get_octave_history_length(octave) - 1) - group.length];
+
+			float coeff[GOERTZEL_LANES];
+			for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+				coeff[lane] = frequencies_musical[group.first_bin + lane].coeff;
+			}
+
+			float q1[GOERTZEL_LANES];
+			float q2[GOERTZEL_LANES];
+#if AUDIO_FIXED_POINT
+			int32_t coeff_q30[GOERTZEL_LANES];
+			uint8_t shift[GOERTZEL_LANES];
+			for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+				coeff_q30[lane] = frequencies_musical[group.first_bin + lane].coeff_q30;
+				shift[lane] = frequencies_musical[group.first_bin + lane].fixed_shift;
+			}
+
+			int32_t q1_fixed[GOERTZEL_LANES];
+			int32_t q2_fixed[GOERTZEL_LANES];
+			goertzel_run_group_fixed(history, group.window, group.length, coeff_q30, shift, q1_fixed, q2_fixed);
+
+			for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+				q1[lane] = goertzel_fixed_to_float(q1_fixed[lane], shift[lane]);
+				q2[lane] = goertzel_fixed_to_float(q2_fixed[lane], shift[lane]);
+			}
+#else
+			goertzel_run_group(history, group.window, group.length, coeff, q1, q2);
+#endif
+
+			for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+				uint16_t bin = group.first_bin + lane;
+				float magnitude_squared = (q1[lane] * q1[lane]) + (q2[lane] * q2[lane]) - q1[lane] * q2[lane] * coeff[lane];
+				// Decimated bins sum 2^octave fewer samples; scale back to full-rate units
+				float normalized_magnitude = magnitude_squared / (frequencies_musical[bin].block_size / 2.0) * (1 << octave);
+				magnitudes_out[bin] = normalized_magnitude * bin_scale(bin);
+			}
+			work_units += (uint32_t)group.length * GOERTZEL_LANES;
+		}
+	}, __func__ );
+
+	return work_units;
+}
+
+// Load the newest `size` samples of an octave stage into cqt_frame and transform them
+static void load_cqt_frame(uint8_t octave, uint16_t size) {
+	const audio_sample_t* history = &get_octave_history(octave)[(get_octave_history_length(octave) - 1) - size];
+	for (uint16_t m = 0; m < size; m++) {
+#if AUDIO_FIXED_POINT
+		cqt_frame[m].re = history[m] / 32768.0f;
+#else
+		cqt_frame[m].re = history[m];
+#endif
+		cqt_frame[m].im = 0.0f;
+	}
+	cqt_fft(cqt_frame, size, cqt_twiddles, CQT_FFT_SIZE);
+}
+
+// Butterflies in one `size`-point FFT
+static inline uint32_t cqt_fft_work_units(uint16_t size) {
+	uint32_t stages = 0;
+	while ((1u << stages) < size) {
+		stages++;
+	}
+	return (size / 2) * stages;
+}
+
+// Linear spectrum of the full-rate frame into fft_smooth (expects cqt_frame to hold stage 0, CQT_FFT_SIZE points)
+static void update_fft_smooth() {
+	static float max_val_smooth = 0.0;
+	float magnitudes[NUM_FFT_BINS];
+
+	float max_val = 0.0;
+	for (uint16_t j = 0; j < NUM_FFT_BINS; j++) {
+		// Hann window applied in the spectral domain: -1/4, 1/2, -1/4
+		const cqt_complex& left = cqt_frame[(j + CQT_FFT_SIZE - 1) & (CQT_FFT_SIZE - 1)];
+		const cqt_complex& right = cqt_frame[j + 1];
+		float re = 0.5f * cqt_frame[j].re - 0.25f * (left.re + right.re);
+		float im = 0.5f * cqt_frame[j].im - 0.25f * (left.im + right.im);
+		magnitudes[j] = sqrtf(re * re + im * im) / (CQT_FFT_SIZE / 4);
+		max_val = max(max_val, magnitudes[j]);
+	}
+
+	// Same slow auto-range follower as the spectrogram
+	max_val_smooth += (max_val - max_val_smooth) * 0.005;
+	if (max_val_smooth < 0.000001) {
+		max_val_smooth = 0.000001;
+	}
+
+	float autoranger_scale = 1.0 / max_val_smooth;
+	for (uint16_t j = 0; j < NUM_FFT_BINS; j++) {
+		float target = clip_float(magnitudes[j] * autoranger_scale);
+		fft_smooth[j] = clip_float((fft_smooth[j] * 0.75f + target * 0.25f) * configuration.microphone_gain);
+	}
+}
+
+// Raw magnitudes for the bins due this frame from one FFT per octave stage and frame size, and the kernels
+// Matches calculate_magnitudes_grouped() to within the kernel threshold; returns work units
+static uint32_t calculate_magnitudes_cqt(float* magnitudes_out) {
+	uint32_t work_units = 0;
+
+	profile_function([&]() {
+		int16_t loaded_octave = -1;
+		uint16_t loaded_size = 0;
+		for (uint16_t i = 0; i < NUM_FREQS; i++) {
+			if (!group_due(i / GOERTZEL_LANES)) {
+				continue;
+			}
+
+			const uint8_t octave = frequencies_musical[i].octave;
+			const uint16_t size = cqt_bin_kernels[i].frame_size;
+			if (octave != loaded_octave || size != loaded_size) {
+				load_cqt_frame(octave, size);
+				loaded_octave = octave;
+				loaded_size = size;
+				work_units += cqt_fft_work_units(size);
+			}
+
+			float magnitude_squared = cqt_apply_kernel(cqt_frame, &cqt_kernel_entries[cqt_bin_kernels[i].first], cqt_bin_kernels[i].count);
+			float normalized_magnitude = magnitude_squared / (frequencies_musical[i].block_size / 2.0) * (1 << octave);
+			magnitudes_out[i] = normalized_magnitude * bin_scale(i);
+			work_units += cqt_bin_kernels[i].count;
+		}
+
+		// Linear spectrum: skipped on off frames at reduced quality (fft_smooth holds)
+		if ((schedule_frame % spectral_quality.refresh_interval) == 0) {
+			if (loaded_octave != 0 || loaded_size != CQT_FFT_SIZE) {
+				load_cqt_frame(0, CQT_FFT_SIZE);
+				work_units += cqt_fft_work_units(CQT_FFT_SIZE);
+			}
+			update_fft_smooth();
+		}
+	}, __func__ );
+
+	return work_units;
+}
+
 float calculate_magnitude_of_bin(uint16_t bin_number) {
 	float normalized_magnitude;
 	float scale;
 
 	profile_function([&]() {
-		float q0 = 0;
 		float q1 = 0;
 		float q2 = 0;
-		float window_pos = 0.0;
 
 		const uint16_t block_size = frequencies_musical[bin_number].block_size;
 
 		float coeff = frequencies_musical[bin_number].coeff;
 		float window_step = frequencies_musical[bin_number].window_step;
 
-		float* sample_ptr = &sample_history[(SAMPLE_HISTORY_LENGTH - 1) - block_size];
-
+		const uint8_t octave = frequencies_musical[bin_number].octave;
+		const audio_sample_t* sample_ptr = &get_octave_history(octave)[(get_octave_history_length(octave) - 1) - block_size];
+
+#if AUDIO_FIXED_POINT
+		int32_t q1_fixed;
+		int32_t q2_fixed;
+		const uint8_t shift = frequencies_musical[bin_number].fixed_shift;
+		goertzel_run_fixed(sample_ptr, block_size, window_lookup, window_step, frequencies_musical[bin_number].coeff_q30, shift, &q1_fixed, &q2_fixed);
+		q1 = goertzel_fixed_to_float(q1_fixed, shift);
+		q2 = goertzel_fixed_to_float(q2_fixed, shift);
+#else
+		float q0 = 0;
+		float window_pos = 0.0;
 		for (uint16_t i = 0; i < block_size; i++) {
 			float windowed_sample = sample_ptr[i] * window_lookup[uint32_t(window_pos)];
 			q0 = coeff * q1 - q2 + windowed_sample;
@@ -360,15 +847,11 @@ float calculate_magnitude_of_bin(uint16_t bin_number) {
 
 			window_pos += window_step;
 		}
+#endif
 
 		float magnitude_squared = (q1 * q1) + (q2 * q2) - q1 * q2 * coeff;
-		float magnitude = sqrt(magnitude_squared);
-		normalized_magnitude = magnitude_squared / (block_size / 2.0);
-
-		float progress = float(bin_number) / NUM_FREQS;
-		progress *= progress;
-		progress *= progress;
-		scale = (progress * 0.995) + 0.005;
+		normalized_magnitude = magnitude_squared / (block_size / 2.0) * (1 << octave);
+		scale = bin_scale(bin_number);
 
 	}, __func__ );
 
@@ -382,12 +865,18 @@ float collect_and_filter_noise(float input_magnitude, uint16_t bin) {
 			output_magnitude = 0.0;
 		}
 
+		// Boot probe: measure the live level while still filtering with the stored floor
+		if (noise_probe_frames_remaining > 0 && noise_probe_frames_remaining <= NOISE_PROBE_FRAMES) {
+			noise_level_sum[bin] += input_magnitude;
+		}
+
 		return output_magnitude;
 	}
 	else {
 		if (input_magnitude > noise_spectrum[bin]) {
 			noise_spectrum[bin] = input_magnitude*0.75;
 		}
+		noise_level_sum[bin] += input_magnitude;
 
 		return input_magnitude;
 	}
@@ -400,41 +889,72 @@ void calculate_magnitudes() {
 		const uint16_t NUM_AVERAGE_SAMPLES = 6;
 
 		static float magnitudes_raw[NUM_FREQS];
+		static float magnitudes_fresh[NUM_FREQS];
 		static float magnitudes_avg[NUM_AVERAGE_SAMPLES][NUM_FREQS];
+		static float magnitudes_avg_sum[NUM_FREQS];
 		static float magnitudes_smooth[NUM_FREQS];
 		static float max_val_smooth = 0.0;
 
-		static uint32_t iter = 0;
-		iter++;
+		// Ring slot for this frame; sums are rebuilt once per lap to bound float drift
+		static uint8_t avg_index = 0;
+		avg_index = (avg_index + 1) % NUM_AVERAGE_SAMPLES;
+		if (avg_index == 0) {
+			running_mean_resync(&magnitudes_avg[0][0], NUM_AVERAGE_SAMPLES, NUM_FREQS, magnitudes_avg_sum);
+		}
+
+		// Fresh raw magnitudes for the bins due this frame (interlaced by block length)
+		update_cqt_engine();
+		uint32_t work_units = 0;
+		if (configuration.spectral_engine == SPECTRAL_ENGINE_CQT && cqt_kernel_entries != NULL) {
+			work_units = calculate_magnitudes_cqt(magnitudes_fresh);
+		}
+		else if (goertzel_window_storage != NULL) {
+			work_units = calculate_magnitudes_grouped(magnitudes_fresh);
+		}
+		else {
+			for (uint16_t i = 0; i < NUM_FREQS; i++) {
+				if (group_due(i / GOERTZEL_LANES)) {
+					magnitudes_fresh[i] = calculate_magnitude_of_bin(i);
+					work_units += frequencies_musical[i].block_size;
+				}
+			}
+		}
 
+		audio_work_units_last = work_units;
+		if (audio_work_units_peak_reset_requested) {
+			audio_work_units_peak = 0;
+			audio_work_units_peak_reset_requested = false;
+		}
+		if (work_units > audio_work_units_peak) {
+			audio_work_units_peak = work_units;
+		}
+
+		// Pass 1: schedule ramp, noise subtraction and the 6-frame running mean
+		// (split from pass 2 only because the autoranger needs the max of all bins)
 		float max_val = 0.0;
-		// Iterate over all target frequencies - calculate ALL bins every frame (no interlacing)
 		for (uint16_t i = 0; i < NUM_FREQS; i++) {
-			// Get raw magnitude of frequency
-			magnitudes_raw[i] = calculate_magnitude_of_bin(i);  // fast_mode enabled (downsampled audio)
+			// Bins that were not due ramp toward their latest result
+			const uint16_t g = i / GOERTZEL_LANES;
+			const uint8_t age = bin_schedule_age(group_periods[g], group_phases[g], schedule_frame);
+			if (age == 0) {
+				magnitudes_previous[i] = magnitudes_latest[i];
+				magnitudes_latest[i] = magnitudes_fresh[i];
+			}
+			magnitudes_raw[i] = bin_schedule_interpolate(magnitudes_previous[i], magnitudes_latest[i], group_periods[g], age);
+
 			magnitudes_raw[i] = collect_and_filter_noise(magnitudes_raw[i], i);
 
 			// Store raw magnitude
 			frequencies_musical[i].magnitude_full_scale = magnitudes_raw[i];
 
-			// Add raw magnitude to moving average array
-			magnitudes_avg[iter % NUM_AVERAGE_SAMPLES][i] = magnitudes_raw[i];
-
-			// Sum up current moving average and divide
-			float magnitudes_avg_result = 0.0;
-			for (uint8_t a = 0; a < NUM_AVERAGE_SAMPLES; a++) {
-				magnitudes_avg_result += magnitudes_avg[a][i];
-			}
-			magnitudes_avg_result /= NUM_AVERAGE_SAMPLES;
-
-			// Store averaged value
-			magnitudes_smooth[i] = magnitudes_avg_result;
+			magnitudes_smooth[i] = running_mean_replace(magnitudes_avg_sum[i], magnitudes_avg[avg_index][i], magnitudes_raw[i], NUM_AVERAGE_SAMPLES);
 
 			// Accumulate maximum magnitude of all bins
 			if (magnitudes_smooth[i] > max_val) {
 				max_val = magnitudes_smooth[i];
 			}
 		}
+		schedule_frame++;
 
 		if(noise_calibration_active_frames_remaining > 0){
 			// Not done yet? Decrement...
@@ -442,6 +962,14 @@ void calculate_magnitudes() {
 
 			// If background noise calibration just finished
 			if(noise_calibration_active_frames_remaining == 0){
+				for (uint16_t i = 0; i < NUM_FREQS; i++) {
+					noise_level[i] = noise_level_sum[i] / NOISE_CALIBRATION_FRAMES;
+				}
+
+				// Fresh profile: nothing left to recalibrate
+				noise_profile_drift_last = 0.0f;
+				noise_profile_stale = false;
+
 				// Let the UI know
 				broadcast("noise_cal_ready");
 				save_config();
@@ -450,6 +978,30 @@ void calculate_magnitudes() {
 			}
 		}
 
+		if (noise_probe_frames_remaining > 0) {
+			noise_probe_frames_remaining -= 1;
+
+			// Stored profile still describes the room? Otherwise learn it again
+			if (noise_probe_frames_remaining == 0) {
+				float probed[NUM_FREQS];
+				for (uint16_t i = 0; i < NUM_FREQS; i++) {
+					probed[i] = noise_level_sum[i] / NOISE_PROBE_FRAMES;
+				}
+
+				// Kept either way: the room may simply not be quiet right now
+				float drift = noise_profile_drift(noise_level, probed, NUM_FREQS);
+				noise_profile_drift_last = drift;
+				noise_profile_stale = drift > NOISE_PROBE_DRIFT_LIMIT;
+				if (noise_profile_stale) {
+					LOG_WARN(TAG_AUDIO, "Noise profile drifted (%.2f), recalibrate in a quiet room", drift);
+					broadcast("noise_profile_stale");
+				}
+				else {
+					LOG_INFO(TAG_AUDIO, "Noise profile confirmed (drift %.2f)", drift);
+				}
+			}
+		}
+
 		// Smooth max_val with different speed limits for increases vs. decreases
 		if (max_val > max_val_smooth) {
 			float delta = max_val - max_val_smooth;
@@ -468,50 +1020,43 @@ void calculate_magnitudes() {
 		// Calculate auto-ranging scale
 		float autoranger_scale = 1.0 / (max_val_smooth);
 
-		// Iterate over all frequencies
-		for (uint16_t i = 0; i < NUM_FREQS; i++) {
-			// Apply the auto-scaler
-			frequencies_musical[i].magnitude = clip_float(magnitudes_smooth[i] * autoranger_scale);
-			spectrogram[i] = frequencies_musical[i].magnitude;
-		}
-
 		spectrogram_average_index++;
 		if(spectrogram_average_index >= NUM_SPECTROGRAM_AVERAGE_SAMPLES){
 			spectrogram_average_index = 0;
+			running_mean_resync(&spectrogram_average[0][0], NUM_SPECTROGRAM_AVERAGE_SAMPLES, NUM_FREQS, spectrogram_average_sum);
 		}
 
-		for(uint16_t i = 0; i < NUM_FREQS; i++){
-			spectrogram_average[spectrogram_average_index][i] = spectrogram[i];
-
-			spectrogram_smooth[i] = 0;
-			for(uint16_t a = 0; a < NUM_SPECTROGRAM_AVERAGE_SAMPLES; a++){
-				spectrogram_smooth[i] += spectrogram_average[a][i];
-			}
-			spectrogram_smooth[i] /= float(NUM_SPECTROGRAM_AVERAGE_SAMPLES);
-		}
-
-		// MICROPHONE GAIN APPLICATION (NEW - FIX FOR BEAT DETECTION SENSITIVITY)
-		// Apply user-configured microphone gain to all frequency bins
-		// This amplifies or attenuates the entire spectrum uniformly
-		// Range: 0.5x (-6dB) to 2.0x (+6dB), default 1.0x (0dB, no change)
-		for (uint16_t i = 0; i < NUM_FREQS; i++) {
-			spectrogram[i] = clip_float(spectrogram[i] * configuration.microphone_gain);
-			spectrogram_smooth[i] = clip_float(spectrogram_smooth[i] * configuration.microphone_gain);
-		}
-
-		// Calculate VU level from overall spectrum energy (average across all bins)
+		// Pass 2: auto-scaler, 8-frame running mean, microphone gain, clipping and VU
+		// accumulation, written straight into the back buffer
+		// Gain range: 0.5x (-6dB) to 2.0x (+6dB), default 1.0x (0dB, no change)
 		float vu_sum = 0.0f;
 		for (uint16_t i = 0; i < NUM_FREQS; i++) {
+			frequencies_musical[i].magnitude = clip_float(magnitudes_smooth[i] * autoranger_scale);
+
+			float smooth = running_mean_replace(spectrogram_average_sum[i], spectrogram_average[spectrogram_average_index][i], frequencies_musical[i].magnitude, NUM_SPECTROGRAM_AVERAGE_SAMPLES);
+
+			spectrogram[i] = clip_float(frequencies_musical[i].magnitude * configuration.microphone_gain);
+			spectrogram_smooth[i] = clip_float(smooth * configuration.microphone_gain);
 			vu_sum += spectrogram_smooth[i];
+
+			if (audio_sync_initialized) {
+				audio_back.spectrogram[i] = spectrogram[i];
+				audio_back.spectrogram_smooth[i] = spectrogram_smooth[i];
+			}
 		}
+
+		// VU level from overall spectrum energy (average across all bins)
 		float vu_level_calculated = vu_sum / NUM_FREQS;
 		audio_level = vu_level_calculated;  // Update legacy global variable
 
-		// PHASE 1: Copy spectrum data to audio_back buffer for thread-safe access
+		// PHASE 1: Remaining frame data to audio_back buffer for thread-safe access
 		if (audio_sync_initialized) {
-			// Copy spectrogram data
-			memcpy(audio_back.spectrogram, spectrogram, sizeof(float) * NUM_FREQS);
-			memcpy(audio_back.spectrogram_smooth, spectrogram_smooth, sizeof(float) * NUM_FREQS);
+			if (configuration.spectral_engine == SPECTRAL_ENGINE_CQT && cqt_kernel_entries != NULL) {
+				memcpy(audio_back.fft_smooth, fft_smooth, sizeof(float) * NUM_FFT_BINS);
+			}
+			else {
+				memset(audio_back.fft_smooth, 0, sizeof(float) * NUM_FFT_BINS);
+			}
 
 			// CRITICAL FIX: Sync VU level to snapshot for audio-reactive patterns (e.g., bloom mode)
 			audio_back.vu_level = vu_level_calculated;
@@ -539,10 +1084,77 @@ void calculate_magnitudes() {
 void start_noise_calibration() {
 	LOG_INFO(TAG_AUDIO, "Starting noise cal...");
 	memset(noise_spectrum, 0, sizeof(float) * NUM_FREQS);
+	memset(noise_level_sum, 0, sizeof(noise_level_sum));
 	configuration.vu_floor = 0.0;
+	noise_probe_frames_remaining = 0;
 	noise_calibration_active_frames_remaining = NOISE_CALIBRATION_FRAMES;
 }
 
+// Everything that changes what a raw bin magnitude means
+static uint32_t noise_profile_config_hash() {
+	const uint32_t setup[] = { SAMPLE_RATE, NUM_FREQS, NUM_OCTAVE_STAGES, AUDIO_FIXED_POINT };
+	uint32_t hash = noise_profile_hash_bytes(NOISE_PROFILE_HASH_SEED, setup, sizeof(setup));
+
+	for (uint16_t i = 0; i < NUM_FREQS; i++) {
+		const freq& bin = frequencies_musical[i];
+		hash = noise_profile_hash_bytes(hash, &bin.target_freq, sizeof(bin.target_freq));
+		hash = noise_profile_hash_bytes(hash, &bin.octave, sizeof(bin.octave));
+		hash = noise_profile_hash_bytes(hash, &bin.block_size, sizeof(bin.block_size));
+		hash = noise_profile_hash_bytes(hash, &bin.coeff, sizeof(bin.coeff));
+	}
+	return hash;
+}
+
+void save_noise_spectrum() {
+	noise_profile profile;
+	profile.format = NOISE_PROFILE_FORMAT;
+	profile.config_hash = noise_profile_config_hash();
+	memcpy(profile.spectrum, noise_spectrum, sizeof(profile.spectrum));
+	memcpy(profile.level, noise_level, sizeof(profile.level));
+
+	Preferences prefs;
+	if (!prefs.begin("noise_profile", false)) {
+		LOG_ERROR(TAG_AUDIO, "Noise profile: NVS unavailable, not saved");
+		return;
+	}
+	size_t written = prefs.putBytes("profile", &profile, sizeof(profile));
+	prefs.end();
+
+	if (written != sizeof(profile)) {
+		LOG_ERROR(TAG_AUDIO, "Noise profile: NVS write failed");
+		return;
+	}
+	LOG_INFO(TAG_AUDIO, "Noise profile saved (config %08lx)", (unsigned long)profile.config_hash);
+}
+
+void init_noise_profile() {
+	noise_profile profile;
+	bool loaded = false;
+
+	Preferences prefs;
+	if (prefs.begin("noise_profile", true)) {
+		loaded = prefs.getBytes("profile", &profile, sizeof(profile)) == sizeof(profile);
+		prefs.end();
+	}
+
+	// No auto-calibration: live audio at power-on may be music
+	if (!loaded) {
+		LOG_INFO(TAG_AUDIO, "No stored noise profile, no noise subtraction until calibrated");
+		return;
+	}
+	if (!noise_profile_matches(profile, noise_profile_config_hash())) {
+		LOG_INFO(TAG_AUDIO, "Stored noise profile is for another setup, no noise subtraction until calibrated");
+		return;
+	}
+
+	memcpy(noise_spectrum, profile.spectrum, sizeof(profile.spectrum));
+	memcpy(noise_level, profile.level, sizeof(profile.level));
+	memset(noise_level_sum, 0, sizeof(noise_level_sum));
+	noise_probe_frames_remaining = NOISE_PROBE_SETTLE_FRAMES + NOISE_PROBE_FRAMES;
+	LOG_INFO(TAG_AUDIO, "Noise profile loaded, checking over %u frames after %u to settle",
+	         NOISE_PROBE_FRAMES, NOISE_PROBE_SETTLE_FRAMES);
+}
+
 void get_chromagram(){
 	memset(chromagram, 0, sizeof(float) * 12);
 
@@ -565,8 +1177,31 @@ void get_chromagram(){
 	}
 }
 
+void calculate_pitch() {
+	profile_function([&]() {
+		if ((pitch_frame++ % spectral_quality.refresh_interval) == 0) {
+			const audio_sample_t* history = &get_octave_history(PITCH_OCTAVE)[get_octave_history_length(PITCH_OCTAVE) - PITCH_WINDOW];
+			float window[PITCH_WINDOW];
+			for (uint16_t n = 0; n < PITCH_WINDOW; n++) {
+#if AUDIO_FIXED_POINT
+				window[n] = history[n] / 32768.0f;
+#else
+				window[n] = history[n];
+#endif
+			}
+			pitch_latest = pitch_track(pitch_state, window, (float)(SAMPLE_RATE >> PITCH_OCTAVE));
+		}
+	}, __func__);
+
+	if (audio_sync_initialized) {
+		audio_back.pitch_hz = pitch_latest.f0_hz;
+		audio_back.pitch_clarity = pitch_latest.clarity;
+		audio_back.pitch_midi = pitch_latest.midi_note;
+	}
+}
+
 // =============================================================================
-// PHASE 1: Complete audio processing frame and commit to front buffer
+// PHASE 1: Complete audio processing frame and publish it
 // This should be called after all audio processing (calculate_magnitudes,
 // get_chromagram, tempo updates, etc.) is complete for the current frame.
 // =============================================================================
@@ -575,7 +1210,7 @@ void finish_audio_frame() {
 		return;
 	}
 
-	// Commit the back buffer to the front buffer (atomic swap)
+	// Publish the back slot to the render task
 	commit_audio_data();
 }
 
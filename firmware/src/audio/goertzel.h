@@ -22,6 +22,12 @@
 #include <stdint.h>
 #include <cstring>
 #include <cmath>
+#include "mirrored_ring.h"
+#include "goertzel_fixed.h"
+#include "audio_cadence.h"
+#include "quality_governor.h"
+#include "triple_buffer.h"
+#include "feature_interp.h"
 
 // Profiling macro - simplified for now (just execute lambda)
 #define profile_function(lambda, name) lambda()
@@ -34,12 +40,40 @@
 // Audio sample buffer
 #define SAMPLE_RATE 16000
 #define SAMPLE_HISTORY_LENGTH 4096
+#define AUDIO_HOP_SAMPLES 128            // New samples per audio frame (CHUNK_SIZE in microphone.h)
+
+// Analysis precision (select with -DAUDIO_FIXED_POINT=1 in build_flags)
+// 0: float samples, window and Goertzel state
+// 1: Q15 samples and window, int32 Goertzel state (see goertzel_fixed.h)
+#ifndef AUDIO_FIXED_POINT
+#define AUDIO_FIXED_POINT 0
+#endif
+
+// Octave decimation (see octave_decimator.h)
+#define NUM_OCTAVE_STAGES 4              // 16 kHz, 8 kHz, 4 kHz, 2 kHz
+#define OCTAVE_HISTORY_LENGTH 512        // Per decimated stage, must be a power of two
+
+// Spectral engine (see cqt_kernel.h); boot default via -DSPECTRAL_ENGINE_DEFAULT=1,
+// switchable at runtime through configuration.spectral_engine / POST /api/audio-config
+#define SPECTRAL_ENGINE_GOERTZEL 0       // Per-bin Goertzel filters (grouped kernel)
+#define SPECTRAL_ENGINE_CQT 1            // One FFT per octave stage + sparse spectral kernels
+#ifndef SPECTRAL_ENGINE_DEFAULT
+#define SPECTRAL_ENGINE_DEFAULT SPECTRAL_ENGINE_GOERTZEL
+#endif
+#define CQT_FFT_SIZE 256                 // Largest kernel frame, must hold every bin's block
+#define CQT_KERNEL_THRESHOLD 0.001f      // Kernel weights below this fraction of the peak are dropped
+#define NUM_FFT_BINS 128                 // CQT_FFT_SIZE / 2, published as fft_smooth
+
+// Pitch tracking (see pitch_tracker.h)
+#define PITCH_OCTAVE 1                   // 8 kHz stage: 62.5 Hz - 2 kHz, PITCH_WINDOW samples (32 ms)
 
 #define TWOPI   6.28318530
 #define FOURPI 12.56637061
 #define SIXPI  18.84955593
 
 #define NOISE_CALIBRATION_FRAMES 512
+#define NOISE_PROBE_FRAMES 32            // Boot check of a stored noise profile (see noise_profile.h)
+#define NOISE_PROBE_DRIFT_LIMIT 0.35f    // Warn above this relative L1 drift of the mean levels
 
 // Frequency analysis configuration
 #define NUM_FREQS 64
@@ -60,9 +94,14 @@
 // Goertzel filter state for a single frequency bin
 struct freq {
 	float target_freq;
-	uint16_t block_size;
+	uint8_t octave;            // Decimation stage the bin runs at (SAMPLE_RATE >> octave)
+	uint16_t block_size;       // In samples at the bin's own rate
 	float window_step;
 	float coeff;
+#if AUDIO_FIXED_POINT
+	int32_t coeff_q30;         // coeff in Q30
+	uint8_t fixed_shift;       // Input shift from goertzel_fixed_shift()
+#endif
 	float magnitude;
 	float magnitude_full_scale;
 	float magnitude_last;
@@ -75,15 +114,16 @@ typedef struct {
 	float magnitude_full_scale; // Full-scale magnitude before auto-ranging
 	float magnitude_smooth;    // Smoothed beat magnitude
 	float beat;                // Beat trigger (-1.0 to 1.0, sin(phase))
-	float phase;               // Beat phase (radians, -π to π)
+	float phase;               // Beat phase (radians, -π to π) at tempo_phase_time_us
+	float phase_velocity;      // Phase advance (radians/s, see beat_clock.h)
 	float target_tempo_hz;     // Target tempo frequency (Hz)
 	uint16_t block_size;
-	float window_step;
-	float coeff;
+	uint16_t dft_bin;          // Integer DFT bin over block_size novelty samples (see tempo_bank.h)
 } tempo;
 
 // Audio data snapshot for synchronization between cores
-// Used in double-buffered audio processing with sequence counter synchronization
+// Used in triple-buffered audio processing (see triple_buffer.h); the sequence
+// counter lets get_audio_snapshot() copy a slot without claiming it
 typedef struct {
 	// SYNCHRONIZATION: Sequence counter for torn read detection
 	// Reader checks sequence before and after copy - if different, retry
@@ -105,15 +145,32 @@ typedef struct {
 	float novelty_curve;                    // Spectral flux (onset detection)
 	float tempo_confidence;                 // Beat detection confidence (0.0-1.0)
 	float tempo_magnitude[NUM_TEMPI];       // Tempo bin magnitudes (64 bins)
-	float tempo_phase[NUM_TEMPI];           // Tempo bin phases (64 bins)
-
-	// FFT data (reserved for future full-spectrum analysis)
-	// Currently using Goertzel for musical note detection (more efficient)
-	float fft_smooth[128];                  // Smoothed FFT bins (placeholder)
+	float tempo_phase[NUM_TEMPI];           // Tempo bin phases (64 bins) at tempo_phase_time_us
+	float tempo_phase_velocity[NUM_TEMPI];  // Tempo bin phase velocities (radians/s)
+	uint32_t tempo_phase_time_us;           // When tempo_phase was measured (esp_timer)
+
+	// Linear FFT spectrum (0 to 8 kHz, 62.5 Hz per bin), auto-ranged 0.0-1.0
+	// Only filled while the CQT engine is selected; zero otherwise
+	float fft_smooth[NUM_FFT_BINS];         // Smoothed FFT bins
+
+	// Fundamental frequency (McLeod pitch tracker); all zero while no clear pitch
+	float pitch_hz;                         // f0 estimate (Hz)
+	float pitch_clarity;                    // How periodic the frame is (0.0-1.0)
+	float pitch_midi;                       // MIDI note with cents as fraction (69.0 = A4)
+
+	// Previous analysis frame, blended toward the current one at render time (see feature_interp.h)
+	// Written by commit_audio_data() when the slot is claimed
+	float spectrogram_prev[NUM_FREQS];
+	float spectrogram_smooth_prev[NUM_FREQS];
+	float chromagram_prev[12];
+	float vu_level_prev;
+	uint32_t timestamp_prev_us;
 
 	// Metadata
 	uint32_t update_counter;                // Increments with each audio frame
 	uint32_t timestamp_us;                  // Microsecond timestamp (esp_timer)
+	uint32_t capture_us;                    // DMA completion of the frame's newest chunk (0: no chunk, silence)
+	uint32_t publish_us;                    // When commit_audio_data() published the frame
 	bool is_valid;                          // True if data has been written at least once
 
 	// SYNCHRONIZATION: End sequence counter for validation
@@ -128,6 +185,7 @@ typedef struct {
 extern float spectrogram[NUM_FREQS];              // Raw frequency spectrum
 extern float spectrogram_smooth[NUM_FREQS];      // Smoothed spectrum
 extern float chromagram[12];                      // 12-pitch-class energy
+extern float fft_smooth[NUM_FFT_BINS];            // Linear spectrum (CQT engine only)
 
 // Audio level
 extern float audio_level;                        // Overall RMS level (0.0-1.0)
@@ -136,22 +194,65 @@ extern float audio_level;                        // Overall RMS level (0.0-1.0)
 extern tempo tempi[NUM_TEMPI];                   // Tempo bin detectors
 extern float tempi_smooth[NUM_TEMPI];            // Smoothed tempo bins
 
-// Sample history buffer
-extern float sample_history[SAMPLE_HISTORY_LENGTH];
+// Sample and window storage for the selected analysis precision
+#if AUDIO_FIXED_POINT
+typedef int16_t audio_sample_t;              // Q15
+typedef mirrored_ring_q15 audio_sample_ring;
+typedef int16_t window_weight_t;             // Q15
+#else
+typedef float audio_sample_t;
+typedef mirrored_ring audio_sample_ring;
+typedef float window_weight_t;
+#endif
+
+// Sample history buffer (mirrored ring, see mirrored_ring.h)
+// Read through get_sample_history(): [0] = oldest, [SAMPLE_HISTORY_LENGTH - 1] = newest
+extern audio_sample_ring sample_history;
+
+inline const audio_sample_t* get_sample_history() {
+	return mirrored_ring_window(sample_history);
+}
+
+// Decimated copies of the sample history, one per octave stage below full rate
+extern audio_sample_ring octave_history[NUM_OCTAVE_STAGES - 1];
+
+// History for a decimation stage: stage 0 is sample_history itself
+inline const audio_sample_t* get_octave_history(uint8_t octave) {
+	return octave == 0 ? get_sample_history() : mirrored_ring_window(octave_history[octave - 1]);
+}
+
+inline uint16_t get_octave_history_length(uint8_t octave) {
+	return octave == 0 ? SAMPLE_HISTORY_LENGTH : OCTAVE_HISTORY_LENGTH;
+}
 
 // Goertzel state
 extern freq frequencies_musical[NUM_FREQS];
-extern float window_lookup[4096];
+extern window_weight_t window_lookup[4096];
 extern uint16_t max_goertzel_block_size;
 extern volatile bool magnitudes_locked;
 
+// Interlaced bin scheduling (see bin_scheduler.h)
+// Work units: bin-samples run through a resonator (CQT: kernel MACs + FFT butterflies)
+extern volatile uint32_t audio_work_units_last;         // Work of the latest frame
+extern volatile uint32_t audio_work_units_peak;         // Highest since the last reset
+extern volatile bool audio_work_units_peak_reset_requested;  // Set by the performance API, honoured by the audio task
+extern uint32_t audio_work_units_unscheduled;           // Goertzel work if every bin ran every frame
+
+// Audio task cadence (see audio_cadence.h; written by audio_task in main.cpp)
+extern audio_cadence_stats audio_cadence;
+extern quality_governor audio_governor;                 // Analysis quality level (see quality_governor.h)
+
 // Audio processing state
 extern uint32_t noise_calibration_active_frames_remaining;
+extern uint32_t noise_probe_frames_remaining;
+extern volatile float noise_profile_drift_last;    // Drift found by the last boot probe, -1 until one finished
+extern volatile bool noise_profile_stale;          // That drift exceeded NOISE_PROBE_DRIFT_LIMIT: prompt a recalibration
 extern float noise_spectrum[64];
 
 typedef struct {
 	float vu_floor;
 	float microphone_gain;    // 0.5 - 2.0x (0.5 = -6dB, 1.0 = 0dB, 2.0 = +6dB)
+	uint8_t spectral_engine;  // SPECTRAL_ENGINE_GOERTZEL or SPECTRAL_ENGINE_CQT
 } AudioConfiguration;
 
 extern AudioConfiguration configuration;
@@ -165,9 +266,11 @@ extern int16_t audio_debug_recording[MAX_AUDIO_RECORDING_SAMPLES];
 extern float spectrogram_average[NUM_SPECTROGRAM_AVERAGE_SAMPLES][NUM_FREQS];
 extern uint8_t spectrogram_average_index;
 
-// Double-buffering for thread-safe audio sync
-extern AudioDataSnapshot audio_front;
-extern AudioDataSnapshot audio_back;
+// Triple-buffering for thread-safe audio sync
+extern AudioDataSnapshot audio_snapshots[TRIPLE_BUFFER_SLOTS];
+extern triple_buffer audio_snapshot_slots;
+#define audio_back (audio_snapshots[audio_snapshot_slots.writing])     // Audio task: slot being filled
+#define audio_front (audio_snapshots[audio_snapshot_slots.published])  // Latest published slot
 extern SemaphoreHandle_t audio_swap_mutex;
 extern SemaphoreHandle_t audio_read_mutex;
 
@@ -184,7 +287,34 @@ void init_goertzel_constants_musical();
 // Initialize window function lookup table for Goertzel smoothing
 void init_window_lookup();
 
-// Initialize audio data synchronization (double-buffering)
+// Bake per-bin Q15 window tables for the multi-bin kernel
+// Called by init_goertzel_constants_musical(); needs init_window_lookup() first
+void init_goertzel_window_tables();
+
+// Assign update periods and phases to the Goertzel groups from their block lengths
+// Called by init_goertzel_constants_musical() after the window tables
+void init_bin_schedule();
+
+// Apply the spectral side of a quality level (bin overlap, linear spectrum refresh)
+// Called by audio_task when the governor changes level; reschedules only if the overlap changed
+void set_spectral_quality(const audio_quality& quality);
+
+// CQT kernels (~53 KB) exist only while the CQT engine is selected
+// update_cqt_engine(): called by calculate_magnitudes() on the audio task; builds the kernels for
+// the current bin layout when configuration.spectral_engine selects CQT (falling back to Goertzel
+// if that fails) and frees them when it does not
+// release_cqt_kernels(): called by init_goertzel_constants_musical() when the bin layout changes
+// cqt_engine_supported(): every bin's block fits CQT_FFT_SIZE (checked before selecting the engine)
+void update_cqt_engine();
+void release_cqt_kernels();
+bool cqt_engine_supported();
+bool cqt_engine_ready();
+
+// Twiddles for the pitch tracker's autocorrelation FFT
+// Called by init_goertzel_constants_musical()
+void init_pitch_tracker();
+
+// Initialize audio data synchronization (triple-buffering)
 void init_audio_data_sync();
 
 // ============================================================================
@@ -192,8 +322,13 @@ void init_audio_data_sync();
 // ============================================================================
 
 // Acquire sample chunk from microphone I2S buffer
-// Blocks on portMAX_DELAY until next chunk is ready (synchronization via I2S DMA)
-void acquire_sample_chunk();
+// Does not wait: call after wait_for_sample_chunks() (microphone.h) has reported one
+// Returns false if no chunk was available
+bool acquire_sample_chunk();
+
+// Push a new chunk of full-rate samples through the half-band decimation tree
+// Called by acquire_sample_chunk() right after sample_history is updated
+void feed_octave_histories(const float* samples, uint16_t count);
 
 // Calculate frequency magnitudes using Goertzel algorithm
 void calculate_magnitudes();
@@ -201,20 +336,36 @@ void calculate_magnitudes();
 // Extract 12-pitch-class chromagram from spectrogram
 void get_chromagram();
 
-// Commit audio frame and swap buffers (Core 1 → Core 0)
+// Fundamental frequency of the newest PITCH_WINDOW samples of the PITCH_OCTAVE stage
+// Re-estimated every refresh_interval frames of the quality level, held in between
+void calculate_pitch();
+
+// Publish the audio frame (Core 1 → Core 0)
 void finish_audio_frame();
 
 // Start noise floor calibration
 void start_noise_calibration();
 
+// Load the stored noise profile if it matches the current setup and start the
+// NOISE_PROBE_FRAMES check (once the sample history has filled); otherwise leave the floor empty (no subtraction)
+// until start_noise_calibration() is called
+// Needs init_goertzel_constants_musical() first (the profile is keyed to the bin layout)
+void init_noise_profile();
+
+// Persist noise_spectrum (called when a calibration finishes)
+void save_noise_spectrum();
+
 // ============================================================================
 // PUBLIC API - AUDIO DATA ACCESS (thread-safe, called from pattern rendering)
 // ============================================================================
 
-// Get snapshot of current audio data (non-blocking)
+// Latest audio frame by pointer, valid until the next call (render task only)
+const AudioDataSnapshot* acquire_audio_snapshot();
+
+// Copy of the latest audio frame (non-blocking, any task)
 bool get_audio_snapshot(AudioDataSnapshot* snapshot);
 
-// Commit audio data from back buffer to front buffer (atomic swap)
+// Publish the back slot and claim the next one
 // Used by test suites to validate lock-free synchronization
 void commit_audio_data();
 
@@ -234,7 +385,6 @@ inline float clip_float(float val) {
 // Note: broadcast is not inlined here to avoid Serial dependency
 void broadcast(const char* msg);  // Defined in goertzel.cpp
 inline void save_config() {}
-inline void save_noise_spectrum() {}
 inline void save_audio_debug_recording() {}
 
 // Inline stub for ESP-DSP function
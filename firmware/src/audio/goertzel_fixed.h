@@ -0,0 +1,125 @@
+// -----------------------------------------------------------------
+// Goertzel Fixed-Point Kernels - Q15 input, int32 state (AUDIO_FIXED_POINT)
+//
+// Samples and window weights are Q15, so each windowed sample is a Q30
+// product. The resonator coefficient (2cos w, always < 2) is Q30 and the
+// state update uses one 32x32 -> 64 multiply per step:
+//
+//     q0 = ((int64)coeff * q1 >> 30) - q2 + (sample * window >> shift)
+//
+// Scaling analysis: the Goertzel state is the input convolved with
+// h[n] = sin((n+1)w) / sin(w), and |h[n]| <= min(1 / |sin w|, n + 1).
+// For a block of N full-scale Q30 products the state is therefore bounded
+// by N * min(1 / |sin w|, N) * 2^30. goertzel_fixed_shift() picks the
+// smallest per-bin right shift that keeps that bound under 2^29, which
+// leaves room for the coeff * q1 term (|coeff| < 2) without ever wrapping.
+
+#ifndef GOERTZEL_FIXED_H
+#define GOERTZEL_FIXED_H
+
+#include <stdint.h>
+#include <math.h>
+#include "goertzel_kernel.h"
+
+#define GOERTZEL_COEFF_FRAC_BITS 30
+#define GOERTZEL_STATE_LIMIT_BITS 29
+
+// Saturating float (-1.0 to 1.0) -> Q15
+inline int16_t goertzel_float_to_q15(float x) {
+	float scaled = x * 32768.0f;
+	if (scaled >= 32767.0f) return 32767;
+	if (scaled <= -32768.0f) return -32768;
+	return (int16_t)lrintf(scaled);
+}
+
+inline void goertzel_float_to_q15_block(const float* in, int16_t* out, uint16_t count) {
+	for (uint16_t i = 0; i < count; i++) {
+		out[i] = goertzel_float_to_q15(in[i]);
+	}
+}
+
+inline int32_t goertzel_coeff_to_q30(float coeff) {
+	double scaled = (double)coeff * (double)(1L << GOERTZEL_COEFF_FRAC_BITS);
+	if (scaled > 2147483647.0) return 2147483647;
+	if (scaled < -2147483648.0) return (int32_t)-2147483647 - 1;
+	return (int32_t)llround(scaled);
+}
+
+// Per-bin right shift applied to the Q30 products (see scaling analysis above)
+inline uint8_t goertzel_fixed_shift(uint16_t block_size, float coeff) {
+	float half = coeff * 0.5f;
+	float sine = sqrtf(fmaxf(1.0f - half * half, 0.0f));
+	float gain = (sine * block_size > 1.0f) ? 1.0f / sine : (float)block_size;
+
+	// Need 2^(30 - shift) * N * gain <= 2^29
+	float bound = (float)(1UL << (GOERTZEL_COEFF_FRAC_BITS - GOERTZEL_STATE_LIMIT_BITS)) * block_size * gain;
+	uint8_t shift = 0;
+	while ((float)(1UL << shift) < bound && shift < 30) {
+		shift++;
+	}
+	return shift;
+}
+
+// Goertzel state back to float units (sample * window, as in the float path)
+inline float goertzel_fixed_to_float(int32_t q, uint8_t shift) {
+	return ldexpf((float)q, (int)shift - GOERTZEL_COEFF_FRAC_BITS);
+}
+
+// Q30 product scaled down by `shift` with round-to-nearest
+inline int32_t goertzel_fixed_input(int32_t product, uint8_t shift) {
+	return shift == 0 ? product : (product + (1 << (shift - 1))) >> shift;
+}
+
+inline int32_t goertzel_fixed_step(int32_t coeff_q30, int32_t q1, int32_t q2, int32_t input) {
+	return (int32_t)(((int64_t)coeff_q30 * q1) >> GOERTZEL_COEFF_FRAC_BITS) - q2 + input;
+}
+
+// Single bin over `block_size` samples, window walked exactly like the float loop
+inline void goertzel_run_fixed(const int16_t* samples, uint16_t block_size,
+                               const int16_t* window_lookup, float window_step,
+                               int32_t coeff_q30, uint8_t shift, int32_t* q1_out, int32_t* q2_out) {
+	int32_t q1 = 0;
+	int32_t q2 = 0;
+	float window_pos = 0.0f;
+
+	for (uint16_t i = 0; i < block_size; i++) {
+		int32_t product = (int32_t)samples[i] * window_lookup[uint32_t(window_pos)];
+		int32_t q0 = goertzel_fixed_step(coeff_q30, q1, q2, goertzel_fixed_input(product, shift));
+		q2 = q1;
+		q1 = q0;
+		window_pos += window_step;
+	}
+
+	*q1_out = q1;
+	*q2_out = q2;
+}
+
+// GOERTZEL_LANES bins in lockstep over a goertzel_build_group_window() table
+inline void goertzel_run_group_fixed(const int16_t* samples, const int16_t* window, uint16_t length,
+                                     const int32_t* coeff_q30, const uint8_t* shift,
+                                     int32_t* q1_out, int32_t* q2_out) {
+	int32_t q1_0 = 0, q1_1 = 0, q1_2 = 0, q1_3 = 0;
+	int32_t q2_0 = 0, q2_1 = 0, q2_2 = 0, q2_3 = 0;
+
+	for (uint16_t i = 0; i < length; i++) {
+		const int32_t s = samples[i];
+		const int16_t* w = &window[i * GOERTZEL_LANES];
+
+		int32_t q0_0 = goertzel_fixed_step(coeff_q30[0], q1_0, q2_0, goertzel_fixed_input(s * w[0], shift[0]));
+		int32_t q0_1 = goertzel_fixed_step(coeff_q30[1], q1_1, q2_1, goertzel_fixed_input(s * w[1], shift[1]));
+		int32_t q0_2 = goertzel_fixed_step(coeff_q30[2], q1_2, q2_2, goertzel_fixed_input(s * w[2], shift[2]));
+		int32_t q0_3 = goertzel_fixed_step(coeff_q30[3], q1_3, q2_3, goertzel_fixed_input(s * w[3], shift[3]));
+
+		q2_0 = q1_0; q1_0 = q0_0;
+		q2_1 = q1_1; q1_1 = q0_1;
+		q2_2 = q1_2; q1_2 = q0_2;
+		q2_3 = q1_3; q1_3 = q0_3;
+	}
+
+	q1_out[0] = q1_0; q2_out[0] = q2_0;
+	q1_out[1] = q1_1; q2_out[1] = q2_1;
+	q1_out[2] = q1_2; q2_out[2] = q2_2;
+	q1_out[3] = q1_3; q2_out[3] = q2_3;
+}
+
+#endif  // GOERTZEL_FIXED_H
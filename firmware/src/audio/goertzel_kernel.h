@@ -0,0 +1,129 @@
+// -----------------------------------------------------------------
+// Goertzel Kernel - Multi-bin lockstep recurrence
+//
+// Runs GOERTZEL_LANES Goertzel filters over the same sample span at once.
+// Each lane reads its own precomputed, block-size-specific window from an
+// interleaved table ([sample][lane]) stored as Q15. Lanes whose block is
+// shorter than the group length are zero-padded at the front, so their
+// recurrence stays at zero until their real block begins - the result is
+// identical to running that lane alone over its own block.
+//
+// Host builds with SSE2 / NEON use GCC vector extensions (one vector op per
+// step for all lanes). Other targets (Xtensa LX7) use four independent
+// scalar chains, which breaks the q0 → q1 → q2 dependency of the single-bin
+// loop and lets the FPU pipeline the multiply-adds.
+
+#ifndef GOERTZEL_KERNEL_H
+#define GOERTZEL_KERNEL_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define GOERTZEL_LANES 4              // Kernel below is written out for exactly 4 lanes
+#define GOERTZEL_WINDOW_Q15_SCALE 32767.0f
+
+// One group of GOERTZEL_LANES adjacent bins sharing a lockstep pass
+typedef struct {
+	uint16_t first_bin;       // Bin index of lane 0
+	uint16_t length;          // Longest block in the group (samples per pass)
+	const int16_t* window;    // length * GOERTZEL_LANES Q15 weights, interleaved
+} goertzel_bin_group;
+
+// Fill one group's interleaved window table.
+// lane_block_sizes / lane_window_steps: per-lane block size and step into window_lookup
+// window_lookup: 4096-entry window (0.0-1.0 float, or Q15 for the overload below)
+// Walks window_pos exactly like the single-bin loop so the weights match it sample-for-sample
+inline void goertzel_build_group_window(int16_t* table, uint16_t length,
+                                        const uint16_t* lane_block_sizes, const float* lane_window_steps,
+                                        const float* window_lookup) {
+	memset(table, 0, sizeof(int16_t) * length * GOERTZEL_LANES);
+
+	for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+		uint16_t block_size = lane_block_sizes[lane];
+		uint16_t pad = length - block_size;
+		float window_pos = 0.0f;
+
+		for (uint16_t i = 0; i < block_size; i++) {
+			float weight = window_lookup[uint32_t(window_pos)];
+			table[(pad + i) * GOERTZEL_LANES + lane] = (int16_t)(weight * GOERTZEL_WINDOW_Q15_SCALE + 0.5f);
+			window_pos += lane_window_steps[lane];
+		}
+	}
+}
+
+// Same, from a Q15 window_lookup (fixed-point analysis path)
+inline void goertzel_build_group_window(int16_t* table, uint16_t length,
+                                        const uint16_t* lane_block_sizes, const float* lane_window_steps,
+                                        const int16_t* window_lookup) {
+	memset(table, 0, sizeof(int16_t) * length * GOERTZEL_LANES);
+
+	for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+		uint16_t block_size = lane_block_sizes[lane];
+		uint16_t pad = length - block_size;
+		float window_pos = 0.0f;
+
+		for (uint16_t i = 0; i < block_size; i++) {
+			table[(pad + i) * GOERTZEL_LANES + lane] = window_lookup[uint32_t(window_pos)];
+			window_pos += lane_window_steps[lane];
+		}
+	}
+}
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+typedef float goertzel_f32x4 __attribute__((vector_size(16)));
+typedef int16_t goertzel_i16x4 __attribute__((vector_size(8)));
+#endif
+
+// Run all lanes over `length` samples.
+// Outputs the final Goertzel state per lane, scaled back from Q15 window units.
+inline void goertzel_run_group(const float* samples, const int16_t* window, uint16_t length,
+                               const float* coeff, float* q1_out, float* q2_out) {
+	const float unscale = 1.0f / GOERTZEL_WINDOW_Q15_SCALE;
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+	const goertzel_f32x4 c = { coeff[0], coeff[1], coeff[2], coeff[3] };
+	goertzel_f32x4 q1 = { 0.0f, 0.0f, 0.0f, 0.0f };
+	goertzel_f32x4 q2 = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+	for (uint16_t i = 0; i < length; i++) {
+		goertzel_i16x4 w16;
+		memcpy(&w16, &window[i * GOERTZEL_LANES], sizeof(w16));
+		goertzel_f32x4 w = __builtin_convertvector(w16, goertzel_f32x4);
+
+		goertzel_f32x4 q0 = c * q1 - q2 + w * samples[i];
+		q2 = q1;
+		q1 = q0;
+	}
+
+	for (uint16_t lane = 0; lane < GOERTZEL_LANES; lane++) {
+		q1_out[lane] = q1[lane] * unscale;
+		q2_out[lane] = q2[lane] * unscale;
+	}
+#else
+	const float c0 = coeff[0], c1 = coeff[1], c2 = coeff[2], c3 = coeff[3];
+	float q1_0 = 0.0f, q1_1 = 0.0f, q1_2 = 0.0f, q1_3 = 0.0f;
+	float q2_0 = 0.0f, q2_1 = 0.0f, q2_2 = 0.0f, q2_3 = 0.0f;
+
+	for (uint16_t i = 0; i < length; i++) {
+		const float s = samples[i];
+		const int16_t* w = &window[i * GOERTZEL_LANES];
+
+		float q0_0 = c0 * q1_0 - q2_0 + s * w[0];
+		float q0_1 = c1 * q1_1 - q2_1 + s * w[1];
+		float q0_2 = c2 * q1_2 - q2_2 + s * w[2];
+		float q0_3 = c3 * q1_3 - q2_3 + s * w[3];
+
+		q2_0 = q1_0; q1_0 = q0_0;
+		q2_1 = q1_1; q1_1 = q0_1;
+		q2_2 = q1_2; q1_2 = q0_2;
+		q2_3 = q1_3; q1_3 = q0_3;
+	}
+
+	q1_out[0] = q1_0 * unscale; q2_out[0] = q2_0 * unscale;
+	q1_out[1] = q1_1 * unscale; q2_out[1] = q2_1 * unscale;
+	q1_out[2] = q1_2 * unscale; q2_out[2] = q2_2 * unscale;
+	q1_out[3] = q1_3 * unscale; q2_out[3] = q2_3 * unscale;
+#endif
+}
+
+#endif  // GOERTZEL_KERNEL_H
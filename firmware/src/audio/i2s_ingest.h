@@ -0,0 +1,130 @@
+// -----------------------------------------------------------------
+// I2S Ingest - Raw I2S words to analysis samples in one pass
+//
+// The SPH0645 delivers 18-bit samples left-justified in 32-bit I2S slots.
+// Each chunk is converted, DC-blocked, scaled to -1.0 to 1.0 and stored
+// straight into the history ring (both mirrored positions), with an
+// optional Q15 copy for the fixed-point path and an optional int16 debug
+// capture, so no intermediate buffers are walked afterwards.
+//
+// DC blocking replaces the old hard-coded "+7000 ... -360" offset, which
+// matched one microphone's bias only. A one-pole high-pass
+//
+//     y[n] = x[n] - x[n-1] + R * y[n-1]
+//
+// (R = I2S_DC_BLOCK_POLE, corner ~13 Hz at 16 kHz, far below the 110 Hz
+// bottom bin) tracks whatever bias the part has. The filter is primed with
+// the first chunk's mean, so the bias does not ring through the analysis
+// (and the noise-profile probe) for the first second after boot.
+
+#ifndef I2S_INGEST_H
+#define I2S_INGEST_H
+
+#include <stdint.h>
+#include <string.h>
+#include "goertzel_fixed.h"
+
+#define I2S_SAMPLE_SHIFT 14              // 32-bit slot -> 18-bit sample
+#define I2S_SAMPLE_LIMIT 131072          // 18-bit full scale
+#define I2S_DC_BLOCK_POLE 0.995f
+
+typedef struct {
+	float x_prev;      // Previous input (18-bit units)
+	float y_prev;      // Previous output
+	bool primed;
+} dc_blocker;
+
+// Where one chunk goes; every pointer except `samples` may be NULL
+typedef struct {
+	float* samples;            // Float output (e.g. ring slot)
+	float* samples_mirror;     // Second store of a mirrored ring
+	int16_t* q15;              // Q15 output for the fixed-point ring
+	int16_t* q15_mirror;       // Required when q15 is set
+	int16_t* recording;        // Debug capture (Q15, saturating)
+} i2s_ingest_targets;
+
+// 18-bit sample from one I2S slot, clamped like the original converter
+inline int32_t i2s_slot_to_sample(int32_t slot) {
+	int32_t sample = slot >> I2S_SAMPLE_SHIFT;
+	if (sample > I2S_SAMPLE_LIMIT) sample = I2S_SAMPLE_LIMIT;
+	if (sample < -I2S_SAMPLE_LIMIT) sample = -I2S_SAMPLE_LIMIT;
+	return sample;
+}
+
+// Convert, DC-block, scale and store `count` I2S slots
+inline void i2s_ingest_chunk(const int32_t* raw, uint16_t count, dc_blocker& dc, const i2s_ingest_targets& out) {
+	if (!dc.primed) {
+		float mean = 0.0f;
+		for (uint16_t i = 0; i < count; i++) {
+			mean += (float)i2s_slot_to_sample(raw[i]);
+		}
+		dc.x_prev = mean / count;
+		dc.y_prev = 0.0f;
+		dc.primed = true;
+	}
+
+	const float scale = 1.0f / I2S_SAMPLE_LIMIT;
+	float x_prev = dc.x_prev;
+	float y_prev = dc.y_prev;
+
+	// Four outputs per step, each from y_prev directly (look-ahead form), so
+	// the recursion costs one multiply-add per four samples instead of one
+	// per sample
+	const float r1 = I2S_DC_BLOCK_POLE;
+	const float r2 = r1 * r1;
+	const float r3 = r2 * r1;
+	const float r4 = r2 * r2;
+	uint16_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const float x0 = (float)i2s_slot_to_sample(raw[i + 0]);
+		const float x1 = (float)i2s_slot_to_sample(raw[i + 1]);
+		const float x2 = (float)i2s_slot_to_sample(raw[i + 2]);
+		const float x3 = (float)i2s_slot_to_sample(raw[i + 3]);
+		const float d0 = x0 - x_prev;
+		const float d1 = x1 - x0;
+		const float d2 = x2 - x1;
+		const float d3 = x3 - x2;
+		const float y0 = d0 + r1 * y_prev;
+		const float y1 = d1 + r1 * d0 + r2 * y_prev;
+		const float y2 = d2 + r1 * d1 + r2 * d0 + r3 * y_prev;
+		const float y3 = d3 + r1 * d2 + r2 * d1 + r3 * d0 + r4 * y_prev;
+		out.samples[i + 0] = y0 * scale;
+		out.samples[i + 1] = y1 * scale;
+		out.samples[i + 2] = y2 * scale;
+		out.samples[i + 3] = y3 * scale;
+		x_prev = x3;
+		y_prev = y3;
+	}
+	for (; i < count; i++) {
+		const float x = (float)i2s_slot_to_sample(raw[i]);
+		const float y = x - x_prev + r1 * y_prev;
+		x_prev = x;
+		y_prev = y;
+		out.samples[i] = y * scale;
+	}
+
+	// Remaining stores stay out of the filter loop so it carries no branches
+	if (out.samples_mirror != NULL) {
+		memcpy(out.samples_mirror, out.samples, count * sizeof(float));
+	}
+	if (out.q15 != NULL) {
+		for (uint16_t i = 0; i < count; i++) {
+			out.q15[i] = goertzel_float_to_q15(out.samples[i]);
+		}
+		memcpy(out.q15_mirror, out.q15, count * sizeof(int16_t));
+	}
+	if (out.recording != NULL) {
+		if (out.q15 != NULL) {
+			memcpy(out.recording, out.q15, count * sizeof(int16_t));
+		} else {
+			for (uint16_t i = 0; i < count; i++) {
+				out.recording[i] = goertzel_float_to_q15(out.samples[i]);
+			}
+		}
+	}
+
+	dc.x_prev = x_prev;
+	dc.y_prev = y_prev;
+}
+
+#endif  // I2S_INGEST_H
@@ -0,0 +1,106 @@
+// -----------------------------------------------------------------
+// Latency Histogram - Mic-to-photon stage timings
+//
+// Each audio frame is tagged with the DMA completion time of its newest
+// chunk; the tag rides through analysis into the snapshot, and the render
+// task closes the loop at the RMT transmit start of the first LED frame
+// that shows it. Every stage lands in one of these histograms, so the API
+// can report p50/p95/p99 rather than just the last value or a maximum.
+//
+// Buckets are log-linear: exact below 8 us, then 8 per power of two, so a
+// percentile is reported to within 1/8 (the bucket's upper edge) from
+// microseconds up to about a second (longer values land in the top bucket).
+// 144 counters per histogram, no floating point on the recording side.
+//
+// One writer per histogram. Readers ask for a new window with
+// latency_histogram_request_clear(); the writer clears before its next
+// sample, so counts are never cleared under a writer in the other task.
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define LATENCY_SUB_BUCKETS 8            // Per power of two (power of two itself)
+#define LATENCY_SUB_BITS 3
+#define LATENCY_MAX_EXPONENT 20          // Top of the range: 2^20 us (~1 s)
+#define LATENCY_BUCKETS ((LATENCY_MAX_EXPONENT - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS)
+
+typedef struct {
+	uint32_t counts[LATENCY_BUCKETS];
+	volatile uint32_t total;
+	volatile uint32_t max_us;
+	volatile bool clear_requested;       // Set by a reader, honoured by the writer
+} latency_histogram;
+
+inline uint16_t latency_bucket(uint32_t us) {
+	if (us < LATENCY_SUB_BUCKETS) {
+		return (uint16_t)us;
+	}
+	if (us >= (1u << LATENCY_MAX_EXPONENT)) {
+		return LATENCY_BUCKETS - 1;
+	}
+	const uint32_t exponent = 31 - __builtin_clz(us);
+	const uint32_t sub = (us >> (exponent - LATENCY_SUB_BITS)) & (LATENCY_SUB_BUCKETS - 1);
+	return (uint16_t)((exponent - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS + sub);
+}
+
+// Largest value that lands in `bucket`
+inline uint32_t latency_bucket_upper_us(uint16_t bucket) {
+	if (bucket < LATENCY_SUB_BUCKETS) {
+		return bucket;
+	}
+	const uint32_t exponent = bucket / LATENCY_SUB_BUCKETS + LATENCY_SUB_BITS - 1;
+	const uint32_t sub = bucket % LATENCY_SUB_BUCKETS;
+	const uint32_t width = 1u << (exponent - LATENCY_SUB_BITS);
+	return ((LATENCY_SUB_BUCKETS + sub) << (exponent - LATENCY_SUB_BITS)) + width - 1;
+}
+
+inline void latency_histogram_clear(latency_histogram& histogram) {
+	memset(histogram.counts, 0, sizeof(histogram.counts));
+	histogram.total = 0;
+	histogram.max_us = 0;
+	histogram.clear_requested = false;
+}
+
+// Writer side
+inline void latency_histogram_add(latency_histogram& histogram, uint32_t us) {
+	if (histogram.clear_requested) {
+		latency_histogram_clear(histogram);
+	}
+	histogram.counts[latency_bucket(us)]++;
+	histogram.total = histogram.total + 1;
+	if (us > histogram.max_us) {
+		histogram.max_us = us;
+	}
+}
+
+// Reader side: start a new window at the writer's next sample
+inline void latency_histogram_request_clear(latency_histogram& histogram) {
+	histogram.clear_requested = true;
+}
+
+// Value at or below which `fraction` (0.0-1.0) of the samples fall; 0 if empty
+inline uint32_t latency_histogram_percentile(const latency_histogram& histogram, float fraction) {
+	const uint32_t total = histogram.total;
+	if (total == 0) {
+		return 0;
+	}
+	uint32_t rank = (uint32_t)(fraction * total + 0.999f);
+	if (rank < 1) {
+		rank = 1;
+	}
+
+	uint32_t seen = 0;
+	for (uint16_t bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+		seen += histogram.counts[bucket];
+		if (seen >= rank) {
+			const uint32_t upper = latency_bucket_upper_us(bucket);
+			return upper < histogram.max_us ? upper : histogram.max_us;
+		}
+	}
+	return histogram.max_us;
+}
+
+#endif  // LATENCY_HISTOGRAM_H
@@ -21,6 +21,9 @@
    typedef int esp_err_t;
 #  ifndef ESP_OK
 #    define ESP_OK 0
+#  endif
+#  ifndef ESP_ERR_TIMEOUT
+#    define ESP_ERR_TIMEOUT 0x107
 #  endif
    typedef int gpio_num_t;
 
@@ -30,12 +33,14 @@
    typedef struct {
        int id;
        i2s_role_t role;
+       uint32_t dma_desc_num;
+       uint32_t dma_frame_num;
    } i2s_chan_config_t;
 
 #  ifndef I2S_NUM_AUTO
 #    define I2S_NUM_AUTO (-1)
 #  endif
-#  define I2S_CHANNEL_DEFAULT_CONFIG(num, role) ((i2s_chan_config_t){ .id = (int)(num), .role = (role) })
+#  define I2S_CHANNEL_DEFAULT_CONFIG(num, role) ((i2s_chan_config_t){ .id = (int)(num), .role = (role), .dma_desc_num = 6, .dma_frame_num = 240 })
 
    typedef enum { I2S_DATA_BIT_WIDTH_32BIT = 32 } i2s_data_bit_width_t;
    typedef enum { I2S_SLOT_BIT_WIDTH_32BIT = 32 } i2s_slot_bit_width_t;
@@ -87,12 +92,29 @@
    esp_err_t i2s_channel_enable(i2s_chan_handle_t handle);
    esp_err_t i2s_channel_read(i2s_chan_handle_t handle, void* data, size_t size, size_t* bytes_read, uint32_t timeout_ticks);
 
+   typedef struct {
+       void*  data;
+       size_t size;
+   } i2s_event_data_t;
+   typedef bool (*i2s_isr_callback_t)(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx);
+   typedef struct {
+       i2s_isr_callback_t on_recv;
+       i2s_isr_callback_t on_recv_q_ovf;
+       i2s_isr_callback_t on_sent;
+       i2s_isr_callback_t on_send_q_ovf;
+   } i2s_event_callbacks_t;
+   esp_err_t i2s_channel_register_event_callback(i2s_chan_handle_t handle, const i2s_event_callbacks_t* callbacks, void* user_data);
+
 #  ifndef portMAX_DELAY
 #    define portMAX_DELAY 0xFFFFFFFFu
 #  endif
 #endif
 
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "../logging/logger.h"
+#include "i2s_ingest.h"
+#include "audio_cadence.h"
 #include <string.h>
 
 // Define I2S pins for SPH0645 microphone (standard I2S, NOT PDM)
@@ -111,8 +133,43 @@
 #define SAMPLE_HISTORY_LENGTH 4096
 
 // NOTE: sample_history is declared in goertzel.h - don't duplicate
-// float sample_history[SAMPLE_HISTORY_LENGTH];
-const float recip_scale = 1.0 / 131072.0; // max 18 bit signed value
+// (mirrored ring: new chunks are converted straight into it, see i2s_ingest.h)
+static_assert(SAMPLE_HISTORY_LENGTH % CHUNK_SIZE == 0, "chunks must not straddle the sample history wrap");
+static_assert(MAX_AUDIO_RECORDING_SAMPLES % CHUNK_SIZE == 0, "debug recording must hold whole chunks");
+
+// Microphone bias tracker (replaces the fixed per-unit offset)
+static dc_blocker mic_dc_blocker = {};
+
+// ============================================================================
+// EVENT-DRIVEN CADENCE (see audio_cadence.h)
+// ============================================================================
+// The I2S RX-done callback counts completed chunks and wakes the consuming
+// task, which then reads chunks that are already in the driver's queue
+#define AUDIO_CHUNK_BYTES (CHUNK_SIZE * sizeof(uint32_t))
+#define AUDIO_CHUNK_US (CHUNK_SIZE * 1000000UL / SAMPLE_RATE)
+#define AUDIO_CHUNKS_PER_FRAME 1         // Chunks ingested per analysis frame
+#define AUDIO_FRAME_US (AUDIO_CHUNKS_PER_FRAME * AUDIO_CHUNK_US)
+#define AUDIO_CHUNK_TIMEOUT_MS 50        // No chunk for this long: microphone stalled
+#define I2S_DMA_DESC_NUM 6
+
+static chunk_clock mic_clock = {};
+static TaskHandle_t mic_consumer_task = NULL;
+
+static bool IRAM_ATTR on_i2s_rx_done(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx) {
+	BaseType_t woken = pdFALSE;
+	if (chunk_clock_on_dma(mic_clock, (uint32_t)event->size, (uint32_t)esp_timer_get_time())) {
+		TaskHandle_t task = mic_consumer_task;
+		if (task != NULL) {
+			vTaskNotifyGiveFromISR(task, &woken);
+		}
+	}
+	return woken == pdTRUE;
+}
+
+static bool IRAM_ATTR on_i2s_rx_overflow(i2s_chan_handle_t handle, i2s_event_data_t* event, void* user_ctx) {
+	audio_cadence.dma_overruns = audio_cadence.dma_overruns + 1;
+	return false;
+}
 
 volatile bool waveform_locked = false;
 volatile bool waveform_sync_flag = false;
@@ -124,6 +181,8 @@ void init_i2s_microphone(){
 	// Requires: BCLK (clock input), LRCLK (word select), DIN (data output)
 
 	i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_AUTO, I2S_ROLE_MASTER);
+	chan_cfg.dma_desc_num = I2S_DMA_DESC_NUM;
+	chan_cfg.dma_frame_num = CHUNK_SIZE;       // Roughly one callback per chunk (the chunk clock copes either way)
 	i2s_new_channel(&chan_cfg, NULL, &rx_handle);
 
 	// Standard I2S RX configuration for SPH0645
@@ -158,70 +217,69 @@ void init_i2s_microphone(){
 	// Initialize as standard I2S RX mode
 	i2s_channel_init_std_mode(rx_handle, &std_cfg);
 
+	// Chunk notifications (callbacks must be registered before enabling)
+	chunk_clock_init(mic_clock, AUDIO_CHUNK_BYTES, AUDIO_CHUNK_US);
+	audio_cadence_reset_window(audio_cadence);
+	i2s_event_callbacks_t rx_callbacks = {};
+	rx_callbacks.on_recv = on_i2s_rx_done;
+	rx_callbacks.on_recv_q_ovf = on_i2s_rx_overflow;
+	i2s_channel_register_event_callback(rx_handle, &rx_callbacks, NULL);
+
 	// Start the RX channel
 	i2s_channel_enable(rx_handle);
 }
 
-void acquire_sample_chunk() {
-	profile_function([&]() {
-		// Buffer to hold audio samples
-		uint32_t new_samples_raw[CHUNK_SIZE];
-		float new_samples[CHUNK_SIZE];
-
-		// Read audio samples into int32_t buffer, but **only when emotiscope is active**
-		if( EMOTISCOPE_ACTIVE == true ){
-			size_t bytes_read = 0;
-			// I2S DMA naturally paces audio at 8ms intervals (16kHz, 128-chunk)
-			// portMAX_DELAY: block until next chunk is ready (~8ms typical)
-			// This is the synchronization mechanism - no explicit timing needed
-			// DMA continuously buffers, so portMAX_DELAY returns quickly with valid data
-
-			// DIAGNOSTIC: Measure I2S blocking time
-			uint32_t i2s_start_us = micros();
-			esp_err_t i2s_result = i2s_channel_read(rx_handle, new_samples_raw, CHUNK_SIZE*sizeof(uint32_t), &bytes_read, portMAX_DELAY);
-			uint32_t i2s_block_us = micros() - i2s_start_us;
-
-			// Log if blocking takes longer than expected 8ms
-			if (i2s_block_us > 10000) {  // More than 10ms is suspicious
-				LOG_DEBUG(TAG_I2S, "Block time: %lu us", i2s_block_us);
-			}
-
-			if (i2s_result != ESP_OK) {
-				// I2S error - fill with silence and continue
-				memset(new_samples_raw, 0, sizeof(uint32_t) * CHUNK_SIZE);
-				LOG_ERROR(TAG_I2S, "Read failed with code %d, block_us=%lu", i2s_result, i2s_block_us);
-			}
-		}
-		else{
-			// Audio inactive - fill with silence
-			memset(new_samples_raw, 0, sizeof(uint32_t) * CHUNK_SIZE);
-		}
+// Route chunk notifications to `task` (the one calling wait_for_sample_chunks)
+void attach_sample_chunk_consumer(TaskHandle_t task) {
+	mic_consumer_task = task;
+}
 
-		// Clip the sample value if it's too large, cast to floats
-		for (uint16_t i = 0; i < CHUNK_SIZE; i+=4) {
-			new_samples[i+0] = min(max((((int32_t)new_samples_raw[i+0]) >> 14) + 7000, (int32_t)-131072), (int32_t)131072) - 360;
-			new_samples[i+1] = min(max((((int32_t)new_samples_raw[i+1]) >> 14) + 7000, (int32_t)-131072), (int32_t)131072) - 360;
-			new_samples[i+2] = min(max((((int32_t)new_samples_raw[i+2]) >> 14) + 7000, (int32_t)-131072), (int32_t)131072) - 360;
-			new_samples[i+3] = min(max((((int32_t)new_samples_raw[i+3]) >> 14) + 7000, (int32_t)-131072), (int32_t)131072) - 360;
+// Sleep until at least `min_chunks` chunks are waiting or `timeout` passes
+// Returns the chunks waiting (0 on timeout) and when the newest one arrived
+uint32_t wait_for_sample_chunks(uint32_t min_chunks, TickType_t timeout, uint32_t* newest_us) {
+	uint32_t pending = chunk_clock_pending(mic_clock);
+	while (pending < min_chunks) {
+		if (ulTaskNotifyTake(pdTRUE, timeout) == 0) {
+			pending = chunk_clock_pending(mic_clock);
+			break;
 		}
+		pending = chunk_clock_pending(mic_clock);
+	}
+	*newest_us = mic_clock.chunk_time_us;
+	return pending;
+}
 
-		// Convert audio from "18-bit" float range to -1.0 to 1.0 range
-		dsps_mulc_f32(new_samples, new_samples, CHUNK_SIZE, recip_scale, 1, 1);
+// Mark chunks reported by wait_for_sample_chunks() as handled (read or lost)
+void consume_sample_chunks(uint32_t count) {
+	chunk_clock_take(mic_clock, count);
+}
 
-		// Add new chunk to audio history
+// Convert, DC-block and scale one chunk of raw I2S slots straight into the
+// history ring (and the debug capture)
+static void ingest_sample_chunk(const uint32_t* new_samples_raw) {
+	profile_function([&]() {
 		waveform_locked = true;
-		shift_and_copy_arrays(sample_history, SAMPLE_HISTORY_LENGTH, new_samples, CHUNK_SIZE);
+		const bool recording = audio_recording_live;
+
+		i2s_ingest_targets targets = {};
+		targets.recording = recording ? &audio_debug_recording[audio_recording_index] : NULL;
+#if AUDIO_FIXED_POINT
+		float new_samples[CHUNK_SIZE];
+		targets.samples = new_samples;
+		targets.q15 = mirrored_ring_slot(sample_history);
+		targets.q15_mirror = targets.q15 + SAMPLE_HISTORY_LENGTH;
+#else
+		float* new_samples = mirrored_ring_slot(sample_history);
+		targets.samples = new_samples;
+		targets.samples_mirror = new_samples + SAMPLE_HISTORY_LENGTH;
+#endif
+		i2s_ingest_chunk((const int32_t*)new_samples_raw, CHUNK_SIZE, mic_dc_blocker, targets);
+		mirrored_ring_advance(sample_history, CHUNK_SIZE);
+
+		feed_octave_histories(new_samples, CHUNK_SIZE);
 
 		// If debug recording was triggered
-		if(audio_recording_live == true){
-			int16_t out_samples[CHUNK_SIZE];
-			for(uint16_t i = 0; i < CHUNK_SIZE; i += 4){
-				out_samples[i+0] = new_samples[i+0] * 32767;
-				out_samples[i+1] = new_samples[i+1] * 32767;
-				out_samples[i+2] = new_samples[i+2] * 32767;
-				out_samples[i+3] = new_samples[i+3] * 32767;
-			}
-			memcpy(&audio_debug_recording[audio_recording_index], out_samples, sizeof(int16_t)*CHUNK_SIZE);
+		if(recording){
 			audio_recording_index += CHUNK_SIZE;
 			if(audio_recording_index >= MAX_AUDIO_RECORDING_SAMPLES){
 				audio_recording_index = 0;
@@ -236,3 +294,35 @@ void acquire_sample_chunk() {
 		waveform_sync_flag = true;
 	}, __func__);
 }
+
+// Read one chunk the RX callback has already reported and ingest it
+// Returns false if the driver no longer holds it (overrun) or the read failed
+bool acquire_sample_chunk() {
+	uint32_t new_samples_raw[CHUNK_SIZE];
+	size_t bytes_read = 0;
+
+	// Already queued, so this only copies out of the DMA buffers (no waiting)
+	esp_err_t i2s_result = i2s_channel_read(rx_handle, new_samples_raw, AUDIO_CHUNK_BYTES, &bytes_read, 0);
+	if (i2s_result != ESP_OK || bytes_read != AUDIO_CHUNK_BYTES) {
+		// Counted rather than logged: this runs once per chunk
+		if (i2s_result != ESP_OK && i2s_result != ESP_ERR_TIMEOUT) {
+			audio_cadence.read_errors = audio_cadence.read_errors + 1;
+		}
+		return false;
+	}
+
+	if (EMOTISCOPE_ACTIVE == false) {
+		// Audio inactive - keep draining the driver, analyse silence
+		memset(new_samples_raw, 0, sizeof(new_samples_raw));
+	}
+
+	ingest_sample_chunk(new_samples_raw);
+	return true;
+}
+
+// Silence in place of a chunk that never came (microphone stalled)
+void acquire_silent_chunk() {
+	uint32_t new_samples_raw[CHUNK_SIZE];
+	memset(new_samples_raw, 0, sizeof(new_samples_raw));
+	ingest_sample_chunk(new_samples_raw);
+}
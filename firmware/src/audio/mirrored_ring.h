@@ -0,0 +1,127 @@
+// -----------------------------------------------------------------
+// Mirrored Ring Buffer - O(chunk) history ingestion with contiguous reads
+//
+// Every sample is written twice, at [head] and [head + length], so the
+// newest `length` samples are always available as one contiguous span
+// starting at storage[head] (oldest → newest). Ingesting a chunk costs
+// 2 * chunk stores instead of a full-history memmove, and readers such
+// as the Goertzel loop keep indexing a plain float pointer.
+
+#ifndef MIRRORED_RING_H
+#define MIRRORED_RING_H
+
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+	float* storage;    // 2 * length floats (caller-owned, zero-initialized)
+	uint16_t length;   // Visible history length, must be a power of two
+	uint16_t head;     // Index of the oldest sample, 0 .. length - 1
+} mirrored_ring;
+
+// Append `count` samples (count <= length) to the ring, dropping the oldest
+inline void mirrored_ring_write(mirrored_ring& ring, const float* src, uint16_t count) {
+	const uint16_t length = ring.length;
+	const uint16_t head = ring.head;
+
+	uint16_t first = length - head;
+	if (first > count) {
+		first = count;
+	}
+
+	memcpy(&ring.storage[head], src, first * sizeof(float));
+	memcpy(&ring.storage[head + length], src, first * sizeof(float));
+
+	if (count > first) {
+		uint16_t rest = count - first;
+		memcpy(&ring.storage[0], src + first, rest * sizeof(float));
+		memcpy(&ring.storage[length], src + first, rest * sizeof(float));
+	}
+
+	ring.head = (head + count) & (length - 1);
+}
+
+// Append a single sample (used by low-rate histories such as novelty)
+inline void mirrored_ring_push(mirrored_ring& ring, float value) {
+	ring.storage[ring.head] = value;
+	ring.storage[ring.head + ring.length] = value;
+	ring.head = (ring.head + 1) & (ring.length - 1);
+}
+
+// In-place ingestion: producers that generate samples themselves store
+// them at slot[i] and slot[i + length], then advance. `count` must divide
+// `length` so a chunk never straddles the wrap.
+inline float* mirrored_ring_slot(mirrored_ring& ring) {
+	return &ring.storage[ring.head];
+}
+
+inline void mirrored_ring_advance(mirrored_ring& ring, uint16_t count) {
+	ring.head = (ring.head + count) & (ring.length - 1);
+}
+
+// Contiguous view of the full history: [0] = oldest, [length - 1] = newest
+inline const float* mirrored_ring_window(const mirrored_ring& ring) {
+	return &ring.storage[ring.head];
+}
+
+// Reset history to silence
+inline void mirrored_ring_clear(mirrored_ring& ring) {
+	memset(ring.storage, 0, sizeof(float) * ring.length * 2);
+	ring.head = 0;
+}
+
+// -----------------------------------------------------------------
+// Q15 variant for the fixed-point analysis path (AUDIO_FIXED_POINT):
+// same layout and semantics, half the memory
+
+typedef struct {
+	int16_t* storage;  // 2 * length Q15 samples (caller-owned, zero-initialized)
+	uint16_t length;   // Visible history length, must be a power of two
+	uint16_t head;     // Index of the oldest sample, 0 .. length - 1
+} mirrored_ring_q15;
+
+inline void mirrored_ring_write(mirrored_ring_q15& ring, const int16_t* src, uint16_t count) {
+	const uint16_t length = ring.length;
+	const uint16_t head = ring.head;
+
+	uint16_t first = length - head;
+	if (first > count) {
+		first = count;
+	}
+
+	memcpy(&ring.storage[head], src, first * sizeof(int16_t));
+	memcpy(&ring.storage[head + length], src, first * sizeof(int16_t));
+
+	if (count > first) {
+		uint16_t rest = count - first;
+		memcpy(&ring.storage[0], src + first, rest * sizeof(int16_t));
+		memcpy(&ring.storage[length], src + first, rest * sizeof(int16_t));
+	}
+
+	ring.head = (head + count) & (length - 1);
+}
+
+inline void mirrored_ring_push(mirrored_ring_q15& ring, int16_t value) {
+	ring.storage[ring.head] = value;
+	ring.storage[ring.head + ring.length] = value;
+	ring.head = (ring.head + 1) & (ring.length - 1);
+}
+
+inline int16_t* mirrored_ring_slot(mirrored_ring_q15& ring) {
+	return &ring.storage[ring.head];
+}
+
+inline void mirrored_ring_advance(mirrored_ring_q15& ring, uint16_t count) {
+	ring.head = (ring.head + count) & (ring.length - 1);
+}
+
+inline const int16_t* mirrored_ring_window(const mirrored_ring_q15& ring) {
+	return &ring.storage[ring.head];
+}
+
+inline void mirrored_ring_clear(mirrored_ring_q15& ring) {
+	memset(ring.storage, 0, sizeof(int16_t) * ring.length * 2);
+	ring.head = 0;
+}
+
+#endif  // MIRRORED_RING_H
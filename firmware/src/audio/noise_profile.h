@@ -0,0 +1,73 @@
+// -----------------------------------------------------------------
+// Noise Profile - Persisted noise floor, keyed to the analysis setup
+//
+// The noise floor subtracted from every bin (noise_spectrum) takes
+// NOISE_CALIBRATION_FRAMES frames of quiet to learn. It is stored once
+// calibrated, together with a hash of everything that changes the meaning
+// of a raw bin magnitude (bin layout, block sizes, decimation stages,
+// precision). The microphone gain is not part of it: gain is applied after
+// the subtraction. At boot a matching profile is loaded straight away and
+// checked against a short probe of the live floor.
+//
+// Boot never calibrates on its own: whatever is playing at power-on would
+// become the floor and be subtracted from then on. Without a matching
+// profile nothing is subtracted until a calibration is started explicitly,
+// and a probe that shows drift is only reported: noise_profile_stale in
+// GET /api/device/performance, for the UI to prompt a recalibration.
+//
+// The probe compares mean bin levels rather than the floor itself: the
+// floor is a running maximum, which grows with the number of frames seen,
+// so 32 probe frames could never reproduce a 512-frame floor. A mean over
+// 32 frames of noise is within ~20% per bin and much closer on aggregate.
+
+#ifndef NOISE_PROFILE_H
+#define NOISE_PROFILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#define NOISE_PROFILE_FORMAT 2           // Bump when the stored layout changes
+#define NOISE_PROFILE_BINS 64
+#define NOISE_PROFILE_HASH_SEED 2166136261u
+
+// Stored blob
+typedef struct {
+	uint16_t format;                         // NOISE_PROFILE_FORMAT
+	uint32_t config_hash;                    // noise_profile_hash_* over the analysis setup
+	float spectrum[NOISE_PROFILE_BINS];      // noise_spectrum
+	float level[NOISE_PROFILE_BINS];         // Mean raw magnitude over the calibration
+} noise_profile;
+
+// FNV-1a over raw bytes; chain calls starting from NOISE_PROFILE_HASH_SEED
+inline uint32_t noise_profile_hash_bytes(uint32_t hash, const void* data, size_t length) {
+	const uint8_t* bytes = (const uint8_t*)data;
+	for (size_t i = 0; i < length; i++) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+// Profile usable for this build and setup
+inline bool noise_profile_matches(const noise_profile& profile, uint32_t config_hash) {
+	return profile.format == NOISE_PROFILE_FORMAT
+	    && profile.config_hash == config_hash;
+}
+
+// Relative L1 distance between probed mean levels and the stored ones
+// 0 = identical; 1 = off by the stored total level
+inline float noise_profile_drift(const float* stored, const float* probed, uint16_t bins) {
+	float difference = 0.0f;
+	float total = 0.0f;
+	for (uint16_t i = 0; i < bins; i++) {
+		difference += fabsf(probed[i] - stored[i]);
+		total += stored[i];
+	}
+	if (total <= 0.0f) {
+		return difference > 0.0f ? INFINITY : 0.0f;
+	}
+	return difference / total;
+}
+
+#endif  // NOISE_PROFILE_H
@@ -0,0 +1,72 @@
+// -----------------------------------------------------------------
+// Octave Decimator - Half-band 2:1 decimation for the low Goertzel bins
+//
+// Each stage halves the sample rate (16k → 8k → 4k → 2k) with a 39-tap
+// Kaiser half-band FIR. Every other tap of a half-band filter is zero, so a
+// stage costs 11 multiply-adds per output sample. Passband is flat to
+// 0.4 x output rate (±0.01 dB); anything that would fold back below that
+// edge is attenuated by ~59 dB.
+//
+// A bass bin analysed at 2 kHz needs 1/8 of the samples it needs at 16 kHz
+// for the same block duration, so frequency resolution is unchanged while
+// the Goertzel work shrinks by the decimation factor.
+
+#ifndef OCTAVE_DECIMATOR_H
+#define OCTAVE_DECIMATOR_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define HALFBAND_TAPS 39
+#define HALFBAND_DELAY ((HALFBAND_TAPS - 1) / 2)   // Group delay in input samples
+#define HALFBAND_MAX_CHUNK 128                     // Largest input block per call (CHUNK_SIZE)
+#define OCTAVE_PASSBAND 0.4f                       // Usable band as a fraction of a stage's rate
+
+// Non-zero odd-offset taps (offset 1, 3, ... 19), mirrored around the centre tap
+static const float halfband_coeffs[(HALFBAND_DELAY + 1) / 2] = {
+	3.160737958e-01f, -9.950978328e-02f, 5.316815800e-02f, -3.176454240e-02f, 1.928209826e-02f,
+	-1.136620598e-02f, 6.281036832e-03f, -3.116508958e-03f, 1.282312824e-03f, -3.425909926e-04f
+};
+static const float halfband_center = 5.000244599e-01f;
+
+// One 2:1 stage; holds the last HALFBAND_TAPS - 1 input samples
+typedef struct {
+	float delay[HALFBAND_TAPS - 1];
+} halfband_decimator;
+
+// Filter and decimate `count` input samples (even, <= HALFBAND_MAX_CHUNK) into count / 2 outputs
+inline void halfband_decimate(halfband_decimator& stage, const float* in, uint16_t count, float* out) {
+	float x[HALFBAND_TAPS - 1 + HALFBAND_MAX_CHUNK];
+	memcpy(x, stage.delay, sizeof(stage.delay));
+	memcpy(&x[HALFBAND_TAPS - 1], in, count * sizeof(float));
+
+	for (uint16_t j = 0; j < count / 2; j++) {
+		const float* center = &x[2 * j + 1 + HALFBAND_DELAY];
+		float acc = halfband_center * center[0];
+		for (uint16_t k = 0; k < (HALFBAND_DELAY + 1) / 2; k++) {
+			uint16_t offset = 2 * k + 1;
+			acc += halfband_coeffs[k] * (center[-offset] + center[offset]);
+		}
+		out[j] = acc;
+	}
+
+	memcpy(stage.delay, &x[count], sizeof(stage.delay));
+}
+
+// Lowest-rate stage that can still analyse a bin group:
+// its highest frequency must sit inside the stage passband, and the longest
+// block (at that stage's rate) must fit the stage history
+// Stage 0 is the full-rate input; stage s runs at sample_rate >> s
+inline uint8_t octave_select_stage(float top_freq_hz, float min_bandwidth_hz, uint32_t sample_rate,
+                                   uint8_t num_stages, uint16_t decimated_history_length) {
+	for (uint8_t s = num_stages - 1; s > 0; s--) {
+		float stage_rate = (float)(sample_rate >> s);
+		if (top_freq_hz <= OCTAVE_PASSBAND * stage_rate &&
+		    stage_rate / min_bandwidth_hz < (float)(decimated_history_length - 1)) {
+			return s;
+		}
+	}
+	return 0;
+}
+
+#endif  // OCTAVE_DECIMATOR_H
@@ -0,0 +1,179 @@
+// -----------------------------------------------------------------
+// Pitch Tracker - Fundamental frequency by McLeod's normalized SDF (MPM)
+//
+// The normalized square difference function
+//
+//     n(tau) = 2 r(tau) / m(tau)
+//     r(tau) = sum x[j] x[j + tau]                  (autocorrelation)
+//     m(tau) = sum x[j]^2 + x[j + tau]^2           (same span, j < W - tau)
+//
+// is 1.0 at lags where the window repeats itself exactly and falls
+// toward 0 (or below) elsewhere. The pitch period is the first "key
+// maximum" (highest point of a positive lobe) within PITCH_KEY_THRESHOLD
+// of the highest one, refined by a parabola through its neighbours; the
+// peak value is the clarity, how periodic the frame is.
+//
+// r(tau) comes from the FFT rather than the O(W^2) direct sum: the window
+// is zero-padded to twice its length (linear, not circular, correlation),
+// transformed, squared in magnitude and transformed again. The power
+// spectrum is real and even, so the second forward FFT equals N times the
+// inverse and the shared radix-2 cqt_fft() serves for both. m(tau) is a
+// running sum, one subtraction pair per lag.
+//
+// The tracker reads the 8 kHz octave stage (see goertzel.h): 256 samples
+// (32 ms) hold two periods of the lowest pitch, 62.5 Hz at lag W / 2. The
+// 4 kHz stage would halve the window cost but its 1.6 kHz passband leaves
+// the NSDF lobes of notes above ~400 Hz only a few lags wide, too narrow
+// for the parabola, and the tracker then locks an octave low.
+
+#ifndef PITCH_TRACKER_H
+#define PITCH_TRACKER_H
+
+#include <stdint.h>
+#include <math.h>
+#include "cqt_kernel.h"
+
+#define PITCH_WINDOW 256                 // Samples per estimate
+#define PITCH_FFT_SIZE (2 * PITCH_WINDOW)
+#define PITCH_MAX_LAG (PITCH_WINDOW / 2) // Longest period considered
+#define PITCH_MIN_LAG 4                  // Shortest period (2 kHz at 8 kHz)
+#define PITCH_KEY_THRESHOLD 0.9f         // First key maximum within this fraction of the highest
+#define PITCH_CLARITY_MIN 0.6f           // Below: no clear pitch, f0 reported as 0
+#define PITCH_SILENCE_POWER 1e-8f        // Mean square below this: silence (about -80 dBFS)
+
+typedef struct {
+	cqt_complex twiddles[PITCH_FFT_SIZE / 2];
+	cqt_complex frame[PITCH_FFT_SIZE];
+	float nsdf[PITCH_MAX_LAG + 2];
+} pitch_tracker;
+
+typedef struct {
+	float f0_hz;                         // 0 when unpitched
+	float clarity;                       // NSDF peak, 0.0-1.0
+	float midi_note;                     // 69.0 = A4, fractional part in semitones; 0 when unpitched
+} pitch_estimate;
+
+inline void pitch_tracker_init(pitch_tracker& tracker) {
+	cqt_fft_init_twiddles(tracker.twiddles, PITCH_FFT_SIZE);
+}
+
+// n(tau) for tau = 0 .. PITCH_MAX_LAG + 1 into tracker.nsdf; returns false for silence
+inline bool pitch_nsdf(pitch_tracker& tracker, const float* window) {
+	float mean = 0.0f;
+	for (uint16_t j = 0; j < PITCH_WINDOW; j++) {
+		mean += window[j];
+	}
+	mean /= PITCH_WINDOW;
+
+	cqt_complex* frame = tracker.frame;
+	float energy = 0.0f;
+	for (uint16_t j = 0; j < PITCH_WINDOW; j++) {
+		frame[j].re = window[j] - mean;
+		frame[j].im = 0.0f;
+		energy += frame[j].re * frame[j].re;
+	}
+	if (energy < PITCH_SILENCE_POWER * PITCH_WINDOW) {
+		return false;
+	}
+	for (uint16_t j = PITCH_WINDOW; j < PITCH_FFT_SIZE; j++) {
+		frame[j].re = 0.0f;
+		frame[j].im = 0.0f;
+	}
+
+	// Autocorrelation: |X|^2, transformed again (real, even: forward = N x inverse)
+	cqt_fft(frame, PITCH_FFT_SIZE, tracker.twiddles);
+	for (uint16_t k = 0; k < PITCH_FFT_SIZE; k++) {
+		frame[k].re = frame[k].re * frame[k].re + frame[k].im * frame[k].im;
+		frame[k].im = 0.0f;
+	}
+	cqt_fft(frame, PITCH_FFT_SIZE, tracker.twiddles);
+
+	// frame[tau].re = N r(tau); m(tau) drops the two samples leaving the span
+	float m = 2.0f * energy;
+	for (uint16_t tau = 0; tau <= PITCH_MAX_LAG + 1; tau++) {
+		if (tau > 0) {
+			const float a = window[tau - 1] - mean;
+			const float b = window[PITCH_WINDOW - tau] - mean;
+			m -= a * a + b * b;
+		}
+		const float r = frame[tau].re / PITCH_FFT_SIZE;
+		tracker.nsdf[tau] = m > 0.0f ? 2.0f * r / m : 0.0f;
+	}
+	return true;
+}
+
+// Parabola through nsdf[lag - 1 .. lag + 1]: sub-sample lag and peak height
+inline void pitch_refine_peak(const float* nsdf, uint16_t lag, float& period, float& peak) {
+	const float left = nsdf[lag - 1];
+	const float center = nsdf[lag];
+	const float right = nsdf[lag + 1];
+	const float curvature = left - 2.0f * center + right;
+	period = lag;
+	peak = center;
+	if (curvature < 0.0f) {
+		const float offset = 0.5f * (left - right) / curvature;
+		period += offset;
+		peak = center - 0.25f * (left - right) * offset;
+	}
+}
+
+// Period from the NSDF (MPM peak picking); `sample_rate` of the analysed window
+inline pitch_estimate pitch_pick(const float* nsdf, float sample_rate) {
+	pitch_estimate estimate = {0.0f, 0.0f, 0.0f};
+
+	// Key maxima: the highest point of each positive lobe after the first negative dip.
+	// Heights are compared after interpolation: at short lags (high notes) the
+	// integer-lag samples of a narrow lobe can sit well below its true peak.
+	float key_periods[PITCH_MAX_LAG / 2 + 1];
+	float key_peaks[PITCH_MAX_LAG / 2 + 1];
+	uint16_t keys = 0;
+	float highest = 0.0f;
+	uint16_t tau = 1;
+	while (tau <= PITCH_MAX_LAG && nsdf[tau] > 0.0f) {
+		tau++;
+	}
+	while (tau <= PITCH_MAX_LAG) {
+		while (tau <= PITCH_MAX_LAG && nsdf[tau] <= 0.0f) {
+			tau++;
+		}
+		uint16_t best = 0;
+		while (tau <= PITCH_MAX_LAG && nsdf[tau] > 0.0f) {
+			if (best == 0 || nsdf[tau] > nsdf[best]) {
+				best = tau;
+			}
+			tau++;
+		}
+		// A lobe still rising at the last lag has no maximum inside the range
+		if (best != 0 && best < PITCH_MAX_LAG && keys < PITCH_MAX_LAG / 2 + 1) {
+			pitch_refine_peak(nsdf, best, key_periods[keys], key_peaks[keys]);
+			if (key_peaks[keys] > highest) {
+				highest = key_peaks[keys];
+			}
+			keys++;
+		}
+	}
+
+	for (uint16_t k = 0; k < keys; k++) {
+		if (key_peaks[k] < PITCH_KEY_THRESHOLD * highest) {
+			continue;
+		}
+		estimate.clarity = key_peaks[k] > 1.0f ? 1.0f : key_peaks[k];
+		if (estimate.clarity >= PITCH_CLARITY_MIN && key_periods[k] >= PITCH_MIN_LAG) {
+			estimate.f0_hz = sample_rate / key_periods[k];
+			estimate.midi_note = 69.0f + 12.0f * log2f(estimate.f0_hz / 440.0f);
+		}
+		break;
+	}
+	return estimate;
+}
+
+// One estimate from the newest PITCH_WINDOW samples
+inline pitch_estimate pitch_track(pitch_tracker& tracker, const float* window, float sample_rate) {
+	if (!pitch_nsdf(tracker, window)) {
+		pitch_estimate silent = {0.0f, 0.0f, 0.0f};
+		return silent;
+	}
+	return pitch_pick(tracker.nsdf, sample_rate);
+}
+
+#endif  // PITCH_TRACKER_H
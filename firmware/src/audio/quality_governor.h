@@ -0,0 +1,121 @@
+// -----------------------------------------------------------------
+// Quality Governor - Step audio analysis quality with Core 1 load
+//
+// The audio task must finish each frame before the next frame's chunks are
+// due; when it does not (Goertzel work, tempo readouts and network handling
+// all compete for Core 1), the I2S backlog grows and so does latency. The
+// governor watches each frame's slack against that deadline and trades
+// analysis quality for time:
+//
+//   level 0  full quality
+//   level 1  tempo bins read out every 4 frames instead of 2
+//   level 2  + bin schedule without overlap (long bins update once their
+//            whole window is new: fewer Goertzel bins per frame), secondary
+//            passes (pitch tracker, per-bin beat values, CQT linear
+//            spectrum) on alternate frames
+//   level 3  + tempo readouts every 8 frames, every bin at most every other
+//            frame (the short, every-frame bins ramp between updates too)
+//
+// A late frame (backlog) or an overrun steps down at once; a run of frames
+// with little headroom steps down too. After a step down the next one waits
+// a few frames for the cheaper level to show in the slack. Stepping up needs a long run of
+// comfortable slack, and that run doubles every time a step up has to be
+// taken back, so a load that only fits at the lower level does not make
+// the governor oscillate.
+
+#ifndef QUALITY_GOVERNOR_H
+#define QUALITY_GOVERNOR_H
+
+#include <stdint.h>
+
+#define QUALITY_LEVELS 4
+#define QUALITY_TIGHT_FRAMES 32          // Frames under the headroom floor before stepping down
+#define QUALITY_SETTLE_FRAMES 16         // Frames after a step down before another one
+#define QUALITY_CALM_FRAMES 512          // Comfortable frames before stepping up (~4 s)
+#define QUALITY_CALM_FRAMES_MAX 8192     // Cap on the backed-off step-up wait (~65 s)
+
+// What each level runs
+typedef struct {
+	uint8_t tempo_readout_interval;      // Frames between tempo bin readouts (see tempo.h)
+	uint8_t refresh_interval;            // Frames between secondary passes
+	uint8_t bin_overlap;                 // Bin schedule overlap (see bin_scheduler.h)
+	uint8_t bin_min_period;              // Frames between a bin's updates, at least
+} audio_quality;
+
+inline audio_quality audio_quality_for_level(uint8_t level) {
+	static const audio_quality levels[QUALITY_LEVELS] = {
+		{2, 1, 2, 1},
+		{4, 1, 2, 1},
+		{4, 2, 1, 1},
+		{8, 2, 1, 2},
+	};
+	return levels[level < QUALITY_LEVELS ? level : QUALITY_LEVELS - 1];
+}
+
+typedef struct {
+	volatile uint8_t level;              // 0 = full quality
+	uint16_t tight_frames;               // Consecutive frames under the headroom floor
+	uint16_t calm_frames;                // Consecutive comfortable frames
+	uint16_t calm_needed;                // Current step-up wait (backs off)
+	uint16_t since_change;               // Frames since the last level change
+	bool stepped_up;                     // Last change was a step up
+	volatile uint32_t step_downs;
+	volatile uint32_t step_ups;
+} quality_governor;
+
+inline void quality_governor_init(quality_governor& governor) {
+	governor.level = 0;
+	governor.tight_frames = 0;
+	governor.calm_frames = 0;
+	governor.calm_needed = QUALITY_CALM_FRAMES;
+	governor.since_change = QUALITY_SETTLE_FRAMES;
+	governor.stepped_up = false;
+	governor.step_downs = 0;
+	governor.step_ups = 0;
+}
+
+// One frame done with `slack_us` left before the next one is due (< 0:
+// overrun); `late` if it found a backlog. Returns true if the level changed.
+inline bool quality_governor_frame(quality_governor& governor, int32_t slack_us, bool late, uint32_t frame_period_us) {
+	if (governor.since_change < UINT16_MAX) {
+		governor.since_change++;
+	}
+
+	const int32_t floor_us = (int32_t)(frame_period_us / 8);     // Headroom kept for jitter
+	const int32_t calm_us = (int32_t)(frame_period_us / 2);
+	governor.tight_frames = slack_us < floor_us ? governor.tight_frames + 1 : 0;
+	governor.calm_frames = slack_us > calm_us && !late ? governor.calm_frames + 1 : 0;
+
+	const bool overloaded = late || slack_us < 0 || governor.tight_frames >= QUALITY_TIGHT_FRAMES;
+	const bool settled = governor.stepped_up || governor.since_change >= QUALITY_SETTLE_FRAMES;
+	if (overloaded && governor.level < QUALITY_LEVELS - 1 && settled) {
+		// A step up that did not hold: wait longer before the next one
+		if (governor.stepped_up && governor.since_change < governor.calm_needed) {
+			governor.calm_needed = governor.calm_needed * 2 < QUALITY_CALM_FRAMES_MAX ? governor.calm_needed * 2 : QUALITY_CALM_FRAMES_MAX;
+		}
+		governor.level = governor.level + 1;
+		governor.step_downs = governor.step_downs + 1;
+		governor.stepped_up = false;
+		governor.since_change = 0;
+		governor.tight_frames = 0;
+		governor.calm_frames = 0;
+		return true;
+	}
+
+	if (governor.level > 0 && governor.calm_frames >= governor.calm_needed) {
+		governor.level = governor.level - 1;
+		governor.step_ups = governor.step_ups + 1;
+		governor.stepped_up = true;
+		governor.since_change = 0;
+		governor.calm_frames = 0;
+		return true;
+	}
+
+	// Held the level a long time: forget earlier back-off
+	if (governor.since_change >= QUALITY_CALM_FRAMES_MAX && governor.calm_needed > QUALITY_CALM_FRAMES) {
+		governor.calm_needed = QUALITY_CALM_FRAMES;
+	}
+	return false;
+}
+
+#endif  // QUALITY_GOVERNOR_H
@@ -0,0 +1,36 @@
+// -----------------------------------------------------------------
+// Running Mean - O(1) per-bin moving averages over a frame ring
+//
+// The spectrum smoothing stages average each bin over the last few frames.
+// Instead of re-summing the whole ring for every bin on every frame, a sum
+// per bin is kept in step with the ring: add the new value, subtract the
+// one it overwrites.
+//
+// Float add/subtract pairs do not cancel exactly, so the sums are rebuilt
+// from the ring once per lap (running_mean_resync), which keeps them within
+// a few ulps of a fresh sum indefinitely.
+
+#ifndef RUNNING_MEAN_H
+#define RUNNING_MEAN_H
+
+#include <stdint.h>
+
+// Overwrite one ring slot and keep its bin's sum in step; returns the window mean
+inline float running_mean_replace(float& sum, float& slot, float value, uint8_t depth) {
+	sum += value - slot;
+	slot = value;
+	return sum / depth;
+}
+
+// Exact sums of a depth x bins ring (row-major, one row per frame)
+inline void running_mean_resync(const float* ring, uint8_t depth, uint16_t bins, float* sums) {
+	for (uint16_t bin = 0; bin < bins; bin++) {
+		float sum = 0.0f;
+		for (uint8_t row = 0; row < depth; row++) {
+			sum += ring[row * bins + bin];
+		}
+		sums[bin] = sum;
+	}
+}
+
+#endif  // RUNNING_MEAN_H
@@ -0,0 +1,57 @@
+// -----------------------------------------------------------------
+// Sliding Max - Running maximum of a circular history
+//
+// A monotonic deque of history slots whose values strictly decrease from
+// front to back: the front is the maximum of the window. Each new sample
+// pops the entries it dominates off the back, and the sample leaving the
+// window pops off the front if it is still there. Every slot enters and
+// leaves once, so a push is O(1) amortized instead of rescanning the
+// whole history for its max every frame.
+//
+// The deque stores slots, not values: the history ring still holds every
+// value in the window, so the deque costs 2 bytes per entry.
+
+#ifndef SLIDING_MAX_H
+#define SLIDING_MAX_H
+
+#include <stdint.h>
+
+typedef struct {
+	uint16_t* slots;   // `length` entries (caller-owned)
+	uint16_t length;   // History length, must be a power of two
+	uint16_t front;    // Deque position of the maximum
+	uint16_t count;    // Entries in the deque
+} sliding_max;
+
+inline void sliding_max_clear(sliding_max& deque) {
+	deque.front = 0;
+	deque.count = 0;
+}
+
+// history[slot] has just been overwritten with the newest sample (the
+// slot previously held the oldest one)
+inline void sliding_max_push(sliding_max& deque, const float* history, uint16_t slot) {
+	const uint16_t mask = deque.length - 1;
+
+	// The oldest sample left the window; if it was in the deque it was the front
+	if (deque.count > 0 && deque.slots[deque.front] == slot) {
+		deque.front = (deque.front + 1) & mask;
+		deque.count--;
+	}
+
+	const float value = history[slot];
+	while (deque.count > 0 && history[deque.slots[(deque.front + deque.count - 1) & mask]] <= value) {
+		deque.count--;
+	}
+
+	deque.slots[(deque.front + deque.count) & mask] = slot;
+	deque.count++;
+}
+
+// Maximum over the samples pushed since the last clear that are still in
+// the window (0 before the first push)
+inline float sliding_max_value(const sliding_max& deque, const float* history) {
+	return deque.count > 0 ? history[deque.slots[deque.front]] : 0.0f;
+}
+
+#endif  // SLIDING_MAX_H
@@ -13,6 +13,10 @@
 
 #include "tempo.h"
 #include "goertzel.h"
+#include "tempo_bank.h"
+#include "sliding_max.h"
+#include "beat_clock.h"
+#include "../logging/logger.h"
 #include <cmath>
 #include <Arduino.h>
 
@@ -24,13 +28,28 @@
 float tempi_bpm_values_hz[NUM_TEMPI];
 float tempo_confidence = 0.0f;
 float MAX_TEMPO_RANGE = 1.0f;
+uint32_t tempo_phase_time_us = 0;
+float novelty_period_us = NOVELTY_PERIOD_US;   // Nominal audio frame, refined as frames arrive
+uint8_t tempo_readout_interval = TEMPO_READOUT_INTERVAL;
+uint8_t tempo_refresh_interval = 1;
 
 // Tempo tracking curves
 float novelty_curve[NOVELTY_HISTORY_LENGTH];
-float novelty_curve_normalized[NOVELTY_HISTORY_LENGTH];
 float vu_curve[NOVELTY_HISTORY_LENGTH];
+uint16_t novelty_head = 0;
+float novelty_scale = 1.0f;
 float tempi_power_sum = 0.0f;
 
+// Running max of novelty_curve (see sliding_max.h)
+static uint16_t novelty_max_slots[NOVELTY_HISTORY_LENGTH];
+static sliding_max novelty_max = { novelty_max_slots, NOVELTY_HISTORY_LENGTH, 0, 0 };
+
+// Sliding DFT of novelty_curve for every tempo bin (see tempo_bank.h)
+static tempo_bank tempo_sdft;
+
+// Beat/onset events (see beat_events.h)
+beat_event_queue audio_beat_events = {};
+
 // Silence detection
 bool silence_detected = true;
 float silence_level = 1.0f;
@@ -119,46 +138,39 @@ void init_tempo_goertzel_constants() {
 			tempi[i].block_size = NOVELTY_HISTORY_LENGTH;
 		}
 
-		// Initialize Goertzel filter coefficients
-		float k = (int)(0.5 + ((tempi[i].block_size * tempi[i].target_tempo_hz) / NOVELTY_LOG_HZ));
-		float w = (2.0 * PI * k) / tempi[i].block_size;
-		float cosine = cos(w);
-		tempi[i].coeff = 2.0 * cosine;
+		// DFT bin the Goertzel coefficient rounds to
+		tempi[i].dft_bin = (int)(0.5 + ((tempi[i].block_size * tempi[i].target_tempo_hz) / NOVELTY_LOG_HZ));
 
-		tempi[i].window_step = 4096.0 / tempi[i].block_size;
+		// The bank slides one window over the whole history for every bin
+		if (tempi[i].block_size != NOVELTY_HISTORY_LENGTH) {
+			LOG_WARN(TAG_TEMPO, "Tempo bin %u block %u shorter than the novelty history, using the full history", i, tempi[i].block_size);
+		}
 	}
-}
-
-float calculate_magnitude_of_tempo(uint16_t tempo_bin) {
-	uint16_t block_size = tempi[tempo_bin].block_size;
-
-	float q1 = 0;
-	float q2 = 0;
-
-	float window_pos = 0.0;
 
-	// Apply Goertzel filter to novelty curve with windowing
-	for (uint16_t i = 0; i < block_size; i++) {
-		float sample_novelty = novelty_curve_normalized[((NOVELTY_HISTORY_LENGTH - 1) - block_size) + i];
-		float sample_vu = vu_curve[((NOVELTY_HISTORY_LENGTH - 1) - block_size) + i];
-		float sample = (sample_novelty + sample_vu) / 2.0;
-
-		float q0 = tempi[tempo_bin].coeff * q1 - q2 + (sample_novelty * window_lookup[uint32_t(window_pos)]);
-		q2 = q1;
-		q1 = q0;
+	// Time-domain window as the Goertzel walked it (window_step = 4096 / block size)
+	static float tempo_window[NOVELTY_HISTORY_LENGTH];
+	for (uint16_t m = 0; m < NOVELTY_HISTORY_LENGTH; m++) {
+		const window_weight_t weight = window_lookup[(uint32_t)(m * (4096.0f / NOVELTY_HISTORY_LENGTH))];
+#if AUDIO_FIXED_POINT
+		tempo_window[m] = weight / 32768.0f;
+#else
+		tempo_window[m] = weight;
+#endif
+	}
 
-		window_pos += (tempi[tempo_bin].window_step);
+	if (!tempo_bank_init(tempo_sdft, NOVELTY_HISTORY_LENGTH, tempi[0].dft_bin, tempi[NUM_TEMPI - 1].dft_bin,
+	                     tempo_window, TEMPO_BANK_DAMPING)) {
+		LOG_ERROR(TAG_TEMPO, "Tempo bins %u..%u do not fit the sliding DFT bank", tempi[0].dft_bin, tempi[NUM_TEMPI - 1].dft_bin);
 	}
+}
 
-	// Compute cosine and sine for this tempo bin
-	float k = (int)(0.5 + ((tempi[tempo_bin].block_size * tempi[tempo_bin].target_tempo_hz) / NOVELTY_LOG_HZ));
-	float w = (2.0 * PI * k) / tempi[tempo_bin].block_size;
-	float cosine = cos(w);
-	float sine = sin(w);
+float calculate_magnitude_of_tempo(uint16_t tempo_bin) {
+	uint16_t block_size = tempi[tempo_bin].block_size;
 
-	// Extract magnitude and phase from Goertzel state
-	float real = (q1 - q2 * cosine);
-	float imag = (q2 * sine);
+	// Windowed DFT of the normalized novelty history, in Goertzel output form
+	float real;
+	float imag;
+	tempo_bank_read(tempo_sdft, tempi[tempo_bin].dft_bin, novelty_scale, &real, &imag);
 
 	// Calculate and unwrap phase
 	tempi[tempo_bin].phase = (unwrap_phase(atan2(imag, real)) + (PI * BEAT_SHIFT_PERCENT));
@@ -171,8 +183,7 @@ float calculate_magnitude_of_tempo(uint16_t tempo_bin) {
 	}
 
 	// Calculate magnitude
-	float magnitude_squared = (q1 * q1) + (q2 * q2) - q1 * q2 * tempi[tempo_bin].coeff;
-	float magnitude = sqrt(magnitude_squared);
+	float magnitude = sqrt((real * real) + (imag * imag));
 	float normalized_magnitude = magnitude / (block_size / 2.0);
 
 	// CRITICAL FIX: Store full-scale magnitude in struct (was missing!)
@@ -186,10 +197,14 @@ void calculate_tempo_magnitudes(uint32_t block_index) {
 	// Calculate all tempo bin magnitudes with auto-ranging
 	float max_val = 0.0;
 
+	// Phases below hold for the history as of now; render extrapolates from here
+	tempo_phase_time_us = (uint32_t)esp_timer_get_time();
+
 	// First pass: calculate all magnitudes and find max
 	for (uint16_t i = 0; i < NUM_TEMPI; i++) {
 		float magnitude = calculate_magnitude_of_tempo(i);
 		// Now tempi[i].magnitude_full_scale has been set in calculate_magnitude_of_tempo()
+		tempi[i].phase_velocity = beat_clock_velocity(tempi[i].dft_bin, NOVELTY_HISTORY_LENGTH, novelty_period_us);
 
 		if (magnitude > max_val) {
 			max_val = magnitude;
@@ -223,51 +238,117 @@ void normalize_novelty_curve() {
 	static float max_val_smooth = 0.1;
 
 	max_val *= 0.99;
-
-	for (uint16_t i = 0; i < NOVELTY_HISTORY_LENGTH; i++) {
-		max_val = fmax(max_val, novelty_curve[i]);
-	}
+	max_val = fmax(max_val, sliding_max_value(novelty_max, novelty_curve));
 
 	max_val_smooth = fmax(0.1f, max_val_smooth * 0.99f + max_val * 0.01f);
 
 	float auto_scale = 1.0 / max_val_smooth;
 
-	// Normalize novelty curve using DSP function
-	dsps_mulc_f32(novelty_curve, novelty_curve_normalized, NOVELTY_HISTORY_LENGTH, auto_scale, 1, 1);
+	// Applied on read (novelty_curve_normalized_at(), tempo bank readout)
+	novelty_scale = auto_scale;
 }
 
 void smooth_tempi_curve() {
 	// Normalize novelty curve for processing
 	normalize_novelty_curve();
 
-	// Calculate tempo magnitudes for all bins
-	static uint16_t calc_bin = 0;
-	uint16_t max_bin = (NUM_TEMPI - 1) * MAX_TEMPO_RANGE;
+	// Read all tempo bins from the sliding DFT (updated per novelty sample);
+	// between readouts the beat clock carries the phases forward
+	static uint32_t frames_since_readout = TEMPO_READOUT_INTERVAL;
+	if (++frames_since_readout >= tempo_readout_interval) {
+		frames_since_readout = 0;
+		calculate_tempo_magnitudes(0);
+	}
+}
 
-	// Calculate 2 bins per frame for performance
-	if (calc_bin + 1 < NUM_TEMPI) {
-		calculate_tempo_magnitudes(calc_bin);
-		calculate_tempo_magnitudes(calc_bin + 1);
-		calc_bin += 2;
+void update_novelty_curve(float novelty_value) {
+	const uint16_t slot = novelty_head;
+
+	// Track the real novelty rate (phase velocity depends on it)
+	static uint32_t last_push_us = 0;
+	const uint32_t now_us = (uint32_t)esp_timer_get_time();
+	if (last_push_us != 0) {
+		const float interval_us = (float)(now_us - last_push_us);
+		if (interval_us < novelty_period_us * 4.0f) {
+			novelty_period_us = novelty_period_us * 0.99f + interval_us * 0.01f;
+		}
 	}
+	last_push_us = now_us;
+
+	// Slide the tempo bank: the new value enters, the oldest leaves
+	tempo_bank_push(tempo_sdft, novelty_value, novelty_curve[slot]);
+
+	// The newest sample replaces the oldest in both histories
+	novelty_curve[slot] = novelty_value;
+	vu_curve[slot] = audio_level;  // Use current audio level
+	sliding_max_push(novelty_max, novelty_curve, slot);
+
+	novelty_head = (slot + 1) & (NOVELTY_HISTORY_LENGTH - 1);
+}
 
-	if (calc_bin >= max_bin) {
-		calc_bin = 0;
+static uint8_t dominant_pitch_class() {
+	uint8_t dominant = 0;
+	for (uint8_t i = 1; i < 12; i++) {
+		if (chromagram[i] > chromagram[dominant]) {
+			dominant = i;
+		}
 	}
+	return dominant;
 }
 
-void update_novelty_curve(float novelty_value) {
-	// Shift novelty curve history and add new value
-	shift_and_copy_arrays(novelty_curve, NOVELTY_HISTORY_LENGTH, novelty_curve, 1);
-	novelty_curve[NOVELTY_HISTORY_LENGTH - 1] = novelty_value;
+// Push beat/onset events for the render core (see beat_events.h)
+static void emit_beat_events(uint32_t now_us) {
+	static uint16_t last_bin = 0;
+	static float last_offset = 0.0f;
+
+	// Dominant tempo hypothesis
+	uint16_t dominant = 0;
+	for (uint16_t tempo_bin = 1; tempo_bin < NUM_TEMPI; tempo_bin++) {
+		if (tempi_smooth[tempo_bin] > tempi_smooth[dominant]) {
+			dominant = tempo_bin;
+		}
+	}
 
-	// Shift VU curve history
-	shift_and_copy_arrays(vu_curve, NOVELTY_HISTORY_LENGTH, vu_curve, 1);
-	vu_curve[NOVELTY_HISTORY_LENGTH - 1] = audio_level;  // Use current audio level
+	// Beat: its phase crossed the point where a novelty pulse lands
+	const float velocity = tempi[dominant].phase_velocity;
+	const float phase = beat_clock_phase(tempi[dominant].phase, velocity, tempo_phase_time_us, now_us);
+	const float offset = beat_clock_wrap(phase - (PI * BEAT_SHIFT_PERCENT));
+	if (dominant == last_bin && last_offset < 0.0f && offset >= 0.0f && offset - last_offset < PI && velocity > 0.0f) {
+		beat_event event;
+		event.timestamp_us = now_us - (uint32_t)(offset / velocity * 1000000.0f);  // The crossing itself
+		event.strength = tempo_confidence;
+		event.tempo_bin = dominant;
+		event.type = BEAT_EVENT_BEAT;
+		event.pitch_class = dominant_pitch_class();
+		beat_event_push(audio_beat_events, event);
+	}
+	last_bin = dominant;
+	last_offset = offset;
+
+	// Onset: normalized novelty rose through the threshold this frame
+	const float novelty = novelty_curve_normalized_at(NOVELTY_HISTORY_LENGTH - 1);
+	const float novelty_prev = novelty_curve_normalized_at(NOVELTY_HISTORY_LENGTH - 2);
+	if (novelty >= ONSET_THRESHOLD && novelty_prev < ONSET_THRESHOLD) {
+		beat_event event;
+		event.timestamp_us = now_us;
+		event.strength = fminf(novelty, 1.0f);
+		event.tempo_bin = dominant;
+		event.type = BEAT_EVENT_ONSET;
+		event.pitch_class = dominant_pitch_class();
+		beat_event_push(audio_beat_events, event);
+	}
 }
 
 void detect_beats() {
 	tempi_power_sum = 0.00000001;
+	const uint32_t now_us = (uint32_t)esp_timer_get_time();
+
+	// Per-bin beat values refresh on alternate frames at reduced quality
+	static uint32_t frames_since_refresh = 0;
+	const bool refresh_beats = ++frames_since_refresh >= tempo_refresh_interval;
+	if (refresh_beats) {
+		frames_since_refresh = 0;
+	}
 
 	// Smooth tempo magnitudes and calculate power sum
 	for (uint16_t tempo_bin = 0; tempo_bin < NUM_TEMPI; tempo_bin++) {
@@ -278,16 +359,16 @@ void detect_beats() {
 		tempi_smooth[tempo_bin] = tempi_smooth[tempo_bin] * 0.92 + (tempi_magnitude) * 0.08;
 		tempi_power_sum += tempi_smooth[tempo_bin];
 
-		// Advance beat phase
-		if (tempi[tempo_bin].phase > PI) {
-			tempi[tempo_bin].phase -= (2 * PI);
-		}
-		else if (tempi[tempo_bin].phase < -PI) {
-			tempi[tempo_bin].phase += (2 * PI);
+		if (!refresh_beats) {
+			continue;
 		}
 
+		// Advance beat phase to now (readouts are tempo_readout_interval frames apart)
+		float phase = beat_clock_phase(tempi[tempo_bin].phase, tempi[tempo_bin].phase_velocity,
+		                               tempo_phase_time_us, now_us);
+
 		// Calculate beat value from phase
-		tempi[tempo_bin].beat = sin(tempi[tempo_bin].phase);
+		tempi[tempo_bin].beat = sin(phase);
 	}
 
 	// Calculate beat detection confidence
@@ -298,4 +379,11 @@ void detect_beats() {
 	}
 
 	tempo_confidence = max_contribution;
+
+	emit_beat_events(now_us);
+}
+
+void set_tempo_quality(const audio_quality& quality) {
+	tempo_readout_interval = quality.tempo_readout_interval;
+	tempo_refresh_interval = quality.refresh_interval;
 }
@@ -15,19 +15,23 @@
 #define TEMPO_H
 
 #include "goertzel.h"
+#include "beat_events.h"
 #include <stdint.h>
 
 // ============================================================================
 // CONFIGURATION & CONSTANTS
 // ============================================================================
 
-#define NOVELTY_HISTORY_LENGTH (1024)  // 50 FPS for 20.48 seconds
-#define NOVELTY_LOG_HZ (50)
+#define NOVELTY_PERIOD_US (8000)       // One novelty sample per audio frame (AUDIO_FRAME_US, microphone.h)
+#define NOVELTY_LOG_HZ (1000000.0f / NOVELTY_PERIOD_US)
+#define NOVELTY_HISTORY_LENGTH (2048)  // 125 FPS for 16.38 seconds
 
 #define TEMPO_LOW (64-32)              // BPM range: 32-192 BPM
 #define TEMPO_HIGH (192-32)
 
 #define BEAT_SHIFT_PERCENT (0.08)
+#define TEMPO_READOUT_INTERVAL (2)      // Frames between tempo bin readouts at full quality (phases extrapolated in between)
+#define ONSET_THRESHOLD (0.5)          // Normalized novelty that counts as an onset event
 
 // ============================================================================
 // GLOBAL DATA (stored in goertzel.h - only tempo-specific state here)
@@ -37,13 +41,32 @@
 extern float tempi_bpm_values_hz[NUM_TEMPI];      // BPM center frequencies
 extern float tempo_confidence;                     // Beat confidence (0.0-1.0)
 extern float MAX_TEMPO_RANGE;
+extern uint32_t tempo_phase_time_us;              // When tempi[].phase was measured
+extern float novelty_period_us;                    // Measured interval between novelty samples
 
-// Tempo tracking curves
+// Tempo tracking curves (circular: the oldest sample sits at novelty_head)
 extern float novelty_curve[NOVELTY_HISTORY_LENGTH];           // Spectral flux history
-extern float novelty_curve_normalized[NOVELTY_HISTORY_LENGTH]; // Normalized novelty
 extern float vu_curve[NOVELTY_HISTORY_LENGTH];                // VU level history
+extern uint16_t novelty_head;                                  // Slot of the oldest sample
+extern float novelty_scale;                                    // Normalization, applied on read
 extern float tempi_power_sum;                                  // Sum of tempo magnitudes
 
+// Novelty history in time order: 0 = oldest, NOVELTY_HISTORY_LENGTH - 1 = newest
+inline float novelty_curve_at(uint16_t index) {
+	return novelty_curve[(novelty_head + index) & (NOVELTY_HISTORY_LENGTH - 1)];
+}
+
+inline float novelty_curve_normalized_at(uint16_t index) {
+	return novelty_curve_at(index) * novelty_scale;
+}
+
+// Beat/onset events for the render core (produced by detect_beats())
+extern beat_event_queue audio_beat_events;
+
+// Tempo side of the analysis quality level (see quality_governor.h)
+extern uint8_t tempo_readout_interval;             // Frames between tempo bin readouts
+extern uint8_t tempo_refresh_interval;             // Frames between per-bin beat value refreshes
+
 // Silence detection
 extern bool silence_detected;
 extern float silence_level;
@@ -71,6 +94,9 @@ void update_novelty_curve(float novelty_value);
 // Detect beats and update confidence
 void detect_beats();
 
+// Apply the tempo side of a quality level (called by audio_task on a level change)
+void set_tempo_quality(const audio_quality& quality);
+
 // ============================================================================
 // PUBLIC API - UTILITY FUNCTIONS
 // ============================================================================
@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------
+// Tempo Bank - Sliding DFT over the novelty history
+//
+// Every tempo bin integrates the full novelty history (the block size its
+// BPM spacing asks for is longer than the history, so all bins are capped
+// at the same length B), and its Goertzel coefficient is rounded to an
+// integer DFT bin k of that length. So instead of re-running 64 windowed
+// Goertzels over B samples each frame, the bank keeps the length-B DFT of
+// the history for every bin k in use and slides it by one sample per
+// novelty frame:
+//
+//     S_k[n] = e^(j 2 pi k / B) * (r * S_k[n-1] + x[n] - r^B * x[n-B])
+//
+// The damping r (TEMPO_BANK_DAMPING, just below 1) keeps rounding errors
+// from accumulating: the recursion has gain r per step, so errors decay
+// instead of random-walking. The resulting r^(B-1-m) tilt across the
+// window is deterministic and folded into the window below.
+//
+// The Goertzel path applied window_lookup (a Gaussian) in the time
+// domain. Here it is applied in the frequency domain: the tilted window
+// w(m) / r^(B-1-m) is expanded as a Fourier series over the block, and the
+// windowed bin is sum_j a_j * S_(k-j) over |j| <= TEMPO_BANK_WINDOW_TERMS.
+// The Gaussian is cut off at ~0.46 rather than tapered to zero, so its
+// slope jumps at the block edges and the terms only fall off as 1 / j^2:
+// 20 terms each side keep in-range bins within ~0.6% of the Goertzel
+// (see test_native_tempo_bank), still a small fraction of its cost.
+//
+// Readout uses the Goertzel output convention (q1 - q2 cos w, q2 sin w),
+// so magnitude and phase come out as they did from the Goertzel state.
+
+#ifndef TEMPO_BANK_H
+#define TEMPO_BANK_H
+
+#include <stdint.h>
+#include <math.h>
+
+#define TEMPO_BANK_MAX_BINS 96           // DFT bins held (DC or lowest tempo bin up to highest plus window terms)
+#define TEMPO_BANK_WINDOW_TERMS 20        // Fourier terms each side of the window expansion
+#define TEMPO_BANK_DAMPING 0.99999f      // r; 1 - r well above float rounding (~6e-8)
+
+typedef struct {
+	uint16_t block_size;                 // B: samples in the sliding window
+	uint16_t k_first;                    // DFT bin held in slot 0
+	uint16_t count;                      // Bins held
+	float damping;                       // r
+	float damping_block;                 // r^B, applied to the sample leaving
+	float twiddle_re[TEMPO_BANK_MAX_BINS];   // e^(j 2 pi k / B)
+	float twiddle_im[TEMPO_BANK_MAX_BINS];
+	float state_re[TEMPO_BANK_MAX_BINS];     // S_k
+	float state_im[TEMPO_BANK_MAX_BINS];
+	float window_re[2 * TEMPO_BANK_WINDOW_TERMS + 1];  // a_j, j = -terms..terms
+	float window_im[2 * TEMPO_BANK_WINDOW_TERMS + 1];
+} tempo_bank;
+
+// Hold DFT bins k_min..k_max (plus the window terms around them) of a
+// `block_size` window; `window` holds the block_size time-domain weights
+// Returns false if the range does not fit TEMPO_BANK_MAX_BINS
+inline bool tempo_bank_init(tempo_bank& bank, uint16_t block_size, uint16_t k_min, uint16_t k_max,
+                            const float* window, float damping) {
+	// Bins below DC are the conjugates of those above it (real input), so
+	// hold from DC up when the window terms reach past it
+	int16_t first = (int16_t)k_min - TEMPO_BANK_WINDOW_TERMS;
+	if (first < 0) {
+		first = 0;
+	}
+	const uint16_t count = (uint16_t)(k_max + TEMPO_BANK_WINDOW_TERMS + 1 - first);
+	if (count > TEMPO_BANK_MAX_BINS || k_max + TEMPO_BANK_WINDOW_TERMS >= block_size / 2) {
+		return false;
+	}
+
+	bank.block_size = block_size;
+	bank.k_first = (uint16_t)first;
+	bank.count = count;
+	bank.damping = damping;
+	bank.damping_block = (float)pow((double)damping, (double)block_size);
+
+	for (uint16_t i = 0; i < count; i++) {
+		const double w = 2.0 * M_PI * (double)(first + i) / block_size;
+		bank.twiddle_re[i] = (float)cos(w);
+		bank.twiddle_im[i] = (float)sin(w);
+		bank.state_re[i] = 0.0f;
+		bank.state_im[i] = 0.0f;
+	}
+
+	// a_j = 1/B * sum_m w(m) r^-(B-1-m) e^(-j 2 pi j m / B)
+	for (int16_t j = -TEMPO_BANK_WINDOW_TERMS; j <= TEMPO_BANK_WINDOW_TERMS; j++) {
+		double re = 0.0, im = 0.0;
+		for (uint16_t m = 0; m < block_size; m++) {
+			const double tilted = window[m] * pow((double)damping, -(double)(block_size - 1 - m));
+			const double angle = -2.0 * M_PI * j * m / block_size;
+			re += tilted * cos(angle);
+			im += tilted * sin(angle);
+		}
+		bank.window_re[j + TEMPO_BANK_WINDOW_TERMS] = (float)(re / block_size);
+		bank.window_im[j + TEMPO_BANK_WINDOW_TERMS] = (float)(im / block_size);
+	}
+	return true;
+}
+
+// Clear the state (the history it slides over must be all zero too)
+inline void tempo_bank_reset(tempo_bank& bank) {
+	for (uint16_t i = 0; i < bank.count; i++) {
+		bank.state_re[i] = 0.0f;
+		bank.state_im[i] = 0.0f;
+	}
+}
+
+// One novelty sample in, the sample from block_size frames ago out: O(bins)
+inline void tempo_bank_push(tempo_bank& bank, float entering, float leaving) {
+	const float input = entering - bank.damping_block * leaving;
+	const float r = bank.damping;
+	for (uint16_t i = 0; i < bank.count; i++) {
+		const float re = r * bank.state_re[i] + input;
+		const float im = r * bank.state_im[i];
+		bank.state_re[i] = re * bank.twiddle_re[i] - im * bank.twiddle_im[i];
+		bank.state_im[i] = re * bank.twiddle_im[i] + im * bank.twiddle_re[i];
+	}
+}
+
+// Windowed bin k, scaled, in Goertzel output form (real = q1 - q2 cos w, imag = q2 sin w)
+inline void tempo_bank_read(const tempo_bank& bank, uint16_t k, float scale, float* real, float* imag) {
+	float re = 0.0f, im = 0.0f;
+	for (int16_t j = -TEMPO_BANK_WINDOW_TERMS; j <= TEMPO_BANK_WINDOW_TERMS; j++) {
+		const float a_re = bank.window_re[j + TEMPO_BANK_WINDOW_TERMS];
+		const float a_im = bank.window_im[j + TEMPO_BANK_WINDOW_TERMS];
+		const int16_t bin = (int16_t)k - j;
+		const float s_re = bank.state_re[(bin < 0 ? -bin : bin) - bank.k_first];
+		const float s_im = bin < 0 ? -bank.state_im[-bin - bank.k_first] : bank.state_im[bin - bank.k_first];
+		re += a_re * s_re - a_im * s_im;
+		im += a_re * s_im + a_im * s_re;
+	}
+
+	// Goertzel ends one step short of the DFT: y = e^(-j w) * X for integer k
+	const uint16_t slot = k - bank.k_first;
+	const float t_re = bank.twiddle_re[slot];
+	const float t_im = bank.twiddle_im[slot];
+	*real = (re * t_re + im * t_im) * scale;
+	*imag = (im * t_re - re * t_im) * scale;
+}
+
+#endif  // TEMPO_BANK_H
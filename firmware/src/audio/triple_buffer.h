@@ -0,0 +1,64 @@
+// -----------------------------------------------------------------
+// Triple Buffer - Zero-copy publication of audio frames to the render task
+//
+// Three snapshot slots: the one the audio task is filling, the latest
+// published one, and the one the render task is reading. Publishing a
+// frame is an index store, and the writer then moves to a slot that is
+// neither published nor being read. The reader announces the slot it is
+// about to use and re-checks that it is still the published one; once
+// that holds, the writer will not pick it until the reader moves on, so
+// the reader can keep a plain const pointer for its whole frame instead
+// of copying the snapshot and retrying on torn reads.
+//
+// One writer, one reader. The reader's announcement may be seen late by
+// the writer, but the reader only ever moves to the published slot, which
+// the writer never picks anyway.
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <stdint.h>
+
+#define TRIPLE_BUFFER_SLOTS 3
+
+typedef struct {
+	volatile uint8_t published;          // Latest complete slot
+	volatile uint8_t reading;            // Reader: slot in use
+	uint8_t writing;                     // Writer only: slot being filled
+} triple_buffer;
+
+inline void triple_buffer_init(triple_buffer& buffer) {
+	buffer.published = 0;
+	buffer.reading = 0;
+	buffer.writing = 1;
+}
+
+// Writer: the slot being filled is complete; returns the next one to fill
+inline uint8_t triple_buffer_publish(triple_buffer& buffer) {
+	__sync_synchronize();   // Slot contents visible before it is published
+	buffer.published = buffer.writing;
+	__sync_synchronize();
+
+	const uint8_t published = buffer.writing;
+	const uint8_t reading = buffer.reading;
+	for (uint8_t slot = 0; slot < TRIPLE_BUFFER_SLOTS; slot++) {
+		if (slot != published && slot != reading) {
+			buffer.writing = slot;
+			break;
+		}
+	}
+	return buffer.writing;
+}
+
+// Reader: take the latest published slot; it stays intact until the next call
+inline uint8_t triple_buffer_acquire(triple_buffer& buffer) {
+	uint8_t slot;
+	do {
+		slot = buffer.published;
+		buffer.reading = slot;
+		__sync_synchronize();   // Announcement visible before the re-check
+	} while (buffer.published != slot);
+	return slot;
+}
+
+#endif  // TRIPLE_BUFFER_H
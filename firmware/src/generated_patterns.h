@@ -15,6 +15,7 @@
 #include <math.h>
 
 extern CRGBF leds[NUM_LEDS];
+extern CRGBF leds_half[STRIP_HALF_LENGTH];
 
 // ============================================================================
 // HELPER FUNCTIONS - Infrastructure for ported light shows
@@ -64,19 +65,6 @@ CRGBF hsv(float h, float s, float v) {
 	return result;
 }
 
-/**
- * Apply mirror/split mode to LED array
- * Copies first half to second half in reverse for symmetrical patterns
- */
-inline void apply_mirror_mode(CRGBF* leds, bool enabled) {
-	if (!enabled) return;
-
-	int half = NUM_LEDS / 2;
-	for (int i = 0; i < half; i++) {
-		leds[NUM_LEDS - 1 - i] = leds[i];
-	}
-}
-
 /**
  * Alpha-blend two color arrays
  * Used for sprite rendering and persistence effects (tunnel, etc)
@@ -99,6 +87,7 @@ inline void blend_sprite(CRGBF* dest, const CRGBF* sprite, uint32_t length, floa
  * Eliminates repeated division operations in pattern loops
  */
 #define LED_PROGRESS(i) ((float)(i) / (float)NUM_LEDS)
+#define LED_HALF_PROGRESS(d) ((float)(d) / (float)STRIP_HALF_LENGTH)  // Centre (0.0) to edge, leds_half[] index
 #define TEMPO_PROGRESS(i) ((float)(i) / (float)NUM_TEMPI)
 
 /**
@@ -164,10 +153,9 @@ void draw_departure(float time, const PatternParameters& params) {
 	};
 	const int palette_size = 12;
 
-	for (int i = 0; i < NUM_LEDS; i++) {
+	for (int d = 0; d < STRIP_HALF_LENGTH; d++) {
 		// CENTER-ORIGIN: Distance from center (0.0 at center → 1.0 at edges)
-		float position = (abs(float(i) - (NUM_LEDS / 2.0f)) / (NUM_LEDS / 2.0f));
-		position = fmaxf(0.0f, fminf(1.0f, position));
+		float position = LED_HALF_PROGRESS(d);
 		
 		// Palette interpolation
 		int palette_index = (int)(position * (palette_size - 1));
@@ -175,20 +163,15 @@ void draw_departure(float time, const PatternParameters& params) {
 		
 		// Clamp to valid range
 		if (palette_index >= palette_size - 1) {
-			leds[i] = palette_colors[palette_size - 1];
+			leds_half[d] = palette_colors[palette_size - 1];
 		} else {
 			const CRGBF& color1 = palette_colors[palette_index];
 			const CRGBF& color2 = palette_colors[palette_index + 1];
 			
-			leds[i].r = color1.r + (color2.r - color1.r) * interpolation_factor;
-			leds[i].g = color1.g + (color2.g - color1.g) * interpolation_factor;
-			leds[i].b = color1.b + (color2.b - color1.b) * interpolation_factor;
+			leds_half[d].r = color1.r + (color2.r - color1.r) * interpolation_factor;
+			leds_half[d].g = color1.g + (color2.g - color1.g) * interpolation_factor;
+			leds_half[d].b = color1.b + (color2.b - color1.b) * interpolation_factor;
 		}
-		
-		// Apply runtime parameters: brightness multiplier
-		leds[i].r *= params.brightness;
-		leds[i].g *= params.brightness;
-		leds[i].b *= params.brightness;
 	}
 }
 
@@ -209,10 +192,9 @@ void draw_lava(float time, const PatternParameters& params) {
 	};
 	const int palette_size = 13;
 
-	for (int i = 0; i < NUM_LEDS; i++) {
+	for (int d = 0; d < STRIP_HALF_LENGTH; d++) {
 		// CENTER-ORIGIN: Distance from center (0.0 at center → 1.0 at edges)
-		float position = (abs(float(i) - (NUM_LEDS / 2.0f)) / (NUM_LEDS / 2.0f));
-		position = fmaxf(0.0f, fminf(1.0f, position));
+		float position = LED_HALF_PROGRESS(d);
 		
 		// Palette interpolation
 		int palette_index = (int)(position * (palette_size - 1));
@@ -220,20 +202,15 @@ void draw_lava(float time, const PatternParameters& params) {
 		
 		// Clamp to valid range
 		if (palette_index >= palette_size - 1) {
-			leds[i] = palette_colors[palette_size - 1];
+			leds_half[d] = palette_colors[palette_size - 1];
 		} else {
 			const CRGBF& color1 = palette_colors[palette_index];
 			const CRGBF& color2 = palette_colors[palette_index + 1];
 			
-			leds[i].r = color1.r + (color2.r - color1.r) * interpolation_factor;
-			leds[i].g = color1.g + (color2.g - color1.g) * interpolation_factor;
-			leds[i].b = color1.b + (color2.b - color1.b) * interpolation_factor;
+			leds_half[d].r = color1.r + (color2.r - color1.r) * interpolation_factor;
+			leds_half[d].g = color1.g + (color2.g - color1.g) * interpolation_factor;
+			leds_half[d].b = color1.b + (color2.b - color1.b) * interpolation_factor;
 		}
-		
-		// Apply runtime parameters: brightness multiplier
-		leds[i].r *= params.brightness;
-		leds[i].g *= params.brightness;
-		leds[i].b *= params.brightness;
 	}
 }
 
@@ -252,10 +229,9 @@ void draw_twilight(float time, const PatternParameters& params) {
 	};
 	const int palette_size = 7;
 
-	for (int i = 0; i < NUM_LEDS; i++) {
+	for (int d = 0; d < STRIP_HALF_LENGTH; d++) {
 		// CENTER-ORIGIN: Distance from center (0.0 at center → 1.0 at edges)
-		float position = (abs(float(i) - (NUM_LEDS / 2.0f)) / (NUM_LEDS / 2.0f));
-		position = fmaxf(0.0f, fminf(1.0f, position));
+		float position = LED_HALF_PROGRESS(d);
 		
 		// Palette interpolation
 		int palette_index = (int)(position * (palette_size - 1));
@@ -263,20 +239,15 @@ void draw_twilight(float time, const PatternParameters& params) {
 		
 		// Clamp to valid range
 		if (palette_index >= palette_size - 1) {
-			leds[i] = palette_colors[palette_size - 1];
+			leds_half[d] = palette_colors[palette_size - 1];
 		} else {
 			const CRGBF& color1 = palette_colors[palette_index];
 			const CRGBF& color2 = palette_colors[palette_index + 1];
 			
-			leds[i].r = color1.r + (color2.r - color1.r) * interpolation_factor;
-			leds[i].g = color1.g + (color2.g - color1.g) * interpolation_factor;
-			leds[i].b = color1.b + (color2.b - color1.b) * interpolation_factor;
+			leds_half[d].r = color1.r + (color2.r - color1.r) * interpolation_factor;
+			leds_half[d].g = color1.g + (color2.g - color1.g) * interpolation_factor;
+			leds_half[d].b = color1.b + (color2.b - color1.b) * interpolation_factor;
 		}
-		
-		// Apply runtime parameters: brightness multiplier
-		leds[i].r *= params.brightness;
-		leds[i].g *= params.brightness;
-		leds[i].b *= params.brightness;
 	}
 }
 
@@ -292,7 +263,7 @@ void draw_twilight(float time, const PatternParameters& params) {
  * - progress = LED position (0.0 at left, 1.0 at right)
  * - brightness = frequency magnitude
  * - Uses color_from_palette() for vibrant interpolation
- * - Center-origin: render half, mirror to other half
+ * - Center-origin: renders leds_half[], the engine mirrors it
  */
 void draw_spectrum(float time, const PatternParameters& params) {
 	PATTERN_AUDIO_START();
@@ -300,8 +271,8 @@ void draw_spectrum(float time, const PatternParameters& params) {
 	// Fallback to ambient if no audio
 	if (!AUDIO_IS_AVAILABLE()) {
 		CRGBF ambient_color = color_from_palette(params.palette_id, 0.5f, params.background * 0.3f);
-		for (int i = 0; i < NUM_LEDS; i++) {
-			leds[i] = ambient_color;
+		for (int d = 0; d < STRIP_HALF_LENGTH; d++) {
+			leds_half[d] = ambient_color;
 		}
 		return;
 	}
@@ -309,29 +280,15 @@ void draw_spectrum(float time, const PatternParameters& params) {
 	// Fade if audio is stale (silence detection)
 	float freshness_factor = AUDIO_IS_STALE() ? 0.5f : 1.0f;
 
-	// Render spectrum (center-origin, so render half and mirror)
-	int half_leds = NUM_LEDS / 2;
-
-	for (int i = 0; i < half_leds; i++) {
+	// Render spectrum (center-origin: half strip, the engine mirrors it)
+	for (int i = 0; i < STRIP_HALF_LENGTH; i++) {
 		// Map LED position to frequency bin (0-63)
-		float progress = (float)i / half_leds;
-		float magnitude = AUDIO_SPECTRUM_SMOOTH[(int)(progress * 63.0f)] * freshness_factor;
+		float progress = LED_HALF_PROGRESS(i);
+		float magnitude = AUDIO_SPECTRUM_SMOOTH_INTERP((int)(progress * 63.0f)) * freshness_factor;
 		magnitude = fmaxf(0.0f, fminf(1.0f, magnitude));
 
 		// Get color from palette using progress and magnitude
-		CRGBF color = color_from_palette(params.palette_id, progress, magnitude);
-
-		// Apply brightness
-		color.r *= params.brightness;
-		color.g *= params.brightness;
-		color.b *= params.brightness;
-
-		// Mirror from center (centre-origin architecture)
-		int left_index = (NUM_LEDS / 2) - 1 - i;
-		int right_index = (NUM_LEDS / 2) + i;
-
-		leds[left_index] = color;
-		leds[right_index] = color;
+		leds_half[i] = color_from_palette(params.palette_id, progress, magnitude);
 	}
 }
 
@@ -343,7 +300,7 @@ void draw_spectrum(float time, const PatternParameters& params) {
  * - progress = LED position (maps to 12 chromagram bins)
  * - brightness = note magnitude from chromagram
  * - Uses color_from_palette() for smooth color transitions
- * - Center-origin: render half, mirror to other half
+ * - Center-origin: renders leds_half[], the engine mirrors it
  */
 void draw_octave(float time, const PatternParameters& params) {
 	PATTERN_AUDIO_START();
@@ -351,10 +308,7 @@ void draw_octave(float time, const PatternParameters& params) {
 	// Fallback to time-based animation if no audio
 	if (!AUDIO_IS_AVAILABLE()) {
 		float phase = fmodf(time * params.speed * 0.5f, 1.0f);
-		for (int i = 0; i < NUM_LEDS; i++) {
-			float position = fmodf(phase + (float)i / NUM_LEDS, 1.0f);
-			leds[i] = color_from_palette(params.palette_id, position, params.background);
-		}
+		color_from_palette_span(params.palette_id, leds_half, STRIP_HALF_LENGTH, phase, LED_HALF_PROGRESS(1), params.background);
 		return;
 	}
 
@@ -362,33 +316,19 @@ void draw_octave(float time, const PatternParameters& params) {
 	float beat_boost = 1.0f + (AUDIO_TEMPO_CONFIDENCE * 0.5f);
 	float freshness_factor = AUDIO_IS_STALE() ? 0.5f : 1.0f;
 
-	// Render chromagram (12 musical notes)
-	int half_leds = NUM_LEDS / 2;
-
-	for (int i = 0; i < half_leds; i++) {
+	// Render chromagram (12 musical notes; center-origin half strip)
+	for (int i = 0; i < STRIP_HALF_LENGTH; i++) {
 		// Map LED to chromagram bin (0-11)
-		float progress = (float)i / half_leds;
+		float progress = LED_HALF_PROGRESS(i);
 		int note = (int)(progress * 11.0f);
 		if (note > 11) note = 11;
 
 		// Get magnitude from chromagram
-		float magnitude = AUDIO_CHROMAGRAM[note] * freshness_factor * beat_boost;
+		float magnitude = AUDIO_CHROMAGRAM_INTERP(note) * freshness_factor * beat_boost;
 		magnitude = fmaxf(0.0f, fminf(1.0f, magnitude));
 
 		// Get color from palette
-		CRGBF color = color_from_palette(params.palette_id, progress, magnitude);
-
-		// Apply brightness
-		color.r *= params.brightness;
-		color.g *= params.brightness;
-		color.b *= params.brightness;
-
-		// Mirror from center
-		int left_index = (NUM_LEDS / 2) - 1 - i;
-		int right_index = (NUM_LEDS / 2) + i;
-
-		leds[left_index] = color;
-		leds[right_index] = color;
+		leds_half[i] = color_from_palette(params.palette_id, progress, magnitude);
 	}
 }
 
@@ -409,13 +349,13 @@ void draw_bloom(float time, const PatternParameters& params) {
 	if (!AUDIO_IS_AVAILABLE()) {
 		for (int i = 0; i < NUM_LEDS; i++) {
 			bloom_buffer[i] *= 0.95f;  // Gentle decay
-			leds[i] = color_from_palette(params.palette_id, (float)i / NUM_LEDS, bloom_buffer[i] * params.brightness);
+			leds[i] = color_from_palette(params.palette_id, (float)i / NUM_LEDS, bloom_buffer[i]);
 		}
 		return;
 	}
 
 	// Get VU level for energy response
-	float energy = AUDIO_VU;
+	float energy = AUDIO_VU_INTERP;
 	float freshness_factor = AUDIO_IS_STALE() ? 0.9f : 1.0f;
 
 	// Spread energy from center
@@ -447,10 +387,7 @@ void draw_bloom(float time, const PatternParameters& params) {
 		// Color follows position in palette
 		CRGBF color = color_from_palette(params.palette_id, position, magnitude);
 
-		// Apply brightness
-		leds[i].r = color.r * params.brightness;
-		leds[i].g = color.g * params.brightness;
-		leds[i].b = color.b * params.brightness;
+		leds[i] = color;
 	}
 }
 
@@ -496,29 +433,6 @@ typedef struct {
 
 static pulse_wave pulse_waves[MAX_PULSE_WAVES];
 
-// Helper: get dominant chromatic note (highest energy in chromagram)
-float get_dominant_chroma_hue() {
-	AudioDataSnapshot audio = {0};
-	bool audio_available = get_audio_snapshot(&audio);
-
-	if (!audio_available) {
-		return 0.0f;  // Default to C if no audio available
-	}
-
-	float max_chroma = 0.0f;
-	uint16_t max_index = 0;
-
-	for (uint16_t i = 0; i < 12; i++) {
-		if (audio.chromagram[i] > max_chroma) {
-			max_chroma = audio.chromagram[i];
-			max_index = i;
-		}
-	}
-
-	// Map chromagram index (0-11) to hue (0.0-1.0)
-	return (float)max_index / 12.0f;
-}
-
 void draw_pulse(float time, const PatternParameters& params) {
 	PATTERN_AUDIO_START();
 
@@ -533,32 +447,36 @@ void draw_pulse(float time, const PatternParameters& params) {
 
 	// Fallback to ambient if no audio
 	if (!AUDIO_IS_AVAILABLE()) {
-		for (int i = 0; i < NUM_LEDS; i++) {
-			leds[i] = color_from_palette(params.palette_id, 0.5f, params.background * 0.3f);
+		const CRGBF ambient_color = color_from_palette(params.palette_id, 0.5f, params.background * 0.3f);
+		for (int d = 0; d < STRIP_HALF_LENGTH; d++) {
+			leds_half[d] = ambient_color;
 		}
 		return;
 	}
 
-	// Beat detection and wave spawning
+	// Spawn one wave per beat event (emitted once per beat by detect_beats())
 	float beat_threshold = 0.3f;
-	if (AUDIO_TEMPO_CONFIDENCE > beat_threshold) {
-		// Spawn new wave on beat
+	beat_event event;
+	while (AUDIO_NEXT_BEAT_EVENT(event)) {
+		if (event.type != BEAT_EVENT_BEAT || event.strength <= beat_threshold) {
+			continue;
+		}
 		for (uint16_t i = 0; i < MAX_PULSE_WAVES; i++) {
 			if (!pulse_waves[i].active) {
 				pulse_waves[i].position = 0.0f;
 				pulse_waves[i].speed = (0.2f + params.speed * 0.4f);
-				pulse_waves[i].hue = get_dominant_chroma_hue();
-				pulse_waves[i].brightness = sqrtf(AUDIO_TEMPO_CONFIDENCE);
+				pulse_waves[i].hue = (float)event.pitch_class / 12.0f;  // Dominant note at the beat
+				pulse_waves[i].brightness = sqrtf(event.strength);
 				pulse_waves[i].age = 0;
 				pulse_waves[i].active = true;
-				break; // Only spawn one wave per frame
+				break;
 			}
 		}
 	}
 
-	// Clear LED buffer
-	for (int i = 0; i < NUM_LEDS; i++) {
-		leds[i] = CRGBF(0.0f, 0.0f, 0.0f);
+	// Clear LED buffer (center-origin half strip)
+	for (int d = 0; d < STRIP_HALF_LENGTH; d++) {
+		leds_half[d] = CRGBF(0.0f, 0.0f, 0.0f);
 	}
 
 	// Update and render all active waves
@@ -583,8 +501,11 @@ void draw_pulse(float time, const PatternParameters& params) {
 		float decay = expf(-(float)pulse_waves[w].age * decay_factor);
 		float wave_width = base_width + width_growth * pulse_waves[w].age;
 
-		for (int i = 0; i < (NUM_LEDS >> 1); i++) {
-			float led_progress = LED_PROGRESS(i);
+		// Use palette system directly from web UI selection; one hue per wave
+		const CRGBF wave_color = color_from_palette(params.palette_id, pulse_waves[w].hue, 1.0f);
+
+		for (int d = 0; d < STRIP_HALF_LENGTH; d++) {
+			float led_progress = LED_PROGRESS(d);   // 0.0 at the centre, 0.5 at the edges
 
 			// Gaussian bell curve centered at wave position
 			float distance = fabsf(led_progress - pulse_waves[w].position);
@@ -594,25 +515,14 @@ void draw_pulse(float time, const PatternParameters& params) {
 			float intensity = pulse_waves[w].brightness * gaussian * decay;
 			intensity = fmaxf(0.0f, fminf(1.0f, intensity));
 
-			// Use palette system directly from web UI selection
-			CRGBF color = color_from_palette(params.palette_id, pulse_waves[w].hue, intensity);
+			CRGBF color(wave_color.r * intensity, wave_color.g * intensity, wave_color.b * intensity);
 
-			// Additive blending for overlapping waves
-			leds[i].r = fmaxf(0.0f, fminf(1.0f, leds[i].r + color.r * intensity));
-			leds[i].g = fmaxf(0.0f, fminf(1.0f, leds[i].g + color.g * intensity));
-			leds[i].b = fmaxf(0.0f, fminf(1.0f, leds[i].b + color.b * intensity));
+			// Additive blending for overlapping waves (the engine clamps the sum)
+			leds_half[d].r += color.r * intensity;
+			leds_half[d].g += color.g * intensity;
+			leds_half[d].b += color.b * intensity;
 		}
 	}
-
-	// Mirror from center
-	apply_mirror_mode(leds, true);
-
-	// Apply global brightness
-	for (int i = 0; i < NUM_LEDS; i++) {
-		leds[i].r *= params.brightness;
-		leds[i].g *= params.brightness;
-		leds[i].b *= params.brightness;
-	}
 }
 
 /**
@@ -657,10 +567,7 @@ void draw_tempiscope(float time, const PatternParameters& params) {
 	// Fallback to animated gradient if no audio
 	if (!AUDIO_IS_AVAILABLE()) {
 		float phase = fmodf(time * params.speed * 0.3f, 1.0f);
-		for (int i = 0; i < NUM_LEDS; i++) {
-			float position = fmodf(phase + LED_PROGRESS(i), 1.0f);
-			leds[i] = color_from_palette(params.palette_id, position, params.background * 0.5f);
-		}
+		color_from_palette_span(params.palette_id, leds, NUM_LEDS, phase, LED_PROGRESS(1), params.background * 0.5f);
 		return;
 	}
 
@@ -671,12 +578,13 @@ void draw_tempiscope(float time, const PatternParameters& params) {
 
 	// Render tempo bins with per-bin phase and magnitude (EMOTISCOPE PROPER ARCHITECTURE)
 	float freshness_factor = AUDIO_IS_STALE() ? 0.5f : 1.0f;
+	const uint32_t now_us = (uint32_t)esp_timer_get_time();  // Beat clock instant for all bins
 
 	// Render each tempo bin individually
 	for (uint16_t i = 0; i < NUM_TEMPI && i < NUM_LEDS; i++) {
 		// Get per-tempo-bin data from audio snapshot
 		float magnitude = AUDIO_TEMPO_MAGNITUDE(i);
-		float phase = AUDIO_TEMPO_PHASE(i);
+		float phase = AUDIO_TEMPO_PHASE_AT(i, now_us);
 
 		// Convert phase (radians) to sine factor (0.0-1.0) using Emotiscope mapping
 		// phase ranges from -PI to PI, we map to 0.0-1.0 with peak at 0
@@ -694,10 +602,10 @@ void draw_tempiscope(float time, const PatternParameters& params) {
 		// Use palette system directly from web UI selection
 		CRGBF color = color_from_palette(params.palette_id, hue_progress, brightness);
 
-		// Apply brightness and saturation
-		leds[i].r = color.r * params.brightness * params.saturation;
-		leds[i].g = color.g * params.brightness * params.saturation;
-		leds[i].b = color.b * params.brightness * params.saturation;
+		// Apply saturation
+		leds[i].r = color.r * params.saturation;
+		leds[i].g = color.g * params.saturation;
+		leds[i].b = color.b * params.saturation;
 	}
 }
 
@@ -723,8 +631,9 @@ void draw_tempiscope(float time, const PatternParameters& params) {
 // float position = eased * NUM_LEDS;  // Use eased position instead of linear
 
 // Static buffers for tunnel image and motion blur persistence
-static CRGBF beat_tunnel_image[NUM_LEDS];
-static CRGBF beat_tunnel_image_prev[NUM_LEDS];
+// Left half of the strip, [0] at the edge; the engine mirrors it (center-origin)
+static CRGBF beat_tunnel_image[STRIP_HALF_LENGTH];
+static CRGBF beat_tunnel_image_prev[STRIP_HALF_LENGTH];
 static float beat_tunnel_angle = 0.0f;
 
 void draw_beat_tunnel(float time, const PatternParameters& params) {
@@ -740,7 +649,7 @@ void draw_beat_tunnel(float time, const PatternParameters& params) {
 	}
 
 	// Clear frame buffer
-	for (int i = 0; i < NUM_LEDS; i++) {
+	for (int i = 0; i < STRIP_HALF_LENGTH; i++) {
 		beat_tunnel_image[i] = CRGBF(0.0f, 0.0f, 0.0f);
 	}
 
@@ -750,7 +659,7 @@ void draw_beat_tunnel(float time, const PatternParameters& params) {
 
 	// Blend previous frame into current frame (motion blur/persistence)
 	float alpha_blend = 0.95f;  // Previous frame opacity
-	for (int i = 0; i < NUM_LEDS; i++) {
+	for (int i = 0; i < STRIP_HALF_LENGTH; i++) {
 		beat_tunnel_image[i].r = beat_tunnel_image_prev[i].r * alpha_blend;
 		beat_tunnel_image[i].g = beat_tunnel_image_prev[i].g * alpha_blend;
 		beat_tunnel_image[i].b = beat_tunnel_image_prev[i].b * alpha_blend;
@@ -758,7 +667,7 @@ void draw_beat_tunnel(float time, const PatternParameters& params) {
 
 	if (!AUDIO_IS_AVAILABLE()) {
 		// Fallback: simple animated pattern using palette system
-		for (int i = 0; i < NUM_LEDS; i++) {
+		for (int i = 0; i < STRIP_HALF_LENGTH; i++) {
 			float led_pos = LED_PROGRESS(i);
 			float distance = fabsf(led_pos - position);
 			float brightness = expf(-(distance * distance) / (2.0f * 0.08f * 0.08f));
@@ -775,10 +684,11 @@ void draw_beat_tunnel(float time, const PatternParameters& params) {
 		// Audio-reactive: render tempo bins with per-bin phase/magnitude (EMOTISCOPE PROPER ARCHITECTURE)
 
 		// Render each tempo bin individually with phase synchronization
-		for (uint16_t i = 0; i < NUM_TEMPI && i < NUM_LEDS; i++) {
+		const uint32_t now_us = (uint32_t)esp_timer_get_time();  // Beat clock instant for all bins
+		for (uint16_t i = 0; i < NUM_TEMPI && i < STRIP_HALF_LENGTH; i++) {
 			// Get per-tempo-bin data from audio snapshot
 			float magnitude = AUDIO_TEMPO_MAGNITUDE(i);
-			float phase = AUDIO_TEMPO_PHASE(i);
+			float phase = AUDIO_TEMPO_PHASE_AT(i, now_us);
 
 			// Convert phase (radians) to normalized 0.0-1.0 value
 			// phase ranges from -PI to PI, normalize to 0.0-1.0
@@ -815,24 +725,19 @@ void draw_beat_tunnel(float time, const PatternParameters& params) {
 	}
 
 	// Clamp values to [0, 1]
-	for (int i = 0; i < NUM_LEDS; i++) {
+	for (int i = 0; i < STRIP_HALF_LENGTH; i++) {
 		beat_tunnel_image[i].r = fmaxf(0.0f, fminf(1.0f, beat_tunnel_image[i].r));
 		beat_tunnel_image[i].g = fmaxf(0.0f, fminf(1.0f, beat_tunnel_image[i].g));
 		beat_tunnel_image[i].b = fmaxf(0.0f, fminf(1.0f, beat_tunnel_image[i].b));
 	}
 
-	// Apply mirror mode
-	apply_mirror_mode(beat_tunnel_image, true);
-
-	// Copy tunnel image to LED output and apply brightness
-	for (int i = 0; i < NUM_LEDS; i++) {
-		leds[i].r = beat_tunnel_image[i].r * params.brightness;
-		leds[i].g = beat_tunnel_image[i].g * params.brightness;
-		leds[i].b = beat_tunnel_image[i].b * params.brightness;
+	// Copy tunnel image to the center-origin half strip (edge-first to center-first)
+	for (int i = 0; i < STRIP_HALF_LENGTH; i++) {
+		leds_half[STRIP_HALF_LENGTH - 1 - i] = beat_tunnel_image[i];
 	}
 
 	// Save current frame for next iteration's motion blur
-	for (int i = 0; i < NUM_LEDS; i++) {
+	for (int i = 0; i < STRIP_HALF_LENGTH; i++) {
 		beat_tunnel_image_prev[i] = beat_tunnel_image[i];
 	}
 }
@@ -925,9 +830,9 @@ void draw_perlin(float time, const PatternParameters& params) {
 
 		CRGBF color = color_from_palette(params.palette_id, hue, brightness);
 
-		leds[i].r = color.r * params.brightness * params.saturation;
-		leds[i].g = color.g * params.brightness * params.saturation;
-		leds[i].b = color.b * params.brightness * params.saturation;
+		leds[i].r = color.r * params.saturation;
+		leds[i].g = color.g * params.saturation;
+		leds[i].b = color.b * params.saturation;
 	}
 }
 
@@ -955,7 +860,7 @@ static void_ripple void_ripples[MAX_VOID_RIPPLES];
 void void_render_fade_to_black(float time, const PatternParameters& params) {
 	PATTERN_AUDIO_START();
 
-	float vu_level = AUDIO_IS_AVAILABLE() ? AUDIO_VU : 0.0f;
+	float vu_level = AUDIO_IS_AVAILABLE() ? AUDIO_VU_INTERP : 0.0f;
 	float freshness = AUDIO_IS_AVAILABLE() && !AUDIO_IS_STALE() ? 1.0f : 0.5f;
 
 	// Decay rate: high VU = slow fade (persist), low VU = fast fade (clear)
@@ -999,9 +904,6 @@ void void_render_fade_to_black(float time, const PatternParameters& params) {
 		void_trail_frame_current[i].g = fmaxf(0.0f, fminf(1.0f, void_trail_frame_current[i].g));
 		void_trail_frame_current[i].b = fmaxf(0.0f, fminf(1.0f, void_trail_frame_current[i].b));
 		leds[i] = void_trail_frame_current[i];
-		leds[i].r *= params.brightness;
-		leds[i].g *= params.brightness;
-		leds[i].b *= params.brightness;
 	}
 
 	// Save for next frame
@@ -1014,7 +916,7 @@ void void_render_fade_to_black(float time, const PatternParameters& params) {
 void void_render_ripple_diffusion(float time, const PatternParameters& params) {
 	PATTERN_AUDIO_START();
 
-	float vu_level = AUDIO_IS_AVAILABLE() ? AUDIO_VU : 0.0f;
+	float vu_level = AUDIO_IS_AVAILABLE() ? AUDIO_VU_INTERP : 0.0f;
 
 	// Clear frame
 	for (int i = 0; i < NUM_LEDS; i++) {
@@ -1074,11 +976,11 @@ void void_render_ripple_diffusion(float time, const PatternParameters& params) {
 		}
 	}
 
-	// Apply brightness and saturation
+	// Apply saturation
 	for (int i = 0; i < NUM_LEDS; i++) {
-		leds[i].r *= params.brightness * params.saturation;
-		leds[i].g *= params.brightness * params.saturation;
-		leds[i].b *= params.brightness * params.saturation;
+		leds[i].r *= params.saturation;
+		leds[i].g *= params.saturation;
+		leds[i].b *= params.saturation;
 	}
 }
 
@@ -1086,7 +988,7 @@ void void_render_ripple_diffusion(float time, const PatternParameters& params) {
 void void_render_flowing_stream(float time, const PatternParameters& params) {
 	PATTERN_AUDIO_START();
 
-	float vu_level = AUDIO_IS_AVAILABLE() ? AUDIO_VU : 0.3f;
+	float vu_level = AUDIO_IS_AVAILABLE() ? AUDIO_VU_INTERP : 0.3f;
 	float freshness = AUDIO_IS_AVAILABLE() && !AUDIO_IS_STALE() ? 1.0f : 0.7f;
 
 	// Wave properties controlled by audio and parameters
@@ -1111,9 +1013,9 @@ void void_render_flowing_stream(float time, const PatternParameters& params) {
 		if (brightness > 0.01f) {
 			float hue = fmodf(led_pos + time * 0.05f * params.speed, 1.0f);
 			CRGBF color = color_from_palette(params.palette_id, hue, brightness);
-			leds[i].r = color.r * params.brightness * params.saturation;
-			leds[i].g = color.g * params.brightness * params.saturation;
-			leds[i].b = color.b * params.brightness * params.saturation;
+			leds[i].r = color.r * params.saturation;
+			leds[i].g = color.g * params.saturation;
+			leds[i].b = color.b * params.saturation;
 		} else {
 			leds[i] = CRGBF(0.0f, 0.0f, 0.0f);
 		}
@@ -1171,7 +1073,7 @@ void draw_analog(float time, const PatternParameters& params) {
     }
     
     // Get VU level and apply smoothing
-    float vu_level = AUDIO_VU;
+    float vu_level = AUDIO_VU_INTERP;
     float freshness_factor = AUDIO_IS_STALE() ? 0.7f : 1.0f;
     vu_level *= freshness_factor;
     
@@ -1197,13 +1099,6 @@ void draw_analog(float time, const PatternParameters& params) {
         // Single dot mode
         draw_dot(leds, NUM_RESERVED_DOTS + 0, dot_color, dot_pos, 1.0f);
     }
-    
-    // Apply global brightness
-    for (int i = 0; i < NUM_LEDS; i++) {
-        leds[i].r *= params.brightness;
-        leds[i].g *= params.brightness;
-        leds[i].b *= params.brightness;
-    }
 }
 
 /**
@@ -1240,10 +1135,11 @@ void draw_metronome(float time, const PatternParameters& params) {
     
     // Limit to first 8 tempo bins for visibility
     int max_tempo_bins = fminf(8, NUM_TEMPI);
+    const uint32_t now_us = (uint32_t)esp_timer_get_time();  // Beat clock instant for all bins
     
     for (int tempo_bin = 0; tempo_bin < max_tempo_bins; tempo_bin++) {
         float magnitude = AUDIO_TEMPO_MAGNITUDE(tempo_bin);
-        float phase = AUDIO_TEMPO_PHASE(tempo_bin);
+        float phase = AUDIO_TEMPO_PHASE_AT(tempo_bin, now_us);
         
         // Only render if magnitude is significant
         if (magnitude > 0.05f) {
@@ -1272,13 +1168,6 @@ void draw_metronome(float time, const PatternParameters& params) {
             }
         }
     }
-    
-    // Apply global brightness
-    for (int i = 0; i < NUM_LEDS; i++) {
-        leds[i].r *= params.brightness;
-        leds[i].g *= params.brightness;
-        leds[i].b *= params.brightness;
-    }
 }
 
 /**
@@ -1367,13 +1256,6 @@ void draw_hype(float time, const PatternParameters& params) {
         draw_dot(leds, NUM_RESERVED_DOTS + 2, dot_color_odd, beat_sum_odd, opacity);
         draw_dot(leds, NUM_RESERVED_DOTS + 3, dot_color_even, beat_sum_even, opacity);
     }
-    
-    // Apply global brightness
-    for (int i = 0; i < NUM_LEDS; i++) {
-        leds[i].r *= params.brightness;
-        leds[i].g *= params.brightness;
-        leds[i].b *= params.brightness;
-    }
 }
 
 // ============================================================================
@@ -1387,6 +1269,8 @@ const PatternInfo g_pattern_registry[] = {
 		"departure",
 		"Transformation: earth → light → growth",
 		draw_departure,
+		false,
+		true,
 		false
 	},
 	{
@@ -1394,6 +1278,8 @@ const PatternInfo g_pattern_registry[] = {
 		"lava",
 		"Intensity: black → red → orange → white",
 		draw_lava,
+		false,
+		true,
 		false
 	},
 	{
@@ -1401,6 +1287,8 @@ const PatternInfo g_pattern_registry[] = {
 		"twilight",
 		"Peace: amber → purple → blue",
 		draw_twilight,
+		false,
+		true,
 		false
 	},
 	// Domain 2: Audio-Reactive Patterns
@@ -1409,20 +1297,26 @@ const PatternInfo g_pattern_registry[] = {
 		"spectrum",
 		"Frequency visualization",
 		draw_spectrum,
-		true
+		true,
+		true,
+		false
 	},
 	{
 		"Octave",
 		"octave",
 		"Octave band response",
 		draw_octave,
-		true
+		true,
+		true,
+		false
 	},
 	{
 		"Bloom",
 		"bloom",
 		"VU-meter with persistence",
 		draw_bloom,
+		true,
+		false,
 		true
 	},
 	// Domain 3: Beat/Tempo Reactive Patterns (Ported from Emotiscope)
@@ -1431,6 +1325,8 @@ const PatternInfo g_pattern_registry[] = {
 		"pulse",
 		"Beat-synchronized radial waves",
 		draw_pulse,
+		true,
+		true,
 		true
 	},
 	{
@@ -1438,6 +1334,8 @@ const PatternInfo g_pattern_registry[] = {
 		"tempiscope",
 		"Tempo visualization with phase",
 		draw_tempiscope,
+		true,
+		false,
 		true
 	},
 	{
@@ -1445,6 +1343,8 @@ const PatternInfo g_pattern_registry[] = {
 		"beat_tunnel",
 		"Animated tunnel with beat persistence",
 		draw_beat_tunnel,
+		true,
+		true,
 		true
 	},
 	{
@@ -1452,6 +1352,8 @@ const PatternInfo g_pattern_registry[] = {
 		"perlin",
 		"Procedural noise field animation",
 		draw_perlin,
+		false,
+		false,
 		false
 	},
 	{
@@ -1459,6 +1361,8 @@ const PatternInfo g_pattern_registry[] = {
 		"void_trail",
 		"Ambient audio-responsive with 3 switchable modes (custom_param_1)",
 		draw_void_trail,
+		true,
+		false,
 		true
 	},
 	// Missing Emotiscope Patterns (Now Fixed!)
@@ -1467,13 +1371,17 @@ const PatternInfo g_pattern_registry[] = {
 		"analog",
 		"VU meter with precise dot positioning",
 		draw_analog,
-		true
+		true,
+		false,
+		false
 	},
 	{
 		"Metronome",
 		"metronome",
 		"Beat phase dots for tempo visualization",
 		draw_metronome,
+		true,
+		false,
 		true
 	},
 	{
@@ -1481,6 +1389,8 @@ const PatternInfo g_pattern_registry[] = {
 		"hype",
 		"Energy threshold activation with dual colors",
 		draw_hype,
+		true,
+		false,
 		true
 	}
 };
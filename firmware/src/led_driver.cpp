@@ -13,9 +13,15 @@
 // Mutable brightness control (0.0 = off, 1.0 = full brightness)
 float global_brightness = 0.3f;  // Start at 30% to avoid retina damage
 
-// 8-bit color output buffer (540 bytes for 180 LEDs × 3 channels)
+// 8-bit color output buffers (540 bytes each for 180 LEDs × 3 channels)
 // Must be accessible from inline transmit_leds() function in header
-uint8_t raw_led_data[NUM_LEDS * 3];
+uint8_t raw_led_data[LED_OUTPUT_BUFFERS][NUM_LEDS * 3];
+uint8_t raw_led_buffer_next = 0;
+SemaphoreHandle_t led_buffers_free = NULL;
+
+// Output stage: gamma curve built by init_rmt_driver()
+led_output_stage led_output;
+render_stage render_frame;
 
 // RMT peripheral handles
 rmt_channel_handle_t tx_chan = NULL;
@@ -37,6 +43,14 @@ static const char *TAG = "led_encoder";
 // STATIC HELPER FUNCTIONS
 // ============================================================================
 
+// RMT ISR: a transaction finished, so the oldest queued buffer can be rewritten
+// (transactions complete in queue order, the order transmit_leds() rotates in)
+static bool IRAM_ATTR on_led_transmit_done(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t *edata, void *user_ctx) {
+	BaseType_t task_woken = pdFALSE;
+	xSemaphoreGiveFromISR(led_buffers_free, &task_woken);
+	return task_woken == pdTRUE;
+}
+
 static esp_err_t rmt_del_led_strip_encoder(rmt_encoder_t *encoder) {
 	rmt_led_strip_encoder_t *led_encoder = __containerof(encoder, rmt_led_strip_encoder_t, base);
 	rmt_del_encoder(led_encoder->bytes_encoder);
@@ -91,12 +105,14 @@ esp_err_t rmt_new_led_strip_encoder(const led_strip_encoder_config_t *config, rm
 
 void init_rmt_driver() {
     printf("init_rmt_driver\n");
+	led_output_init(led_output, LED_OUTPUT_GAMMA);
+
     rmt_tx_channel_config_t tx_chan_config = {
         .gpio_num = (gpio_num_t)LED_DATA_PIN,  // GPIO number
         .clk_src = RMT_CLK_SRC_DEFAULT,        // default source clock
         .resolution_hz = 20000000,             // 20 MHz tick resolution (1 tick = 0.05us)
         .mem_block_symbols = 64,               // 64 * 4 = 256 bytes
-        .trans_queue_depth = 4,                // pending transactions depth
+        .trans_queue_depth = LED_TRANSMIT_QUEUE_DEPTH,   // pending transactions depth
         .intr_priority = 99,
         .flags = { .with_dma = 1 },            // DMA enabled to reduce ISR pressure
     };
@@ -111,8 +127,16 @@ void init_rmt_driver() {
 	printf("rmt_new_led_strip_encoder\n");
 	ESP_ERROR_CHECK(rmt_new_led_strip_encoder(&encoder_config, &led_encoder));
 
+	// Output buffer rotation (see transmit_leds): all free until the first frame is queued
+	led_buffers_free = xSemaphoreCreateCounting(LED_OUTPUT_BUFFERS, LED_OUTPUT_BUFFERS);
+	rmt_tx_event_callbacks_t tx_callbacks = {
+		.on_trans_done = on_led_transmit_done,
+	};
+	ESP_ERROR_CHECK(rmt_tx_register_event_callbacks(tx_chan, &tx_callbacks, NULL));
+
 	printf("rmt_enable\n");
 	ESP_ERROR_CHECK(rmt_enable(tx_chan));
 }
 
 // Note: quantize_color() is defined inline in led_driver.h (required for compiler inlining)
+// and does its work in led_output_quantize() (led_output.h)
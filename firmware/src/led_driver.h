@@ -2,6 +2,8 @@
 
 #include <Arduino.h>
 #include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 // Prefer ESP-IDF v5 split RMT headers; fall back gracefully for editor tooling
 #if __has_include(<driver/rmt_tx.h>)
@@ -56,8 +58,10 @@
 #  define pdMS_TO_TICKS(x) (x)
 #endif
 #include "types.h"
+#include "led_output.h"
+#include "render_stage.h"
 #include "profiler.h"
-#include "parameters.h"  // Access get_params() for dithering flag
+#include "parameters.h"  // Access get_params() for dithering and warmth
 #include "logging/logger.h"
 
 #define LED_DATA_PIN ( 5 )
@@ -72,9 +76,16 @@
 #define STRIP_HALF_LENGTH ( 90 )    // Distance from center to each edge
 #define STRIP_LENGTH ( 180 )        // Total span (must equal NUM_LEDS)
 
+static_assert(STRIP_LENGTH == RENDER_STRIP_LENGTH && STRIP_HALF_LENGTH == RENDER_HALF_LENGTH,
+              "render_stage.h mirrors about the strip centre");
+
 // 32-bit color input
 extern CRGBF leds[NUM_LEDS];
 
+// Centre-origin patterns (PatternInfo::renders_half) draw here instead of leds[]:
+// [0] beside the centre, [STRIP_HALF_LENGTH - 1] at both edges; finish_frame() mirrors it
+extern CRGBF leds_half[STRIP_HALF_LENGTH];
+
 // Global brightness control (0.0 = off, 1.0 = full brightness)
 // Implementation in led_driver.cpp
 extern float global_brightness;
@@ -100,9 +111,18 @@ typedef struct {
 extern rmt_led_strip_encoder_t strip_encoder;
 extern rmt_transmit_config_t tx_config;
 
-// 8-bit color output buffer (accessible from inline transmit_leds)
+// 8-bit color output buffers (accessible from inline transmit_leds)
+// They rotate through the RMT queue: frame N+1 is rendered and quantized while
+// frame N is still on the wire, and a buffer is rewritten only after the
+// transaction reading it has completed (led_buffers_free, given by the RMT ISR)
 // Implementation in led_driver.cpp
-extern uint8_t raw_led_data[NUM_LEDS * 3];
+#define LED_TRANSMIT_QUEUE_DEPTH 4           // trans_queue_depth of the RMT channel
+#define LED_OUTPUT_BUFFERS 2                 // Each adds up to one frame (~5.6 ms) of queueing latency
+static_assert(LED_OUTPUT_BUFFERS <= LED_TRANSMIT_QUEUE_DEPTH, "rmt_transmit() must never block on a full queue");
+
+extern uint8_t raw_led_data[LED_OUTPUT_BUFFERS][NUM_LEDS * 3];
+extern uint8_t raw_led_buffer_next;          // Buffer the next frame is quantized into
+extern SemaphoreHandle_t led_buffers_free;   // Counts buffers no queued transaction is reading
 
 IRAM_ATTR static size_t rmt_encode_led_strip(rmt_encoder_t *encoder, rmt_channel_handle_t channel, const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state){
     rmt_led_strip_encoder_t *led_encoder = __containerof(encoder, rmt_led_strip_encoder_t, base);
@@ -147,61 +167,42 @@ out:
 // Implementation in led_driver.cpp
 void init_rmt_driver();
 
-// Quantize floating-point colors to 8-bit with optional dithering
+// Output stage (see led_output.h): gamma curve, brightness and warmth
+// Implementation in led_driver.cpp
+extern led_output_stage led_output;
+static_assert(sizeof(CRGBF) == 3 * sizeof(float), "led_output_quantize() reads leds[] as packed floats");
+static_assert(NUM_LEDS <= LED_OUTPUT_MAX_LEDS, "sigma-delta residuals cover every LED");
+
+// Quantize floating-point colors to 8-bit GRB with optional dithering
+// Writes every byte of `out` (NUM_LEDS * 3); global_brightness is applied here, once
 // INLINE FUNCTION: definition must be in header for compiler inlining
-inline void quantize_color(bool temporal_dithering) {
+inline void quantize_color(led_dither_mode dither, float warmth, uint8_t* out) {
 	uint32_t t0 = micros();
-	if (temporal_dithering == true) {
-		const float dither_table[4] = {0.25, 0.50, 0.75, 1.00};
-		static uint8_t dither_step = 0;
-		dither_step++;
-
-		float decimal_r; float decimal_g; float decimal_b;
-		uint8_t whole_r; uint8_t whole_g; uint8_t whole_b;
-		float   fract_r; float   fract_g; float   fract_b;
-
-		for (uint16_t i = 0; i < NUM_LEDS; i++) {
-			// RED channel
-			decimal_r = leds[i].r * global_brightness * 254;
-			whole_r = decimal_r;
-			fract_r = decimal_r - whole_r;
-			raw_led_data[3*i+1] = whole_r + (fract_r >= dither_table[(dither_step) % 4]);
-
-			// GREEN channel
-			decimal_g = leds[i].g * global_brightness * 254;
-			whole_g = decimal_g;
-			fract_g = decimal_g - whole_g;
-			raw_led_data[3*i+0] = whole_g + (fract_g >= dither_table[(dither_step) % 4]);
-
-			// BLUE channel
-			decimal_b = leds[i].b * global_brightness * 254;
-			whole_b = decimal_b;
-			fract_b = decimal_b - whole_b;
-			raw_led_data[3*i+2] = whole_b + (fract_b >= dither_table[(dither_step) % 4]);
-		}
-	}
-	else {
-		for (uint16_t i = 0; i < NUM_LEDS; i++) {
-			raw_led_data[3*i+1] = (uint8_t)(leds[i].r * global_brightness * 255);
-			raw_led_data[3*i+0] = (uint8_t)(leds[i].g * global_brightness * 255);
-			raw_led_data[3*i+2] = (uint8_t)(leds[i].b * global_brightness * 255);
-		}
+	if (led_output.brightness != global_brightness || led_output.warmth != warmth) {
+		led_output_set_levels(led_output, global_brightness, warmth);
 	}
+	led_output_quantize(led_output, &leds[0].r, NUM_LEDS, dither, out);
 	ACCUM_QUANTIZE_US += (micros() - t0);
 }
 
+// Render stage (see render_stage.h): mirroring, clamping and softness after every pattern
+// Implementation in led_driver.cpp
+extern render_stage render_frame;
+
+// Pattern output to leds[]: leds_half[] mirrored when `half`, else leds[] in place
+inline void finish_frame(bool half, float softness) {
+	render_stage_finish(render_frame, half ? leds_half : leds, half, softness, leds);
+}
+
 // IRAM_ATTR function must be in header for memory placement
 // Made static to ensure internal linkage (each TU gets its own copy)
 IRAM_ATTR static inline void transmit_leds() {
-    // Wait here if previous frame transmission has not yet completed
-    // Use 10ms timeout for RMT completion
-    // If TX takes longer than 10ms, something is wrong (normal is <1ms)
+    // Wait only while every output buffer is queued or on the wire
+    // 180 LEDs @ ~30us/LED ≈ 5.4ms + reset per frame; 30ms gives margin under load
     uint32_t t_wait0 = micros();
-    // Increase timeout to be safely above worst-case frame time and scheduler jitter
-    // 180 LEDs @ ~30us/LED ≈ 5.4ms + reset; 20-30ms gives margin under load
-    esp_err_t wait_result = rmt_tx_wait_all_done(tx_chan, pdMS_TO_TICKS(30));
+    BaseType_t buffer_free = xSemaphoreTake(led_buffers_free, pdMS_TO_TICKS(30));
     ACCUM_RMT_WAIT_US += (micros() - t_wait0);
-    if (wait_result != ESP_OK) {
+    if (buffer_free != pdTRUE) {
         // RMT transmission timeout: skip this frame to let hardware catch up
         // Rate-limit warning to avoid log spam
         static uint32_t last_warn_ms = 0;
@@ -212,22 +213,28 @@ IRAM_ATTR static inline void transmit_leds() {
         }
         return;
     }
-
-	// Clear the 8-bit buffer
-	memset(raw_led_data, 0, NUM_LEDS*3);
+    uint8_t* frame = raw_led_data[raw_led_buffer_next];
 
 	// Quantize the floating point color to 8-bit with dithering
 	//
 	// This allows the 8-bit LEDs to emulate the look of a higher bit-depth using persistence of vision tricks
 	// The contents of the floating point CRGBF "leds" array are downsampled into alternating ways hundreds of
 	// times per second to increase the effective bit depth
-	bool temporal_dithering = (get_params().dithering >= 0.5f);
-	quantize_color(temporal_dithering);
+	const PatternParameters& params = get_params();
+	// params.dithering: below 0.25 off, below 0.75 the ordered 4-frame cycle, above that sigma-delta
+	const led_dither_mode dither = params.dithering < 0.25f ? LED_DITHER_OFF
+	                             : (params.dithering < 0.75f ? LED_DITHER_ORDERED : LED_DITHER_SIGMA_DELTA);
+	quantize_color(dither, params.warmth, frame);
 
-	// Transmit to LEDs
+	// Queue for transmission; starts on the wire once the previous frame has gone out
 	uint32_t t_tx0 = micros();
-    esp_err_t tx_ret = rmt_transmit(tx_chan, led_encoder, raw_led_data, NUM_LEDS*3, &tx_config);
-    if (tx_ret != ESP_OK) {
+	LED_TRANSMIT_START_US = (uint32_t)esp_timer_get_time();   // Photon end of the latency chain
+    esp_err_t tx_ret = rmt_transmit(tx_chan, led_encoder, frame, NUM_LEDS*3, &tx_config);
+    if (tx_ret == ESP_OK) {
+        raw_led_buffer_next = (raw_led_buffer_next + 1) % LED_OUTPUT_BUFFERS;
+    }
+    else {
+        xSemaphoreGive(led_buffers_free);   // Never queued: no completion will return it
         static uint32_t last_err_ms = 0;
         uint32_t now_ms = millis();
         if (now_ms - last_err_ms > 1000) {
@@ -0,0 +1,177 @@
+// -----------------------------------------------------------------
+// LED Output Stage - CRGBF frame to WS2812 GRB bytes in one pass
+//
+// Pattern colours are perceptual levels (0.0-1.0). The stage maps each
+// channel through a 12-bit gamma curve to LED drive (PWM duty), with
+// brightness and the warmth (incandescent) filter folded into the lookup:
+//
+//     drive = curve[v * scale[c]]        scale[c] = (LED_CURVE_SIZE - 1) * brightness * warmth_gain[c]^(1 / gamma)
+//
+// Because the curve is a power law, scaling the index is the same as
+// scaling the drive by brightness^gamma * warmth_gain[c], so the curve is
+// built once and a brightness or warmth change only recomputes three
+// floats: no rebuild while a slider is dragged. Brightness is applied in
+// perceptual space (half the slider looks about half as bright); warmth is
+// a per-channel attenuation in linear light.
+//
+// Curve entries are Q8.16 drive levels (0 - 255.0), so the quantizer keeps
+// the fraction for dithering; at gamma 2.2 the dim end of the curve needs
+// those 16 bits (the lowest nonzero entries are under 1/256 of a step). The
+// conversion is a flat, branch-free loop over the frame's floats: one
+// multiply, a round to the nearest index, an integer clamp and a table
+// load per channel.
+//
+// Sigma-delta dithering keeps a 16-bit residual per LED and channel: each
+// frame sends floor(drive + residual) and carries the 16-bit fraction, so
+// the time average of every channel converges on its Q8.16 drive instead
+// of the 2 bits of the ordered 4-frame cycle. Residuals start on a
+// golden-ratio sequence over the strip, so LEDs showing the same level
+// step up on different frames rather than flashing together.
+//
+// A drive of d steps below one lights for one frame in every 1/d, so the
+// pulse rate is d * FPS: 25 Hz for 1/6 step at 150 FPS, 2.3 Hz for 1/64.
+// Nothing is clipped by default; builds for installs where those slow
+// pulses show can set LED_DITHER_FLOOR_STEPS to send drives under it as off
+// (test_native_led_output prints the pulse rate per level).
+
+#ifndef LED_OUTPUT_H
+#define LED_OUTPUT_H
+
+#include <stdint.h>
+#include <math.h>
+
+#define LED_CURVE_BITS 12
+#define LED_CURVE_SIZE (1 << LED_CURVE_BITS)
+#define LED_DRIVE_SHIFT 16
+#define LED_DRIVE_ONE (1u << LED_DRIVE_SHIFT)    // Q8.16: one 8-bit output step
+#define LED_DRIVE_MAX (255 * LED_DRIVE_ONE)
+#define LED_OUTPUT_MAX_LEDS 180              // Residual storage (NUM_LEDS)
+#define LED_DITHER_PHASE_STEP 40503          // 65536 / golden ratio: residual offset between channels
+
+// Sigma-delta drives under this many steps are sent as off; 0 keeps every level
+#ifndef LED_DITHER_FLOOR_STEPS
+#define LED_DITHER_FLOOR_STEPS 0.0f
+#endif
+#define LED_DITHER_FLOOR ((uint32_t)(LED_DITHER_FLOOR_STEPS * LED_DRIVE_ONE))
+
+// Perceptual level to LED drive exponent; 1.0 restores linear output
+#ifndef LED_OUTPUT_GAMMA
+#define LED_OUTPUT_GAMMA 2.2f
+#endif
+
+// Warmth 1.0: channel gains of an incandescent bulb against white
+static const float LED_INCANDESCENT_GAIN[3] = {1.0000f, 0.4453f, 0.1562f};
+
+typedef enum {
+	LED_DITHER_OFF = 0,                      // Round to the nearest step
+	LED_DITHER_ORDERED,                      // 4-frame threshold cycle shared by every LED
+	LED_DITHER_SIGMA_DELTA,                  // Per-LED error feedback, decorrelated phase
+} led_dither_mode;
+
+typedef struct {
+	uint32_t curve[LED_CURVE_SIZE];          // Perceptual level (12-bit) -> drive, Q8.16
+	float gamma;
+	float scale[3];                          // Index scale per channel (r, g, b)
+	float brightness;                        // Levels the scales were computed for (as requested)
+	float warmth;
+	uint8_t frame;                           // Dither cycle position
+	uint16_t residual[LED_OUTPUT_MAX_LEDS * 3];   // Sigma-delta carry per channel, 16-bit fraction of a step (GRB order)
+} led_output_stage;
+
+// Curve index of a channel value: rounded to nearest (+0.5, then convert) and clamped
+inline int32_t led_output_index(float value, float scale) {
+	int32_t index = (int32_t)(value * scale + 0.5f);
+	return index < 0 ? 0 : (index > LED_CURVE_SIZE - 1 ? LED_CURVE_SIZE - 1 : index);
+}
+
+// Restart the sigma-delta residuals on their spatial phase pattern
+inline void led_output_reset_dither(led_output_stage& stage) {
+	for (uint32_t k = 0; k < LED_OUTPUT_MAX_LEDS * 3; k++) {
+		stage.residual[k] = (uint16_t)((k * LED_DITHER_PHASE_STEP) & (LED_DRIVE_ONE - 1));
+	}
+}
+
+// Scales for a brightness / warmth pair (both 0.0-1.0); cheap, call whenever they change
+inline void led_output_set_levels(led_output_stage& stage, float brightness, float warmth) {
+	stage.brightness = brightness;
+	stage.warmth = warmth;
+	brightness = brightness < 0.0f ? 0.0f : (brightness > 1.0f ? 1.0f : brightness);
+	warmth = warmth < 0.0f ? 0.0f : (warmth > 1.0f ? 1.0f : warmth);
+	for (uint8_t c = 0; c < 3; c++) {
+		const float gain = 1.0f - warmth * (1.0f - LED_INCANDESCENT_GAIN[c]);
+		stage.scale[c] = (LED_CURVE_SIZE - 1) * brightness * powf(gain, 1.0f / stage.gamma);
+	}
+}
+
+// Builds the curve (LED_CURVE_SIZE powf calls: boot time, not per frame)
+inline void led_output_init(led_output_stage& stage, float gamma) {
+	stage.gamma = gamma;
+	for (uint32_t i = 0; i < LED_CURVE_SIZE; i++) {
+		const float drive = LED_DRIVE_MAX * powf(i / (float)(LED_CURVE_SIZE - 1), gamma);
+		stage.curve[i] = (uint32_t)(drive + 0.5f);
+	}
+	stage.frame = 0;
+	led_output_reset_dither(stage);
+	led_output_set_levels(stage, 1.0f, 0.0f);
+}
+
+// Q8.16 drive of one channel value; out-of-range values clamp to the curve ends
+inline uint32_t led_output_drive(const led_output_stage& stage, float value, uint8_t channel) {
+	return stage.curve[led_output_index(value, stage.scale[channel])];
+}
+
+// One sigma-delta step: the byte to send for `drive`, carrying the rest in `residual`
+// drive + residual stays below 256.0 (drive <= 255.0, residual < 1.0), so the byte never passes 255
+// Under LED_DITHER_FLOOR the drive counts as 0: nothing is sent and the residual, kept, holds the phase
+inline uint8_t led_sigma_delta(uint32_t drive, uint16_t& residual) {
+	const uint32_t sum = (drive < LED_DITHER_FLOOR ? 0 : drive) + residual;
+	residual = (uint16_t)(sum & (LED_DRIVE_ONE - 1));
+	return (uint8_t)(sum >> LED_DRIVE_SHIFT);
+}
+
+// `count` RGB float triplets (CRGBF layout) to GRB bytes
+inline void led_output_quantize(led_output_stage& stage, const float* rgb, uint16_t count,
+                                led_dither_mode mode, uint8_t* grb) {
+	const float scale_r = stage.scale[0];
+	const float scale_g = stage.scale[1];
+	const float scale_b = stage.scale[2];
+	const uint32_t* curve = stage.curve;
+
+	if (mode == LED_DITHER_SIGMA_DELTA) {
+		uint16_t* residual = stage.residual;
+		count = count > LED_OUTPUT_MAX_LEDS ? LED_OUTPUT_MAX_LEDS : count;
+		for (uint16_t i = 0; i < count; i++) {
+			const uint32_t r = curve[led_output_index(rgb[3 * i + 0], scale_r)];
+			const uint32_t g = curve[led_output_index(rgb[3 * i + 1], scale_g)];
+			const uint32_t b = curve[led_output_index(rgb[3 * i + 2], scale_b)];
+			grb[3 * i + 0] = led_sigma_delta(g, residual[3 * i + 0]);
+			grb[3 * i + 1] = led_sigma_delta(r, residual[3 * i + 1]);
+			grb[3 * i + 2] = led_sigma_delta(b, residual[3 * i + 2]);
+		}
+		return;
+	}
+
+	// Ordered dither: add one step when the fraction reaches this frame's threshold
+	// (LED_DRIVE_ONE on the fourth frame: never); rounding when off
+	static const uint32_t thresholds[4] = {LED_DRIVE_ONE / 4, LED_DRIVE_ONE / 2, LED_DRIVE_ONE * 3 / 4, LED_DRIVE_ONE};
+	uint32_t threshold = LED_DRIVE_ONE / 2;
+	uint32_t bias = LED_DRIVE_ONE / 2;
+	if (mode == LED_DITHER_ORDERED) {
+		threshold = thresholds[stage.frame++ & 3];
+		bias = LED_DRIVE_ONE - threshold;
+	}
+
+	for (uint16_t i = 0; i < count; i++) {
+		const int32_t r = led_output_index(rgb[3 * i + 0], scale_r);
+		const int32_t g = led_output_index(rgb[3 * i + 1], scale_g);
+		const int32_t b = led_output_index(rgb[3 * i + 2], scale_b);
+
+		// (drive + bias) >> 16 steps up exactly when the fraction is >= threshold;
+		// the top entry has no fraction, so the sum never passes 255
+		grb[3 * i + 0] = (uint8_t)((curve[g] + bias) >> LED_DRIVE_SHIFT);
+		grb[3 * i + 1] = (uint8_t)((curve[r] + bias) >> LED_DRIVE_SHIFT);
+		grb[3 * i + 2] = (uint8_t)((curve[b] + bias) >> LED_DRIVE_SHIFT);
+	}
+}
+
+#endif  // LED_OUTPUT_H
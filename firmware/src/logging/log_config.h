@@ -73,7 +73,7 @@
 #define LOG_MESSAGE_BUFFER_SIZE 256   // Max message size (formatted output)
 #define LOG_FORMAT_BUFFER_SIZE  512   // Temporary buffer for formatting
 #define LOG_MUTEX_WAIT_MS       20    // FreeRTOS mutex timeout (increased to reduce edge case timeouts)
-#define LOG_MAX_TIMESTAMP_LEN   12    // "HHHMMSS.mmm" + null
+#define LOG_MAX_TIMESTAMP_LEN   13    // "HH:MM:SS.mmm" + null
 
 // ============================================================================
 // PERFORMANCE TUNING
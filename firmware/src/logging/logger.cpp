@@ -19,7 +19,8 @@ const char* get_timestamp() {
     uint32_t m = (s / 60) % 60;
     uint32_t sec = s % 60;
     uint32_t ms_rem = ms % 1000;
-    snprintf(timestamp_buffer, sizeof(timestamp_buffer), "%02lu:%02lu:%02lu.%03lu", h, m, sec, ms_rem);
+    snprintf(timestamp_buffer, sizeof(timestamp_buffer), "%02u:%02u:%02u.%03u",
+             (unsigned)h, (unsigned)m, (unsigned)sec, (unsigned)ms_rem);
     return timestamp_buffer;
 }
 
@@ -35,6 +35,7 @@
 #include "profiler.h"
 #include "audio/goertzel.h"  // Audio system globals, struct definitions, initialization, DFT computation
 #include "audio/tempo.h"     // Beat detection and tempo tracking pipeline
+#include "audio/audio_frame.h"  // Per-frame analysis sequence
 #include "audio/microphone.h"  // REAL SPH0645 I2S MICROPHONE INPUT
 #include "palettes.h"
 #include "easing_functions.h"
@@ -62,9 +63,10 @@
 
 // Global LED buffer
 CRGBF leds[NUM_LEDS];
+CRGBF leds_half[STRIP_HALF_LENGTH];
 
-// Forward declaration for single-core audio pipeline helper
-static inline void run_audio_pipeline_once();
+// Palette LUTs expanded on first use (palettes.h)
+palette_lut_cache palette_luts;
 
 static bool network_services_started = false;
 
@@ -161,92 +163,101 @@ static inline void send_uart_sync_frame() {}
 #endif
 
 // ============================================================================
-// AUDIO TASK - Runs on Core 1 @ ~100 Hz (audio processing only)
+// AUDIO ANALYSIS - One frame over the chunks ingested so far (audio_frame.h)
 // ============================================================================
-// This function runs on Core 1 and handles all audio processing
-// - Microphone sample acquisition (I2S, blocking - isolated to Core 1)
-// - Goertzel frequency analysis (CPU-intensive)
-// - Chromagram computation (pitch class analysis)
-// - Beat detection and tempo tracking
-// - Lock-free buffer synchronization with Core 0
-void audio_task(void* param) {
-    LOG_INFO(TAG_CORE1, "AUDIO_TASK Starting on Core 1");
-    
-    while (true) {
-        // Process audio chunk (I2S blocking isolated to Core 1)
-        acquire_sample_chunk();        // Blocks on I2S if needed (acceptable here)
-        calculate_magnitudes();        // ~15-25ms Goertzel computation
-        get_chromagram();              // ~1ms pitch aggregation
-
-        // BEAT DETECTION PIPELINE
-        // Calculate spectral novelty as peak energy in current frame
-        float peak_energy = 0.0f;
-        for (int i = 0; i < NUM_FREQS; i++) {
-            peak_energy = fmaxf(peak_energy, audio_back.spectrogram[i]);
-        }
+static void mark_spectral_done(audio_frame_stage finished, void* context) {
+    if (finished == AUDIO_STAGE_PITCH) {
+        *(uint32_t*)context = (uint32_t)esp_timer_get_time();
+    }
+}
 
-        // Update novelty curve with spectral peak
-        update_novelty_curve(peak_energy);
-
-        // Smooth tempo magnitudes and detect beats
-        smooth_tempi_curve();           // ~2-5ms tempo magnitude calculation
-        detect_beats();                 // ~1ms beat confidence calculation
-
-        // SYNC TEMPO CONFIDENCE TO AUDIO SNAPSHOT
-        // Copy calculated tempo_confidence to audio_back so patterns can access it
-        extern float tempo_confidence;  // From tempo.cpp
-        audio_back.tempo_confidence = tempo_confidence;
-
-        // SYNC TEMPO MAGNITUDE AND PHASE ARRAYS
-        // Copy per-tempo-bin magnitude and phase data from tempo calculation to audio snapshot
-        // This enables Tempiscope and Beat_Tunnel patterns to access individual tempo bin data
-        extern tempo tempi[NUM_TEMPI];  // From tempo.cpp (64 tempo hypotheses)
-        for (uint16_t i = 0; i < NUM_TEMPI; i++) {
-            audio_back.tempo_magnitude[i] = tempi[i].magnitude;  // 0.0-1.0 per bin
-            audio_back.tempo_phase[i] = tempi[i].phase;          // -π to +π per bin
-        }
+// capture_us: DMA completion of the newest chunk ingested (0 for a silent frame)
+static inline void run_audio_frame(uint32_t capture_us) {
+    const uint32_t analysis_start_us = (uint32_t)esp_timer_get_time();
+    uint32_t spectral_done_us = analysis_start_us;
+    analyze_audio_frame(capture_us, mark_spectral_done, &spectral_done_us);
+
+    if (capture_us != 0) {
+        latency_histogram_add(LATENCY_HISTOGRAMS[LATENCY_INGEST], analysis_start_us - capture_us);
+        latency_histogram_add(LATENCY_HISTOGRAMS[LATENCY_SPECTRAL], spectral_done_us - analysis_start_us);
+        latency_histogram_add(LATENCY_HISTOGRAMS[LATENCY_TEMPO], audio_front.publish_us - spectral_done_us);
+    }
+}
 
-        // Lock-free buffer synchronization with Core 0
-        finish_audio_frame();          // ~0-5ms buffer swap
+// Close the mic-to-photon chain on the first LED frame that shows each audio
+// frame (the slot the pattern acquired is still held after transmit)
+static void record_render_latency(uint32_t render_start_us) {
+    static uint32_t last_update_counter = 0;
+    const AudioDataSnapshot& audio = audio_snapshots[audio_snapshot_slots.reading];
+    const uint32_t transmit_start_us = LED_TRANSMIT_START_US;
 
-        // Yield to prevent CPU starvation
-        // 1ms yield allows 40-50 Hz audio processing rate
-        vTaskDelay(pdMS_TO_TICKS(1));
+    if (!audio.is_valid || audio.capture_us == 0 || audio.update_counter == last_update_counter) {
+        return;
+    }
+    if ((int32_t)(transmit_start_us - render_start_us) < 0) {
+        return;  // transmit_leds() skipped this frame
     }
+    last_update_counter = audio.update_counter;
+
+    // Published while this frame was already drawing: picked up at once
+    const int32_t pickup_us = (int32_t)(render_start_us - audio.publish_us);
+    latency_histogram_add(LATENCY_HISTOGRAMS[LATENCY_PICKUP], pickup_us > 0 ? (uint32_t)pickup_us : 0);
+    latency_histogram_add(LATENCY_HISTOGRAMS[LATENCY_RENDER], transmit_start_us - render_start_us);
+    latency_histogram_add(LATENCY_HISTOGRAMS[LATENCY_MIC_TO_LED], transmit_start_us - audio.capture_us);
 }
 
 // ============================================================================
-// SINGLE-SHOT AUDIO PIPELINE (used by Core 1 main loop cadence)
+// AUDIO TASK - Runs on Core 1, once per AUDIO_CHUNKS_PER_FRAME chunks (8ms)
 // ============================================================================
-static inline void run_audio_pipeline_once() {
-    // Process audio chunk (I2S blocking isolated to Core 1)
-    acquire_sample_chunk();        // Blocks on I2S if needed (acceptable here)
-    calculate_magnitudes();        // ~15-25ms Goertzel computation
-    get_chromagram();              // ~1ms pitch aggregation
-
-    // BEAT DETECTION PIPELINE
-    float peak_energy = 0.0f;
-    for (int i = 0; i < NUM_FREQS; i++) {
-        peak_energy = fmaxf(peak_energy, audio_back.spectrogram[i]);
-    }
+// This function runs on Core 1 and handles all audio processing
+// - Sleeps until the I2S RX-done callback reports new chunks (no fixed delay)
+// - Microphone sample acquisition (copies chunks already queued by the driver)
+// - Goertzel frequency analysis (CPU-intensive)
+// - Chromagram computation (pitch class analysis)
+// - Beat detection and tempo tracking
+// - Lock-free buffer synchronization with Core 0
+// Overruns, stalls and slack are counted in audio_cadence (see audio_cadence.h)
+// and drive the analysis quality level (audio_governor, see quality_governor.h)
+static_assert(NOVELTY_PERIOD_US == AUDIO_FRAME_US, "tempo bins are labelled for one novelty sample per audio frame");
 
-    update_novelty_curve(peak_energy);
-    smooth_tempi_curve();          // ~2-5ms tempo magnitude calculation
-    detect_beats();                // ~1ms beat confidence calculation
+void audio_task(void* param) {
+    LOG_INFO(TAG_CORE1, "AUDIO_TASK Starting on Core 1");
+    attach_sample_chunk_consumer(xTaskGetCurrentTaskHandle());
+    quality_governor_init(audio_governor);
 
-    // SYNC TEMPO CONFIDENCE TO AUDIO SNAPSHOT
-    extern float tempo_confidence;  // From tempo.cpp
-    audio_back.tempo_confidence = tempo_confidence;
+    while (true) {
+        // Idle until a frame's worth of chunks has arrived
+        uint32_t newest_us = 0;
+        uint32_t found = wait_for_sample_chunks(AUDIO_CHUNKS_PER_FRAME, pdMS_TO_TICKS(AUDIO_CHUNK_TIMEOUT_MS), &newest_us);
+
+        if (found == 0) {
+            // Microphone stalled: keep the analysis decaying on silence
+            audio_cadence.timeouts = audio_cadence.timeouts + 1;
+            acquire_silent_chunk();
+            run_audio_frame(0);
+            continue;
+        }
 
-    // SYNC TEMPO MAGNITUDE AND PHASE ARRAYS
-    extern tempo tempi[NUM_TEMPI];  // From tempo.cpp (64 tempo hypotheses)
-    for (uint16_t i = 0; i < NUM_TEMPI; i++) {
-        audio_back.tempo_magnitude[i] = tempi[i].magnitude;
-        audio_back.tempo_phase[i] = tempi[i].phase;
+        // Ingest every chunk still held by the driver so the history stays
+        // continuous; anything older was dropped by the driver (dma_overruns)
+        uint32_t taken = 0;
+        while (taken < found && acquire_sample_chunk()) {
+            taken++;
+        }
+        consume_sample_chunks(found);
+
+        run_audio_frame(taken > 0 ? newest_us : 0);
+        audio_cadence_frame(audio_cadence, found, taken, AUDIO_CHUNKS_PER_FRAME,
+                            newest_us, (uint32_t)esp_timer_get_time(), AUDIO_FRAME_US);
+
+        // Trade analysis quality for time when Core 1 falls behind (see quality_governor.h)
+        if (quality_governor_frame(audio_governor, audio_cadence.slack_us_last,
+                                   found > AUDIO_CHUNKS_PER_FRAME, AUDIO_FRAME_US)) {
+            const audio_quality quality = audio_quality_for_level(audio_governor.level);
+            set_spectral_quality(quality);
+            set_tempo_quality(quality);
+        }
     }
-
-    // Lock-free buffer synchronization with Core 0
-    finish_audio_frame();
 }
 
 // ============================================================================
@@ -273,11 +284,19 @@ void loop_gpu(void* param) {
         extern float global_brightness;
         global_brightness = params.brightness;
 
-        // Draw current pattern with audio-reactive data (lock-free read from audio_front)
-        draw_current_pattern(time, params);
+        // Draw current pattern with audio-reactive data (zero-copy, see acquire_audio_snapshot())
+        const uint32_t render_start_us = (uint32_t)esp_timer_get_time();
+        uint32_t t_render0 = micros();
+        const PatternInfo& pattern = draw_current_pattern(time, params);
+        finish_frame(pattern.renders_half, pattern.own_persistence ? 0.0f : params.softness);
+        ACCUM_RENDER_US += (micros() - t_render0);
 
         // Transmit to LEDs via RMT (non-blocking DMA)
         transmit_leds();
+        record_render_latency(render_start_us);
+
+        // Send sync packet to s3z secondary device
+        send_uart_sync_frame();
 
         // FPS tracking (minimal overhead)
         watch_cpu_fps();
@@ -298,6 +317,7 @@ void setup() {
     // Initialize LED driver
     LOG_INFO(TAG_LED, "Initializing LED driver...");
     init_rmt_driver();
+    palette_lut_cache_init(palette_luts);
 
     // Initialize UART for s3z daisy chain sync (gated)
 #if ENABLE_UART_SYNC
@@ -367,6 +387,9 @@ void setup() {
     init_window_lookup();
     init_goertzel_constants_musical();
 
+    // Stored noise floor (short probe); without one, no subtraction until calibrated
+    init_noise_profile();
+
     // Initialize tempo detection (beat detection pipeline)
     LOG_INFO(TAG_TEMPO, "Initializing tempo detection...");
     init_tempo_goertzel_constants();
@@ -385,7 +408,7 @@ void setup() {
     // DUAL-CORE ARCHITECTURE ACTIVATION
     // ========================================================================
     // Core 0: GPU rendering task (100+ FPS, never blocks)
-    // Core 1: Audio processing + network (main loop, can block on I2S)
+    // Core 1: Audio processing (woken per I2S chunk) + network (main loop)
     // Synchronization: Lock-free double buffer with sequence counters
     // ========================================================================
     LOG_INFO(TAG_CORE0, "Activating dual-core architecture...");
@@ -438,7 +461,7 @@ void setup() {
     LOG_DEBUG(TAG_GPU, "Stack: 16KB (was 12KB, increased for safety)");
     LOG_INFO(TAG_AUDIO, "Core 1: Audio processing + network");
     LOG_DEBUG(TAG_AUDIO, "Stack: 12KB (was 8KB, increased for safety)");
-    LOG_DEBUG(TAG_SYNC, "Synchronization: Lock-free with sequence counters + memory barriers");
+    LOG_DEBUG(TAG_SYNC, "Synchronization: Lock-free triple buffer + memory barriers");
     LOG_INFO(TAG_CORE0, "Ready!");
     LOG_INFO(TAG_CORE0, "Upload new effects with:");
     LOG_INFO(TAG_CORE0, "pio run -t upload --upload-port %s.local", ArduinoOTA.getHostname());
@@ -458,14 +481,9 @@ void loop() {
     // Handle web server (includes WebSocket cleanup)
     handle_webserver();
 
-    // Run audio processing at fixed cadence to avoid throttling render FPS
-    static uint32_t last_audio_ms = 0;
-    const uint32_t audio_interval_ms = 20; // ~50 Hz audio processing
+    // Audio is paced by the I2S RX callback in audio_task; reading I2S here
+    // as well would steal its chunks
     uint32_t now_ms = millis();
-    if ((now_ms - last_audio_ms) >= audio_interval_ms) {
-        run_audio_pipeline_once();
-        last_audio_ms = now_ms;
-    }
 
     // Broadcast real-time data to WebSocket clients at 10 Hz
     static uint32_t last_broadcast_ms = 0;
@@ -477,33 +495,9 @@ void loop() {
         last_broadcast_ms = now_ms;
     }
 
-    // Track time for animation
-    static uint32_t start_time = millis();
-    float time = (millis() - start_time) / 1000.0f;
-
-    // Get current parameters (thread-safe read from active buffer)
-    const PatternParameters& params = get_params();
-
-    // BRIGHTNESS BINDING: Synchronize global_brightness with params.brightness
-    // This ensures UI brightness slider changes are reflected in LED output
-    extern float global_brightness;  // From led_driver.cpp
-    global_brightness = params.brightness;
-
-    // Draw current pattern (reads audio_front updated by Core 1 audio task)
-    uint32_t t_render0 = micros();
-    draw_current_pattern(time, params);
-    ACCUM_RENDER_US += (micros() - t_render0);
-
-    // Transmit to LEDs via RMT (with timeout instead of portMAX_DELAY)
-    // Modified transmit_leds() should use pdMS_TO_TICKS(10) timeout
-    transmit_leds();
-
-    // Send sync packet to s3z secondary device
-    send_uart_sync_frame();
-
-    // Track FPS
-    watch_cpu_fps();
-    print_fps();
+    // Rendering stays on loop_gpu alone: the audio snapshot and the beat
+    // event queue each have a single render-side reader
+    vTaskDelay(pdMS_TO_TICKS(1));
 }
 
 #endif  // UNIT_TEST
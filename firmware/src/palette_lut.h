@@ -0,0 +1,121 @@
+// -----------------------------------------------------------------
+// Palette LUT - Gradient palettes expanded to 256 colours in DRAM
+//
+// color_from_palette() quantizes progress to a byte before it looks at
+// the keyframes (pos = progress * 255), so a palette has exactly 256
+// distinct colours. Expanding them once into a CRGBF table turns every
+// later call into a wrap, a truncating convert, one load and a multiply
+// by brightness, in place of the header copy, keyframe search and float
+// interpolation per LED. The table holds the same colours the keyframe
+// path computes, so patterns look identical.
+//
+// Expansion is lazy: a small cache of PALETTE_LUT_SLOTS tables (3 KB
+// each, not 33 x 3 KB) fills a slot on the first lookup of a palette and
+// reuses the least recently filled slot on a miss, so a palette change
+// costs one 256-entry expansion (tens of microseconds) on the next frame.
+// The cache belongs to the render loop; other tasks (web previews)
+// evaluate keyframes directly with palette_keyframe_color().
+
+#ifndef PALETTE_LUT_H
+#define PALETTE_LUT_H
+
+#include <stdint.h>
+#include "types.h"
+
+#define PALETTE_LUT_SIZE 256
+#define PALETTE_LUT_SLOTS 2                  // Current palette + the one before it
+#define PALETTE_MAX_KEYFRAMES 16             // Longest palette has 13; palette_load_keyframes() cuts at this
+#define PALETTE_LUT_EMPTY 0xFFFF
+
+typedef struct {
+	CRGBF color[PALETTE_LUT_SLOTS][PALETTE_LUT_SIZE];
+	uint16_t palette[PALETTE_LUT_SLOTS];     // Palette held by each slot, PALETTE_LUT_EMPTY if none
+	uint8_t oldest;                          // Slot the next miss refills
+} palette_lut_cache;
+
+inline void palette_lut_cache_init(palette_lut_cache& cache) {
+	for (uint8_t s = 0; s < PALETTE_LUT_SLOTS; s++) {
+		cache.palette[s] = PALETTE_LUT_EMPTY;
+	}
+	cache.oldest = 0;
+}
+
+// Colour at byte position `pos` of a keyframe list ({position, R, G, B} x count)
+inline CRGBF palette_keyframe_color(const uint8_t* keyframes, uint8_t count, uint8_t pos) {
+	// Find bracketing keyframes
+	uint8_t entry1_idx = 0, entry2_idx = 0;
+	uint8_t pos1 = 0, pos2 = 255;
+	for (uint8_t i = 0; i + 1 < count; i++) {
+		const uint8_t p1 = keyframes[i * 4 + 0];
+		const uint8_t p2 = keyframes[(i + 1) * 4 + 0];
+		if (pos >= p1 && pos <= p2) {
+			entry1_idx = i;
+			entry2_idx = i + 1;
+			pos1 = p1;
+			pos2 = p2;
+			break;
+		}
+	}
+
+	const uint8_t* k1 = &keyframes[entry1_idx * 4];
+	const uint8_t* k2 = &keyframes[entry2_idx * 4];
+
+	// Interpolate between keyframes
+	float blend = 0.0f;
+	if (pos2 > pos1) {
+		blend = (float)(pos - pos1) / (float)(pos2 - pos1);
+	}
+	return CRGBF((k1[1] * (1.0f - blend) + k2[1] * blend) / 255.0f,
+	             (k1[2] * (1.0f - blend) + k2[2] * blend) / 255.0f,
+	             (k1[3] * (1.0f - blend) + k2[3] * blend) / 255.0f);
+}
+
+// All 256 positions of a keyframe list into `lut`
+inline void palette_lut_build(CRGBF* lut, const uint8_t* keyframes, uint8_t count) {
+	for (uint16_t pos = 0; pos < PALETTE_LUT_SIZE; pos++) {
+		lut[pos] = palette_keyframe_color(keyframes, count, (uint8_t)pos);
+	}
+}
+
+// Table of `palette` if cached, else nullptr
+inline const CRGBF* palette_lut_find(const palette_lut_cache& cache, uint16_t palette) {
+	for (uint8_t s = 0; s < PALETTE_LUT_SLOTS; s++) {
+		if (cache.palette[s] == palette) {
+			return cache.color[s];
+		}
+	}
+	return nullptr;
+}
+
+// Slot for `palette` after a miss: evicts the oldest fill; caller builds into it
+inline CRGBF* palette_lut_claim(palette_lut_cache& cache, uint16_t palette) {
+	const uint8_t slot = cache.oldest;
+	cache.oldest = (uint8_t)((slot + 1) % PALETTE_LUT_SLOTS);
+	cache.palette[slot] = palette;
+	return cache.color[slot];
+}
+
+// Progress (any real, wraps to 0.0-1.0) to table position, as the keyframe path quantizes it
+inline uint8_t palette_lut_position(float progress) {
+	progress -= (float)(int32_t)progress;    // fmodf(progress, 1.0f) for |progress| < 2^31
+	if (progress < 0.0f) progress += 1.0f;
+	return (uint8_t)(progress * 255.0f);
+}
+
+inline CRGBF palette_lut_color(const CRGBF* lut, float progress, float brightness) {
+	const CRGBF& c = lut[palette_lut_position(progress)];
+	return CRGBF(c.r * brightness, c.g * brightness, c.b * brightness);
+}
+
+// out[i] = colour at progress + i * step, all at one brightness
+inline void palette_lut_fill(const CRGBF* lut, CRGBF* out, uint16_t count,
+                             float progress, float step, float brightness) {
+	for (uint16_t i = 0; i < count; i++) {
+		const CRGBF& c = lut[palette_lut_position(progress + i * step)];
+		out[i].r = c.r * brightness;
+		out[i].g = c.g * brightness;
+		out[i].b = c.b * brightness;
+	}
+}
+
+#endif  // PALETTE_LUT_H
@@ -16,6 +16,7 @@ Format: {position_0_255, R, G, B, position, R, G, B, ...}
 
 #pragma once
 #include "types.h"
+#include "palette_lut.h"
 
 // ============================================================================
 // PALETTE DATA - 33 gradient palettes from cpt-city collection
@@ -471,56 +472,47 @@ const PaletteInfo palette_table[] PROGMEM = {
 // COLOR FROM PALETTE - Replaces hsv() function
 // ============================================================================
 
-inline CRGBF color_from_palette(uint8_t palette_index, float progress, float brightness) {
-	// Clamp inputs
-	palette_index = palette_index % NUM_PALETTES;
-	progress = fmodf(progress, 1.0f);
-	if (progress < 0.0f) progress += 1.0f;
-
-	// Convert progress to 0-255 range
-	uint8_t pos = (uint8_t)(progress * 255.0f);
+// Render-loop LUT cache (see palette_lut.h); defined in main.cpp
+extern palette_lut_cache palette_luts;
 
-	// Get palette info
+// Keyframes of a palette copied out of flash; returns the keyframe count
+// `keyframes` holds PALETTE_MAX_KEYFRAMES * 4 bytes; longer palettes are cut to that many
+inline uint8_t palette_load_keyframes(uint8_t palette_index, uint8_t* keyframes) {
 	PaletteInfo info;
 	memcpy_P(&info, &palette_table[palette_index], sizeof(PaletteInfo));
+	const uint8_t count = info.num_entries < PALETTE_MAX_KEYFRAMES ? info.num_entries : PALETTE_MAX_KEYFRAMES;
+	memcpy_P(keyframes, info.data, count * 4);
+	return count;
+}
 
-	// Find bracketing keyframes
-	uint8_t entry1_idx = 0, entry2_idx = 0;
-	uint8_t pos1 = 0, pos2 = 255;
-
-	// Read all entries and find the right interpolation range
-	for (uint8_t i = 0; i < info.num_entries - 1; i++) {
-		uint8_t p1 = pgm_read_byte(&info.data[i * 4 + 0]);
-		uint8_t p2 = pgm_read_byte(&info.data[(i + 1) * 4 + 0]);
-
-		if (pos >= p1 && pos <= p2) {
-			entry1_idx = i;
-			entry2_idx = i + 1;
-			pos1 = p1;
-			pos2 = p2;
-			break;
-		}
+// 256-colour table of a palette, expanded on first use (render loop only)
+inline const CRGBF* palette_lut(uint8_t palette_index) {
+	palette_index = palette_index % NUM_PALETTES;
+	const CRGBF* lut = palette_lut_find(palette_luts, palette_index);
+	if (lut == nullptr) {
+		uint8_t keyframes[PALETTE_MAX_KEYFRAMES * 4];
+		const uint8_t count = palette_load_keyframes(palette_index, keyframes);
+		CRGBF* slot = palette_lut_claim(palette_luts, palette_index);
+		palette_lut_build(slot, keyframes, count);
+		lut = slot;
 	}
+	return lut;
+}
 
-	// Read keyframe RGB data
-	uint8_t r1 = pgm_read_byte(&info.data[entry1_idx * 4 + 1]);
-	uint8_t g1 = pgm_read_byte(&info.data[entry1_idx * 4 + 2]);
-	uint8_t b1 = pgm_read_byte(&info.data[entry1_idx * 4 + 3]);
-
-	uint8_t r2 = pgm_read_byte(&info.data[entry2_idx * 4 + 1]);
-	uint8_t g2 = pgm_read_byte(&info.data[entry2_idx * 4 + 2]);
-	uint8_t b2 = pgm_read_byte(&info.data[entry2_idx * 4 + 3]);
-
-	// Interpolate between keyframes
-	float blend = 0.0f;
-	if (pos2 > pos1) {
-		blend = (float)(pos - pos1) / (float)(pos2 - pos1);
-	}
+inline CRGBF color_from_palette(uint8_t palette_index, float progress, float brightness) {
+	return palette_lut_color(palette_lut(palette_index), progress, brightness);
+}
 
-	float r = (r1 * (1.0f - blend) + r2 * blend) / 255.0f;
-	float g = (g1 * (1.0f - blend) + g2 * blend) / 255.0f;
-	float b = (b1 * (1.0f - blend) + b2 * blend) / 255.0f;
+// Gradient span: out[i] = color_from_palette(palette_index, progress + i * step, brightness)
+inline void color_from_palette_span(uint8_t palette_index, CRGBF* out, uint16_t count,
+                                    float progress, float step, float brightness) {
+	palette_lut_fill(palette_lut(palette_index), out, count, progress, step, brightness);
+}
 
-	// Apply brightness
-	return {r * brightness, g * brightness, b * brightness};
+// Same colour from the keyframes, without the cache: safe from any task (web previews)
+inline CRGBF color_from_palette_keyframes(uint8_t palette_index, float progress, float brightness) {
+	uint8_t keyframes[PALETTE_MAX_KEYFRAMES * 4];
+	const uint8_t count = palette_load_keyframes(palette_index % NUM_PALETTES, keyframes);
+	const CRGBF c = palette_keyframe_color(keyframes, count, palette_lut_position(progress));
+	return CRGBF(c.r * brightness, c.g * brightness, c.b * brightness);
 }
@@ -12,12 +12,12 @@
 //
 //  DEPENDENCIES:
 //    - Phase 1: AudioDataSnapshot structure (audio/goertzel.h)
-//    - Phase 1: get_audio_snapshot() function
-//    - Phase 1: commit_audio_data() buffer swap mechanism
+//    - Phase 1: acquire_audio_snapshot() function
+//    - Phase 1: commit_audio_data() triple-buffer publication
 //
 //  USAGE IN PATTERNS:
 //    void draw_pattern(float time, const PatternParameters& params) {
-//        PATTERN_AUDIO_START();  // Initialize audio snapshot
+//        PATTERN_AUDIO_START();  // Bind the latest audio snapshot
 //
 //        // Check if data is fresh (optional but recommended)
 //        if (!AUDIO_IS_FRESH()) return;
@@ -33,6 +33,8 @@
 // ============================================================================
 
 #include "audio/goertzel.h"
+#include "audio/beat_clock.h"
+#include "audio/tempo.h"        // audio_beat_events (see audio/beat_events.h)
 #include <esp_timer.h>
 
 // ============================================================================
@@ -45,39 +47,44 @@
  * Call this macro at the beginning of every pattern draw function that uses
  * audio data. It performs the following operations:
  *
- * 1. Declares a local AudioDataSnapshot struct
- * 2. Retrieves thread-safe snapshot via get_audio_snapshot()
- * 3. Tracks update counter to detect fresh data
- * 4. Calculates data age in milliseconds
- * 5. Sets boolean flags for freshness/availability
+ * 1. Binds a const reference to the latest published AudioDataSnapshot
+ *    via acquire_audio_snapshot() (no copy)
+ * 2. Tracks update counter to detect fresh data
+ * 3. Calculates data age in milliseconds
+ * 4. Sets boolean flags for freshness/availability
+ * 5. Evaluates the render-rate interpolation weights (see *_INTERP below)
  *
  * CREATED VARIABLES (usable in pattern scope):
- *   - audio              : AudioDataSnapshot - Complete audio data snapshot
- *   - audio_available    : bool - True if snapshot was retrieved successfully
+ *   - audio              : const AudioDataSnapshot& - Complete audio data snapshot
+ *   - audio_available    : bool - True once the audio task has published a frame
  *   - audio_is_fresh     : bool - True if data changed since last frame
  *   - audio_age_ms       : uint32_t - Milliseconds since last audio update
+ *   - audio_now_us       : uint32_t - Render timestamp (esp_timer)
+ *   - audio_interp       : feature_interp - Blend weights at audio_now_us
  *
  * THREAD SAFETY:
- *   - Safe to call from any task/thread
- *   - Safe to call multiple times in same pattern (each gets fresh snapshot)
+ *   - Render task only: the snapshot stays intact until the next
+ *     PATTERN_AUDIO_START(), which releases it (see audio/triple_buffer.h)
+ *   - Other tasks copy with get_audio_snapshot() instead
  *   - Pattern-local static for tracking prevents cross-pattern pollution
  *
  * PERFORMANCE:
- *   - Zero runtime overhead if audio system not initialized
- *   - ~10-20 microseconds for snapshot copy (negligible)
- *   - Non-blocking mutex (1ms timeout) prevents render stalls
+ *   - A few index loads and a barrier; no copy, no retry loop
+ *   - Never blocks the render loop
  */
 #define PATTERN_AUDIO_START() \
-    AudioDataSnapshot audio = {0}; \
-    bool audio_available = get_audio_snapshot(&audio); \
+    const AudioDataSnapshot& audio = *acquire_audio_snapshot(); \
+    bool audio_available = audio.is_valid; \
     static uint32_t pattern_last_update = 0; \
     bool audio_is_fresh = (audio_available && \
                            audio.update_counter != pattern_last_update); \
     if (audio_is_fresh) { \
         pattern_last_update = audio.update_counter; \
     } \
+    const uint32_t audio_now_us = (uint32_t)esp_timer_get_time(); \
+    const feature_interp audio_interp = feature_interp_weights(audio.timestamp_prev_us, audio.timestamp_us, audio_now_us); \
     uint32_t audio_age_ms = audio_available ? \
-        ((uint32_t)((esp_timer_get_time() - audio.timestamp_us) / 1000)) : 9999
+        ((audio_now_us - audio.timestamp_us) / 1000) : 9999
 
 // ============================================================================
 // AUDIO DATA ACCESSORS
@@ -101,6 +108,45 @@
 #define AUDIO_CHROMAGRAM        (audio.chromagram)
 #define AUDIO_FFT               (audio.fft_smooth)
 
+/**
+ * Render-rate interpolated features
+ *
+ * Same data as AUDIO_SPECTRUM, AUDIO_SPECTRUM_SMOOTH, AUDIO_CHROMAGRAM and
+ * AUDIO_VU, blended from the previous analysis frame to the current one at
+ * the render timestamp, so values glide instead of stepping once per audio
+ * frame. Use these instead of per-pattern decay buffers that only exist to
+ * hide the steps.
+ *
+ * MODES (per feature, see audio/feature_interp.h):
+ *   - FEATURE_INTERP_LINEAR : exact continuity, one audio frame (8 ms) late
+ *   - FEATURE_INTERP_DAMPED : critically damped, about 0.4 frame late
+ *   Spectra and chroma default to linear; VU, which usually drives
+ *   brightness directly, defaults to damped so beats land sooner.
+ *
+ * USAGE:
+ *   float value = AUDIO_SPECTRUM_INTERP(bin_index);
+ *   float level = AUDIO_VU_INTERP;
+ *
+ * PERFORMANCE: one multiply-add per read; the weights are computed once in
+ * PATTERN_AUDIO_START().
+ */
+#define AUDIO_INTERP_SPECTRUM_MODE      FEATURE_INTERP_LINEAR
+#define AUDIO_INTERP_CHROMAGRAM_MODE    FEATURE_INTERP_LINEAR
+#define AUDIO_INTERP_VU_MODE            FEATURE_INTERP_DAMPED
+
+#define AUDIO_SPECTRUM_INTERP(bin) \
+    (feature_interp_blend(audio.spectrogram_prev[(bin)], audio.spectrogram[(bin)], \
+                          feature_interp_weight(audio_interp, AUDIO_INTERP_SPECTRUM_MODE)))
+#define AUDIO_SPECTRUM_SMOOTH_INTERP(bin) \
+    (feature_interp_blend(audio.spectrogram_smooth_prev[(bin)], audio.spectrogram_smooth[(bin)], \
+                          feature_interp_weight(audio_interp, AUDIO_INTERP_SPECTRUM_MODE)))
+#define AUDIO_CHROMAGRAM_INTERP(note) \
+    (feature_interp_blend(audio.chromagram_prev[(note)], audio.chromagram[(note)], \
+                          feature_interp_weight(audio_interp, AUDIO_INTERP_CHROMAGRAM_MODE)))
+#define AUDIO_VU_INTERP \
+    (feature_interp_blend(audio.vu_level_prev, audio.vu_level, \
+                          feature_interp_weight(audio_interp, AUDIO_INTERP_VU_MODE)))
+
 /**
  * Scalar audio metrics
  *
@@ -108,11 +154,17 @@
  * AUDIO_VU_RAW     : Raw amplitude before auto-ranging
  * AUDIO_NOVELTY    : Spectral change/onset detection (0.0-1.0)
  * AUDIO_TEMPO_CONFIDENCE : Beat detection confidence (0.0-1.0)
+ * AUDIO_PITCH_HZ   : Fundamental frequency (62.5 Hz - 2 kHz), 0 when unpitched
+ * AUDIO_PITCH_CLARITY : How periodic the sound is (0.0-1.0); above ~0.9 a clear note
+ * AUDIO_PITCH_MIDI : MIDI note number (69.0 = A4, fraction in semitones), 0 when unpitched
  */
 #define AUDIO_VU                (audio.vu_level)
 #define AUDIO_VU_RAW            (audio.vu_level_raw)
 #define AUDIO_NOVELTY           (audio.novelty_curve)
 #define AUDIO_TEMPO_CONFIDENCE  (audio.tempo_confidence)
+#define AUDIO_PITCH_HZ          (audio.pitch_hz)
+#define AUDIO_PITCH_CLARITY     (audio.pitch_clarity)
+#define AUDIO_PITCH_MIDI        (audio.pitch_midi)
 
 // ============================================================================
 // QUERY MACROS
@@ -352,6 +404,67 @@ inline float get_audio_band_energy(const AudioDataSnapshot& audio,
  */
 #define AUDIO_TEMPO_BEAT(bin)       (sinf(AUDIO_TEMPO_PHASE(bin)))
 
+/**
+ * beat_phase(audio, bin, now_us) / AUDIO_TEMPO_PHASE_AT(bin, now_us)
+ *
+ * Tempo bin phase extrapolated to `now_us` (esp_timer microseconds).
+ * AUDIO_TEMPO_PHASE(bin) only changes when the audio core publishes a
+ * frame; at render rates above that it steps visibly. The snapshot also
+ * carries each bin's phase velocity and the time the phase was measured,
+ * so the phase can be advanced to the render timestamp (see beat_clock.h).
+ *
+ * RANGE: -π to +π, same convention as AUDIO_TEMPO_PHASE(bin)
+ *
+ * EXAMPLE:
+ *   uint32_t now_us = (uint32_t)esp_timer_get_time();
+ *   float beat = sinf(AUDIO_TEMPO_PHASE_AT(32, now_us));  // Smooth at any FPS
+ *
+ * NOTES:
+ *   - Take now_us once per frame so all bins share the same instant
+ *   - Extrapolation stops after 250 ms of stale audio (phase parks)
+ */
+inline float beat_phase(const AudioDataSnapshot& audio, uint16_t bin, uint32_t now_us) {
+    return beat_clock_phase(audio.tempo_phase[bin], audio.tempo_phase_velocity[bin],
+                            audio.tempo_phase_time_us, now_us);
+}
+
+#define AUDIO_TEMPO_PHASE_AT(bin, now_us)  (beat_phase(audio, (bin), (now_us)))
+
+// ============================================================================
+// BEAT / ONSET EVENTS
+// ============================================================================
+
+/**
+ * AUDIO_NEXT_BEAT_EVENT(event)
+ *
+ * Pops the next beat or onset event emitted by the audio core
+ * (detect_beats()). Each beat arrives exactly once, stamped with the time
+ * it happened, instead of being inferred by thresholding a snapshot value
+ * every render frame. Needs no PATTERN_AUDIO_START() snapshot.
+ *
+ * EVENT FIELDS (beat_event, see audio/beat_events.h):
+ *   - type         : BEAT_EVENT_BEAT or BEAT_EVENT_ONSET
+ *   - timestamp_us : When it happened (esp_timer)
+ *   - strength     : 0.0-1.0 (beat: tempo confidence, onset: novelty)
+ *   - tempo_bin    : Dominant tempo bin
+ *   - pitch_class  : Dominant chromagram note (0 = C .. 11 = B)
+ *
+ * EXAMPLE:
+ *   beat_event event;
+ *   while (AUDIO_NEXT_BEAT_EVENT(event)) {
+ *       if (event.type == BEAT_EVENT_BEAT) spawn_wave(event.strength);
+ *   }
+ *
+ * NOTES:
+ *   - Drain once per frame, from the active pattern only (single consumer)
+ *   - Events older than 100 ms (queued while another pattern ran) are skipped
+ */
+inline bool get_beat_event(beat_event* event) {
+    return beat_event_pop_recent(audio_beat_events, event, (uint32_t)esp_timer_get_time(), BEAT_EVENT_MAX_AGE_US);
+}
+
+#define AUDIO_NEXT_BEAT_EVENT(event)  (get_beat_event(&(event)))
+
 // ============================================================================
 // MIGRATION EXAMPLE: Before and After
 // ============================================================================
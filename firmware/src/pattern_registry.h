@@ -7,6 +7,7 @@
 
 // Pattern function signature
 // All patterns receive time and parameters, write to global leds[] buffer
+// (leds_half[] for centre-origin patterns, see PatternInfo::renders_half)
 typedef void (*PatternFunction)(float time, const PatternParameters& params);
 
 // Pattern metadata
@@ -16,6 +17,8 @@ struct PatternInfo {
     const char* description;       // Short description
     PatternFunction draw_fn;       // Function pointer to draw function
     bool is_audio_reactive;        // Requires audio data
+    bool renders_half;             // Centre-origin: draws leds_half[], the engine mirrors it
+    bool own_persistence;          // Keeps its own trail or beat timing: no softness blend after it
 };
 
 // Pattern registry (defined in generated_patterns.h)
@@ -68,8 +71,11 @@ inline const PatternInfo& get_current_pattern() {
     return g_pattern_registry[g_current_pattern_index];
 }
 
-// Draw current pattern (call from loop())
-inline void draw_current_pattern(float time, const PatternParameters& params) {
-    PatternFunction draw_fn = g_pattern_registry[g_current_pattern_index].draw_fn;
-    draw_fn(time, params);
+// Draw current pattern (call from loop(), then finish_frame())
+// Returns the pattern drawn: read once, so a switch from the web task between
+// the two calls cannot pair this frame with another pattern's render contract
+inline const PatternInfo& draw_current_pattern(float time, const PatternParameters& params) {
+    const PatternInfo& pattern = g_pattern_registry[g_current_pattern_index];
+    pattern.draw_fn(time, params);
+    return pattern;
 }
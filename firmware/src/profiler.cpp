@@ -11,6 +11,12 @@ volatile uint64_t ACCUM_RMT_WAIT_US = 0;
 volatile uint64_t ACCUM_RMT_TRANSMIT_US = 0;
 volatile uint32_t FRAMES_COUNTED = 0;
 
+latency_histogram LATENCY_HISTOGRAMS[LATENCY_STAGE_COUNT] = {};
+const char* const LATENCY_STAGE_NAMES[LATENCY_STAGE_COUNT] = {
+    "ingest", "spectral", "tempo", "pickup", "render", "mic_to_led"
+};
+volatile uint32_t LED_TRANSMIT_START_US = 0;
+
 void watch_cpu_fps() {
     uint32_t us_now = micros();
     static uint32_t last_call = 0;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Arduino.h>
+#include "audio/latency_histogram.h"
 
 // Simplified profiler - FPS monitoring + micro-timings
 
@@ -11,9 +12,28 @@ extern float FPS_CPU_SAMPLES[16];
 // Reset once per print cycle
 extern volatile uint64_t ACCUM_RENDER_US;
 extern volatile uint64_t ACCUM_QUANTIZE_US;
-extern volatile uint64_t ACCUM_RMT_WAIT_US;
+extern volatile uint64_t ACCUM_RMT_WAIT_US;        // Blocked with every LED output buffer in flight
 extern volatile uint64_t ACCUM_RMT_TRANSMIT_US;
 extern volatile uint32_t FRAMES_COUNTED;
 
+// Mic-to-photon latency per stage (see audio/latency_histogram.h)
+// Audio task writes the first three, render task the rest
+enum latency_stage {
+    LATENCY_INGEST = 0,      // Newest chunk DMA done -> analysis start (task wake + ingest)
+    LATENCY_SPECTRAL,        // Analysis start -> spectrum and chromagram done
+    LATENCY_TEMPO,           // -> snapshot published (novelty, tempo, beats)
+    LATENCY_PICKUP,          // Published -> first render frame using it
+    LATENCY_RENDER,          // Render start -> RMT transmit start (draw, RMT wait, quantize)
+    LATENCY_MIC_TO_LED,      // Newest chunk DMA done -> RMT transmit start
+    LATENCY_STAGE_COUNT
+};
+extern latency_histogram LATENCY_HISTOGRAMS[LATENCY_STAGE_COUNT];
+extern const char* const LATENCY_STAGE_NAMES[LATENCY_STAGE_COUNT];
+
+// esp_timer time of the last rmt_transmit() call (set by transmit_leds)
+// The frame is queued there; it reaches the wire once the frame ahead of it
+// (if any, see LED_OUTPUT_BUFFERS) has finished, at most ~5.6 ms later
+extern volatile uint32_t LED_TRANSMIT_START_US;
+
 void watch_cpu_fps();
 void print_fps();
\ No newline at end of file
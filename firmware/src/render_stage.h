@@ -0,0 +1,75 @@
+// -----------------------------------------------------------------
+// Render Stage - Shared post-process between a pattern and the LEDs
+//
+// Centre-origin patterns render only half the strip: RENDER_HALF_LENGTH
+// colours indexed by distance from the centre, [0] beside the centre
+// and [RENDER_HALF_LENGTH - 1] at both edges. The stage writes each
+// colour to its mirrored pair,
+//
+//     out[HALF + d] = out[HALF - 1 - d] = half[d]
+//
+// so those patterns compute 90 LEDs instead of 180 and none of them
+// carries its own mirror loop. Patterns that still draw the full strip
+// (dots, edge-to-edge fields) pass their frame straight through.
+//
+// In the same pass every channel is clamped to 0.0-1.0 and blended with
+// the previous output frame by the softness parameter:
+//
+//     out = c + (previous - c) * RENDER_SOFTNESS_MAX * softness
+//
+// Softness 0 passes frames through untouched; the engine passes 0 for
+// patterns that keep their own trail or beat timing
+// (PatternInfo::own_persistence), so bloom's decay or a beat flash is
+// not smeared a second time. Brightness, gamma and
+// dithering come after this, in the LED output stage (led_output.h).
+
+#ifndef RENDER_STAGE_H
+#define RENDER_STAGE_H
+
+#include <stdint.h>
+#include "types.h"
+
+#define RENDER_STRIP_LENGTH 180                  // STRIP_LENGTH (led_driver.h)
+#define RENDER_HALF_LENGTH (RENDER_STRIP_LENGTH / 2)
+#define RENDER_SOFTNESS_MAX 0.9f                 // Persistence at softness 1.0: ~10-frame trail
+
+typedef struct {
+	CRGBF previous[RENDER_STRIP_LENGTH];         // Last output frame (softness)
+} render_stage;
+
+inline float render_clamp(float value) {
+	return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+}
+
+// Clamped, softened colour; also stored as the pixel's previous frame
+inline CRGBF render_soften(CRGBF& previous, const CRGBF& color, float persistence) {
+	const float r = render_clamp(color.r);
+	const float g = render_clamp(color.g);
+	const float b = render_clamp(color.b);
+	previous.r = r + (previous.r - r) * persistence;
+	previous.g = g + (previous.g - g) * persistence;
+	previous.b = b + (previous.b - b) * persistence;
+	return previous;
+}
+
+// Pattern frame to output frame. `half`: `frame` holds RENDER_HALF_LENGTH centre-out
+// colours, else RENDER_STRIP_LENGTH (may be `out` itself).
+inline void render_stage_finish(render_stage& stage, const CRGBF* frame, bool half,
+                                float softness, CRGBF* out) {
+	const float persistence = RENDER_SOFTNESS_MAX * render_clamp(softness);
+	CRGBF* previous = stage.previous;
+	if (half) {
+		for (uint16_t d = 0; d < RENDER_HALF_LENGTH; d++) {
+			const uint16_t right = RENDER_HALF_LENGTH + d;
+			const uint16_t left = RENDER_HALF_LENGTH - 1 - d;
+			out[right] = render_soften(previous[right], frame[d], persistence);
+			out[left] = render_soften(previous[left], frame[d], persistence);
+		}
+		return;
+	}
+	for (uint16_t i = 0; i < RENDER_STRIP_LENGTH; i++) {
+		out[i] = render_soften(previous[i], frame[i], persistence);
+	}
+}
+
+#endif  // RENDER_STAGE_H
@@ -8,7 +8,7 @@
 // CRGB8, touch_pin, config
 
 struct CRGBF {	// Floating point color channels (0.0-1.0)
-				// Quantized to 8 bits with dithering in led_driver.h
+				// Perceptual levels; gamma, brightness and dithering in led_output.h
 	float r, g, b;
 	CRGBF() : r(0), g(0), b(0) {}
 	CRGBF(float r, float g, float b) : r(r), g(g), b(b) {}
@@ -102,7 +102,7 @@ public:
         cpu_monitor.update();
         float cpu_percent = cpu_monitor.getAverageCPUUsage();
 
-        StaticJsonDocument<512> doc;
+        StaticJsonDocument<1024> doc;
         doc["fps"] = FPS_CPU;
         doc["frame_time_us"] = frame_time_us;
         doc["cpu_percent"] = cpu_percent;
@@ -110,6 +110,32 @@ public:
         doc["memory_free_kb"] = heap_free / 1024;
         doc["memory_total_kb"] = heap_total / 1024;
 
+        // Audio analysis work per frame (bin scheduler); peak covers the time since the last reset
+        doc["audio_work_units"] = audio_work_units_last;
+        doc["audio_work_units_peak"] = audio_work_units_peak;
+        doc["audio_work_units_unscheduled"] = audio_work_units_unscheduled;
+
+        // Audio task cadence (I2S chunk driven); min/max cover the time since the last reset
+        doc["audio_frames"] = audio_cadence.frames;
+        doc["audio_late_frames"] = audio_cadence.late_frames;
+        doc["audio_dropped_chunks"] = audio_cadence.dropped_chunks;
+        doc["audio_dma_overruns"] = audio_cadence.dma_overruns;
+        doc["audio_i2s_timeouts"] = audio_cadence.timeouts;
+        doc["audio_i2s_read_errors"] = audio_cadence.read_errors;
+        doc["audio_slack_us"] = audio_cadence.slack_us_last;
+        doc["audio_slack_us_min"] = audio_cadence.slack_us_min == INT32_MAX ? audio_cadence.slack_us_last : audio_cadence.slack_us_min;
+        doc["audio_latency_us"] = audio_cadence.latency_us_last;
+        doc["audio_latency_us_max"] = audio_cadence.latency_us_max;
+
+        // Analysis quality level (0 = full) and how often the governor has moved it
+        doc["audio_quality_level"] = audio_governor.level;
+        doc["audio_quality_step_downs"] = audio_governor.step_downs;
+        doc["audio_quality_step_ups"] = audio_governor.step_ups;
+
+        // Boot check of the stored noise profile; stale asks for a recalibration in a quiet room
+        doc["noise_profile_drift"] = noise_profile_drift_last;
+        doc["noise_profile_stale"] = noise_profile_stale;
+
         // Include FPS history samples (length 16)
         JsonArray fps_history = doc.createNestedArray("fps_history");
         for (int i = 0; i < 16; ++i) {
@@ -122,6 +148,55 @@ public:
     }
 };
 
+// POST /api/device/performance - Start a new window for the audio work peak and cadence extremes
+// The audio task applies the reset before its next frame
+class PostDevicePerformanceResetHandler : public K1RequestHandler {
+public:
+    PostDevicePerformanceResetHandler() : K1RequestHandler(ROUTE_DEVICE_PERFORMANCE, ROUTE_POST) {}
+    void handle(RequestContext& ctx) override {
+        audio_work_units_peak_reset_requested = true;
+        audio_cadence_request_window_reset(audio_cadence);
+        ctx.sendJson(200, "{\"status\":\"ok\"}");
+    }
+};
+
+// GET /api/device/latency - Mic-to-photon latency percentiles per stage
+// Covers the time since the last reset (POST /api/device/latency)
+class GetDeviceLatencyHandler : public K1RequestHandler {
+public:
+    GetDeviceLatencyHandler() : K1RequestHandler(ROUTE_DEVICE_LATENCY, ROUTE_GET) {}
+    void handle(RequestContext& ctx) override {
+        StaticJsonDocument<1024> doc;
+        JsonObject stages = doc.createNestedObject("stages");
+        for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+            latency_histogram& histogram = LATENCY_HISTOGRAMS[i];
+            JsonObject stage = stages.createNestedObject(LATENCY_STAGE_NAMES[i]);
+            stage["count"] = histogram.total;
+            stage["p50_us"] = latency_histogram_percentile(histogram, 0.50f);
+            stage["p95_us"] = latency_histogram_percentile(histogram, 0.95f);
+            stage["p99_us"] = latency_histogram_percentile(histogram, 0.99f);
+            stage["max_us"] = histogram.max_us;
+        }
+
+        String output;
+        serializeJson(doc, output);
+        ctx.sendJson(200, output);
+    }
+};
+
+// POST /api/device/latency - Start a new window for every latency histogram
+// Each writer clears its histogram before its next sample (see audio/latency_histogram.h)
+class PostDeviceLatencyResetHandler : public K1RequestHandler {
+public:
+    PostDeviceLatencyResetHandler() : K1RequestHandler(ROUTE_DEVICE_LATENCY, ROUTE_POST) {}
+    void handle(RequestContext& ctx) override {
+        for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+            latency_histogram_request_clear(LATENCY_HISTOGRAMS[i]);
+        }
+        ctx.sendJson(200, "{\"status\":\"ok\"}");
+    }
+};
+
 // GET /api/test-connection - Simple connection check
 class GetTestConnectionHandler : public K1RequestHandler {
 public:
@@ -228,8 +303,27 @@ public:
             }
         }
 
+        // Select the spectral engine if provided ("goertzel" or "cqt")
+        if (json.containsKey("spectral_engine")) {
+            const char* engine = json["spectral_engine"] | "";
+            if (strcmp(engine, "goertzel") == 0) {
+                configuration.spectral_engine = SPECTRAL_ENGINE_GOERTZEL;
+            } else if (strcmp(engine, "cqt") == 0) {
+                if (!cqt_engine_supported()) {
+                    ctx.sendError(503, "engine_unavailable", "a spectral bin does not fit the CQT frame");
+                    return;
+                }
+                configuration.spectral_engine = SPECTRAL_ENGINE_CQT;  // Audio task builds the kernels on its next frame
+            } else {
+                ctx.sendError(400, "invalid_value", "spectral_engine must be \"goertzel\" or \"cqt\"");
+                return;
+            }
+            LOG_INFO(TAG_AUDIO, "Spectral engine set to %s", engine);
+        }
+
         StaticJsonDocument<128> response_doc;
         response_doc["microphone_gain"] = configuration.microphone_gain;
+        response_doc["spectral_engine"] = configuration.spectral_engine == SPECTRAL_ENGINE_CQT ? "cqt" : "goertzel";
         String response;
         serializeJson(response_doc, response);
         ctx.sendJson(200, response);
@@ -277,13 +371,14 @@ public:
     }
 };
 
-// GET /api/audio-config - Get audio configuration (microphone gain)
+// GET /api/audio-config - Get audio configuration (microphone gain, spectral engine)
 class GetAudioConfigHandler : public K1RequestHandler {
 public:
     GetAudioConfigHandler() : K1RequestHandler(ROUTE_AUDIO_CONFIG, ROUTE_GET) {}
     void handle(RequestContext& ctx) override {
         StaticJsonDocument<128> doc;
         doc["microphone_gain"] = configuration.microphone_gain;
+        doc["spectral_engine"] = configuration.spectral_engine == SPECTRAL_ENGINE_CQT ? "cqt" : "goertzel";
         String response;
         serializeJson(doc, response);
         ctx.sendJson(200, response);
@@ -443,6 +538,7 @@ void init_webserver() {
     registerGetHandler(server, ROUTE_PALETTES, new GetPalettesHandler());
     registerGetHandler(server, ROUTE_DEVICE_INFO, new GetDeviceInfoHandler());
     registerGetHandler(server, ROUTE_DEVICE_PERFORMANCE, new GetDevicePerformanceHandler());
+    registerGetHandler(server, ROUTE_DEVICE_LATENCY, new GetDeviceLatencyHandler());
     registerGetHandler(server, ROUTE_TEST_CONNECTION, new GetTestConnectionHandler());
 
     // Register POST handlers (with built-in rate limiting and JSON parsing)
@@ -452,6 +548,8 @@ void init_webserver() {
     registerPostHandler(server, ROUTE_AUDIO_CONFIG, new PostAudioConfigHandler());
     registerPostHandler(server, ROUTE_WIFI_LINK_OPTIONS, new PostWifiLinkOptionsHandler());
     registerPostHandler(server, ROUTE_CONFIG_RESTORE, new PostConfigRestoreHandler());
+    registerPostHandler(server, ROUTE_DEVICE_PERFORMANCE, new PostDevicePerformanceResetHandler());
+    registerPostHandler(server, ROUTE_DEVICE_LATENCY, new PostDeviceLatencyResetHandler());
 
     // Register remaining GET handlers
     registerGetHandler(server, ROUTE_AUDIO_CONFIG, new GetAudioConfigHandler());
@@ -35,6 +35,7 @@ static const char* ROUTE_PALETTES = "/api/palettes";
 static const char* ROUTE_DEVICE_INFO = "/api/device/info";
 static const char* ROUTE_TEST_CONNECTION = "/api/test-connection";
 static const char* ROUTE_DEVICE_PERFORMANCE = "/api/device/performance";
+static const char* ROUTE_DEVICE_LATENCY = "/api/device/latency";
 static const char* ROUTE_CONFIG_BACKUP = "/api/config/backup";
 static const char* ROUTE_CONFIG_RESTORE = "/api/config/restore";
 
@@ -58,6 +59,9 @@ static RouteWindow control_windows[] = {
     {ROUTE_DEVICE_INFO, ROUTE_GET, 1000, 0},
     {ROUTE_TEST_CONNECTION, ROUTE_GET, 200, 0},
     {ROUTE_DEVICE_PERFORMANCE, ROUTE_GET, 500, 0},
+    {ROUTE_DEVICE_LATENCY, ROUTE_GET, 500, 0},
+    {ROUTE_DEVICE_PERFORMANCE, ROUTE_POST, 500, 0},
+    {ROUTE_DEVICE_LATENCY, ROUTE_POST, 500, 0},
     {ROUTE_CONFIG_BACKUP, ROUTE_GET, 2000, 0},
     {ROUTE_CONFIG_RESTORE, ROUTE_POST, 2000, 0},
 };
@@ -114,6 +114,7 @@ static String build_patterns_json() {
         pattern["name"] = g_pattern_registry[i].name;
         pattern["description"] = g_pattern_registry[i].description;
         pattern["is_audio_reactive"] = g_pattern_registry[i].is_audio_reactive;
+        pattern["own_persistence"] = g_pattern_registry[i].own_persistence;
     }
 
     doc["current_pattern"] = g_current_pattern_index;
@@ -140,7 +141,7 @@ static String build_palettes_json() {
         JsonArray colors = palette.createNestedArray("colors");
         for (int j = 0; j < 5; j++) {
             float progress = j / 4.0f;  // 0.0, 0.25, 0.5, 0.75, 1.0
-            CRGBF color = color_from_palette(i, progress, 1.0f);
+            CRGBF color = color_from_palette_keyframes(i, progress, 1.0f);
             JsonObject colorObj = colors.createNestedObject();
             colorObj["r"] = (uint8_t)(color.r * 255);
             colorObj["g"] = (uint8_t)(color.g * 255);
@@ -21,7 +21,7 @@
 
 // External I2S handle for testing
 extern i2s_chan_handle_t rx_handle;
-extern float sample_history[SAMPLE_HISTORY_LENGTH];
+extern audio_sample_ring sample_history;
 
 // ============================================================================
 // TEST SETUP / TEARDOWN
@@ -111,15 +111,16 @@ void test_silence_fallback() {
     Serial.println("\n=== TEST: Silence Buffer Fallback ===");
 
     // Clear sample history
-    memset(sample_history, 0, sizeof(float) * SAMPLE_HISTORY_LENGTH);
+    mirrored_ring_clear(sample_history);
 
     // Perform acquisition (may timeout, should fill with silence)
     acquire_sample_chunk();
 
     // Verify sample history contains valid data (zeros if timeout)
     bool all_finite = true;
+    const audio_sample_t* history = get_sample_history();
     for (int i = 0; i < SAMPLE_HISTORY_LENGTH; i++) {
-        if (!isfinite(sample_history[i])) {
+        if (!isfinite((float)history[i])) {
             all_finite = false;
             break;
         }
@@ -0,0 +1,200 @@
+/**
+ * TEST SUITE: Audio Task Cadence (native)
+ *
+ * Validates the chunk clock fed by the I2S RX-done callback and the frame
+ * timing counters (audio_cadence.h):
+ * - chunks are counted exactly whatever the DMA buffer size
+ * - chunk timestamps are interpolated back to the chunk boundary
+ * - pending / take bookkeeping survives counter wrap
+ * - a simulated audio task (callback-driven) runs once per chunk when it
+ *   keeps up, and records late frames, slack and latency when it does not;
+ *   after a spike it catches up in one frame, where the old
+ *   read-then-sleep-1ms loop spends several frames on stale chunks
+ *
+ * Run with: pio test -e native -f test_native_audio_cadence
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "../../src/audio/audio_cadence.h"
+
+#define CHUNK_SIZE 128
+#define SAMPLE_RATE 16000
+#define CHUNK_BYTES (CHUNK_SIZE * 4)
+#define CHUNK_US (CHUNK_SIZE * 1000000UL / SAMPLE_RATE)
+
+static chunk_clock clock_under_test;
+static audio_cadence_stats stats;
+
+void setUp(void) {
+    // Mirrors init_i2s_microphone()
+    chunk_clock_init(clock_under_test, CHUNK_BYTES, CHUNK_US);
+    stats = {};
+    audio_cadence_reset_window(stats);
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Chunk counting is independent of the DMA buffer size
+// =============================================================================
+void test_chunk_counting(void) {
+    const uint32_t buffer_sizes[] = { CHUNK_BYTES, CHUNK_BYTES * 2, 240 * 8, 300, CHUNK_BYTES / 2 };
+    for (uint32_t size : buffer_sizes) {
+        chunk_clock_init(clock_under_test, CHUNK_BYTES, CHUNK_US);
+        uint32_t bytes = 0;
+        uint32_t notifications = 0;
+        for (int i = 0; i < 1000; i++) {
+            bytes += size;
+            if (chunk_clock_on_dma(clock_under_test, size, bytes / 32)) {
+                notifications++;
+            }
+        }
+        TEST_ASSERT_EQUAL_UINT32(bytes / CHUNK_BYTES, chunk_clock_pending(clock_under_test));
+        TEST_ASSERT_TRUE(notifications <= bytes / CHUNK_BYTES);
+    }
+}
+
+// =============================================================================
+// TEST 2: Chunk time is the arrival of the chunk's last sample
+// =============================================================================
+void test_chunk_timestamp(void) {
+    // 1.5 chunks per DMA buffer: the boundary sits a third of the way back
+    const uint32_t size = CHUNK_BYTES * 3 / 2;
+    const uint32_t buffer_us = CHUNK_US * 3 / 2;
+
+    TEST_ASSERT_TRUE(chunk_clock_on_dma(clock_under_test, size, buffer_us));
+    TEST_ASSERT_EQUAL_UINT32(CHUNK_US, clock_under_test.chunk_time_us);
+
+    TEST_ASSERT_TRUE(chunk_clock_on_dma(clock_under_test, size, buffer_us * 2));
+    TEST_ASSERT_EQUAL_UINT32(CHUNK_US * 3, clock_under_test.chunk_time_us);
+    TEST_ASSERT_EQUAL_UINT32(3, chunk_clock_pending(clock_under_test));
+}
+
+// =============================================================================
+// TEST 3: Pending count survives counter wrap
+// =============================================================================
+void test_counter_wrap(void) {
+    clock_under_test.chunks_ready = 0xFFFFFFFEu;
+    clock_under_test.chunks_taken = 0xFFFFFFFEu;
+
+    for (int i = 0; i < 5; i++) {
+        chunk_clock_on_dma(clock_under_test, CHUNK_BYTES, 0);
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, chunk_clock_pending(clock_under_test));
+    chunk_clock_take(clock_under_test, 5);
+    TEST_ASSERT_EQUAL_UINT32(0, chunk_clock_pending(clock_under_test));
+}
+
+// =============================================================================
+// TEST 4: Simulated audio task, callback-driven vs read-then-sleep
+// =============================================================================
+// Pipeline cost per frame: mostly under one chunk, with occasional spikes
+static uint32_t pipeline_us(uint32_t frame) {
+    return (frame % 50 == 49) ? CHUNK_US * 2 + 500 : CHUNK_US * 6 / 10;
+}
+
+void test_simulated_task(void) {
+    const uint32_t run_us = 2000000;
+    const uint32_t tick_us = 1000;
+
+    // Callback-driven: wake at each chunk boundary, ingest the backlog, analyse once
+    uint32_t now = 0;
+    uint32_t next_dma = CHUNK_US;
+    uint32_t frame = 0;
+    uint32_t stale_frames = 0;
+    while (now < run_us) {
+        while (chunk_clock_pending(clock_under_test) == 0) {
+            now = next_dma;
+            chunk_clock_on_dma(clock_under_test, CHUNK_BYTES, now);
+            next_dma += CHUNK_US;
+        }
+        uint32_t found = chunk_clock_pending(clock_under_test);
+        uint32_t newest = clock_under_test.chunk_time_us;
+        chunk_clock_take(clock_under_test, found);
+
+        now += pipeline_us(frame++);
+        while (next_dma <= now) {
+            chunk_clock_on_dma(clock_under_test, CHUNK_BYTES, next_dma);
+            next_dma += CHUNK_US;
+        }
+        audio_cadence_frame(stats, found, found, 1, newest, now, CHUNK_US);
+        stale_frames += stats.latency_us_last > CHUNK_US;
+    }
+
+    // Old loop: read (blocks until a chunk is there), analyse, sleep one tick
+    uint32_t old_frames = 0, old_latency_max = 0, old_stale_frames = 0;
+    uint64_t old_latency_sum = 0;
+    uint32_t chunks_available_at = CHUNK_US;
+    now = 0;
+    frame = 0;
+    while (now < run_us) {
+        if (now < chunks_available_at) {
+            now = chunks_available_at;
+        }
+        uint32_t newest = chunks_available_at;
+        chunks_available_at += CHUNK_US;   // One chunk per read
+        now += pipeline_us(frame++);
+        uint32_t latency = now - newest;
+        old_latency_sum += latency;
+        old_latency_max = latency > old_latency_max ? latency : old_latency_max;
+        old_stale_frames += latency > CHUNK_US;
+        old_frames++;
+        now += tick_us;                    // vTaskDelay(1)
+    }
+
+    const uint32_t chunks_total = run_us / CHUNK_US;
+    printf("[CADENCE] callback-driven: %lu frames for %lu chunks, %lu late, %lu stale, latency max %lu us, slack min %ld us\n",
+           (unsigned long)stats.frames, (unsigned long)stats.chunks, (unsigned long)stats.late_frames,
+           (unsigned long)stale_frames, (unsigned long)stats.latency_us_max, (long)stats.slack_us_min);
+    printf("[CADENCE] read + 1 ms sleep: %lu frames, %lu stale, latency mean %lu us / max %lu us\n",
+           (unsigned long)old_frames, (unsigned long)old_stale_frames,
+           (unsigned long)(old_latency_sum / old_frames), (unsigned long)old_latency_max);
+
+    // Every chunk ingested, every frame on time except those after a spike
+    TEST_ASSERT_TRUE(stats.chunks >= chunks_total - 2);
+    TEST_ASSERT_TRUE(stats.late_frames > 0);
+    TEST_ASSERT_TRUE(stats.late_frames <= stats.frames / 40);
+    TEST_ASSERT_TRUE(stats.slack_us_min < 0);
+    TEST_ASSERT_TRUE(stats.latency_us_last < CHUNK_US);
+    TEST_ASSERT_TRUE(stale_frames < old_stale_frames);
+
+    // A requested reset waits for the task's next frame, keeps counters, clears extremes
+    const uint32_t frames_before = stats.frames;
+    const uint32_t latency_max_before = stats.latency_us_max;
+    audio_cadence_request_window_reset(stats);
+    TEST_ASSERT_EQUAL_UINT32(latency_max_before, stats.latency_us_max);
+    audio_cadence_frame(stats, 1, 1, 1, 0, 100, CHUNK_US);
+    TEST_ASSERT_FALSE(stats.window_reset_requested);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.latency_us_max);
+    TEST_ASSERT_EQUAL_INT32((int32_t)CHUNK_US - 100, stats.slack_us_min);
+    TEST_ASSERT_EQUAL_UINT32(frames_before + 1, stats.frames);
+}
+
+// =============================================================================
+// TEST 5: Dropped chunks are counted
+// =============================================================================
+void test_dropped_chunks(void) {
+    audio_cadence_frame(stats, 9, 6, 1, 0, 100, CHUNK_US);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.late_frames);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.dropped_chunks);
+    TEST_ASSERT_EQUAL_UINT32(6, stats.chunks);
+
+    audio_cadence_frame(stats, 1, 1, 1, 0, 100, CHUNK_US);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.late_frames);
+    TEST_ASSERT_EQUAL_INT32(CHUNK_US - 100, stats.slack_us_last);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_chunk_counting);
+    RUN_TEST(test_chunk_timestamp);
+    RUN_TEST(test_counter_wrap);
+    RUN_TEST(test_simulated_task);
+    RUN_TEST(test_dropped_chunks);
+
+    return UNITY_END();
+}
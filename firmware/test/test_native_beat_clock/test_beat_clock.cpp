@@ -0,0 +1,174 @@
+/**
+ * TEST SUITE: Beat Clock (native)
+ *
+ * Validates tempo phase extrapolation between audio frames (beat_clock.h):
+ * - the published velocity matches how the tempo bank phase actually
+ *   advances per novelty sample
+ * - at 120 FPS render with tempo readouts every other audio frame, the
+ *   extrapolated phase advances smoothly where the snapshot phase steps
+ * - wrap to -pi..pi, timer wrap, no extrapolation backwards, cap on stale data
+ *
+ * Run with: pio test -e native -f test_native_beat_clock
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../../src/audio/beat_clock.h"
+#include "../../src/audio/tempo_bank.h"
+
+#define NOVELTY_HISTORY_LENGTH 1024
+#define NOVELTY_PERIOD_US 8000
+#define TEMPO_READOUT_INTERVAL 2
+#define RENDER_PERIOD_US 8333
+
+static tempo_bank bank;
+
+static float wrapped_difference(float a, float b) {
+    return beat_clock_wrap(a - b);
+}
+
+static float read_phase(uint16_t k) {
+    float real, imag;
+    tempo_bank_read(bank, k, 1.0f, &real, &imag);
+    return atan2f(imag, real);
+}
+
+// Novelty with a beat every `period` samples, slightly jittered
+static float novelty_sample(uint32_t n, float period, float jitter) {
+    const float offset = jitter * ((rand() / (float)RAND_MAX) - 0.5f);
+    const float position = fmodf(n + offset, period);
+    return (position < 1.0f ? 1.0f : 0.0f) + 0.02f * (rand() / (float)RAND_MAX);
+}
+
+void setUp(void) {
+    srand(5);
+    float window[NOVELTY_HISTORY_LENGTH];
+    for (uint16_t m = 0; m < NOVELTY_HISTORY_LENGTH; m++) {
+        float x = (m - NOVELTY_HISTORY_LENGTH / 2.0f) / (0.8f * NOVELTY_HISTORY_LENGTH / 2.0f);
+        window[m] = expf(-0.5f * x * x);
+    }
+    TEST_ASSERT_TRUE(tempo_bank_init(bank, NOVELTY_HISTORY_LENGTH, 11, 54, window, TEMPO_BANK_DAMPING));
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Velocity matches the bank's phase advance
+// =============================================================================
+void test_velocity_matches_bank(void) {
+    const uint16_t k = 32;
+    const float period = (float)NOVELTY_HISTORY_LENGTH / k;   // Beats exactly on bin k
+    for (uint32_t n = 0; n < NOVELTY_HISTORY_LENGTH * 2; n++) {
+        tempo_bank_push(bank, novelty_sample(n, period, 0.0f), n >= NOVELTY_HISTORY_LENGTH ? novelty_sample(n - NOVELTY_HISTORY_LENGTH, period, 0.0f) : 0.0f);
+    }
+
+    const float velocity = beat_clock_velocity(k, NOVELTY_HISTORY_LENGTH, NOVELTY_PERIOD_US);
+    float worst = 0.0f;
+    float phase = read_phase(k);
+    for (uint32_t n = NOVELTY_HISTORY_LENGTH * 2; n < NOVELTY_HISTORY_LENGTH * 2 + 200; n++) {
+        tempo_bank_push(bank, novelty_sample(n, period, 0.0f), novelty_sample(n - NOVELTY_HISTORY_LENGTH, period, 0.0f));
+        const float next = read_phase(k);
+        const float predicted = beat_clock_phase(phase, velocity, 0, NOVELTY_PERIOD_US);
+        worst = fmaxf(worst, fabsf(wrapped_difference(next, predicted)));
+        phase = next;
+    }
+
+    printf("[BEAT] bin %u: %.2f rad/s, worst prediction error over one novelty sample %.4f rad\n", k, velocity, worst);
+    TEST_ASSERT_TRUE(worst < 0.02f);
+}
+
+// =============================================================================
+// TEST 2: Render-rate phase is smooth between readouts
+// =============================================================================
+void test_render_smoothness(void) {
+    const uint16_t k = 24;
+    const float period = (float)NOVELTY_HISTORY_LENGTH / k;
+    static float history[NOVELTY_HISTORY_LENGTH];
+    memset(history, 0, sizeof(history));
+    uint16_t head = 0;
+
+    // Published state (what the snapshot carries)
+    float published_phase = 0.0f;
+    uint32_t published_us = 0;
+    const float velocity = beat_clock_velocity(k, NOVELTY_HISTORY_LENGTH, NOVELTY_PERIOD_US);
+
+    uint32_t audio_us = 0, render_us = 0, frame = 0, frames = 0;
+    float last_held = 0.0f, last_extrapolated = 0.0f;
+    float held_worst = 0.0f, extrapolated_worst = 0.0f;
+    const float expected_step = velocity * RENDER_PERIOD_US * 1e-6f;
+
+    while (audio_us < 60000000) {
+        // Render frames up to the next audio frame see the last published state
+        while (render_us + RENDER_PERIOD_US < audio_us + NOVELTY_PERIOD_US) {
+            render_us += RENDER_PERIOD_US;
+            const float held = published_phase;
+            const float extrapolated = beat_clock_phase(published_phase, velocity, published_us, render_us);
+            if (frame > NOVELTY_HISTORY_LENGTH) {
+                held_worst = fmaxf(held_worst, fabsf(wrapped_difference(held, last_held) - expected_step));
+                extrapolated_worst = fmaxf(extrapolated_worst, fabsf(wrapped_difference(extrapolated, last_extrapolated) - expected_step));
+                frames++;
+            }
+            last_held = held;
+            last_extrapolated = extrapolated;
+        }
+
+        // Audio frame: push novelty, read the bank every TEMPO_READOUT_INTERVAL frames
+        audio_us += NOVELTY_PERIOD_US;
+        const float value = novelty_sample(frame, period, 0.6f);
+        tempo_bank_push(bank, value, history[head]);
+        history[head] = value;
+        head = (head + 1) & (NOVELTY_HISTORY_LENGTH - 1);
+        if (++frame % TEMPO_READOUT_INTERVAL == 0) {
+            published_phase = read_phase(k);
+            published_us = audio_us;
+        }
+    }
+
+    printf("[BEAT] %lu render frames at 120 FPS, readout every %d audio frames: worst step deviation held %.3f rad, extrapolated %.3f rad (ideal step %.3f)\n",
+           (unsigned long)frames, TEMPO_READOUT_INTERVAL, held_worst, extrapolated_worst, expected_step);
+    TEST_ASSERT_TRUE(extrapolated_worst < held_worst / 4.0f);
+    TEST_ASSERT_TRUE(extrapolated_worst < 0.1f);
+}
+
+// =============================================================================
+// TEST 3: Wrap, timer wrap, backwards and stale
+// =============================================================================
+void test_edges(void) {
+    const float velocity = 10.0f;   // rad/s
+
+    // Crossing +pi wraps to the negative side
+    float phase = beat_clock_phase(3.0f, velocity, 0, 50000);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 3.5f - 2.0f * (float)M_PI, phase);
+
+    // esp_timer truncated to 32 bits wraps; elapsed time does not
+    phase = beat_clock_phase(0.0f, velocity, 0xFFFFF000u, 0x00001000u);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, velocity * 8192e-6f, phase);
+
+    // Render timestamp before the measurement: no extrapolation backwards
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, beat_clock_phase(1.0f, velocity, 100000, 90000));
+
+    // Stale audio: phase parks after the cap
+    const float capped = beat_clock_phase(0.0f, velocity, 0, BEAT_CLOCK_MAX_EXTRAPOLATION_US);
+    TEST_ASSERT_EQUAL_FLOAT(capped, beat_clock_phase(0.0f, velocity, 0, 5000000));
+
+    // Wrap keeps -pi..pi for large inputs
+    for (float p = -40.0f; p < 40.0f; p += 0.37f) {
+        float wrapped = beat_clock_wrap(p);
+        TEST_ASSERT_TRUE(wrapped >= -(float)M_PI && wrapped <= (float)M_PI);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, sinf(wrapped) - sinf(p));
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_velocity_matches_bank);
+    RUN_TEST(test_render_smoothness);
+    RUN_TEST(test_edges);
+
+    return UNITY_END();
+}
@@ -0,0 +1,147 @@
+/**
+ * TEST SUITE: Beat Event Queue (native)
+ *
+ * Validates the single-producer / single-consumer beat/onset queue
+ * (beat_events.h) between the audio core and the render core:
+ * - FIFO order, full queue drops (and counts) the newest event
+ * - indices survive wrap
+ * - a producer and a consumer thread hammering the queue (producer
+ *   retrying when full) lose, reorder or tear nothing
+ * - stale events are skipped, events stamped just after "now" are kept
+ *
+ * Run with: pio test -e native -f test_native_beat_events
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <thread>
+#include <atomic>
+#include "../../src/audio/beat_events.h"
+
+static beat_event_queue queue;
+
+static beat_event make_event(uint32_t timestamp_us) {
+    beat_event event = {};
+    event.timestamp_us = timestamp_us;
+    event.strength = 0.5f;
+    event.tempo_bin = timestamp_us % 64;
+    event.type = BEAT_EVENT_BEAT;
+    event.pitch_class = timestamp_us % 12;
+    return event;
+}
+
+void setUp(void) {
+    queue = {};
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: FIFO order, drop when full
+// =============================================================================
+void test_fifo_and_full(void) {
+    for (uint32_t i = 0; i < BEAT_EVENT_QUEUE_LENGTH; i++) {
+        TEST_ASSERT_TRUE(beat_event_push(queue, make_event(i)));
+    }
+    TEST_ASSERT_FALSE(beat_event_push(queue, make_event(999)));
+    TEST_ASSERT_EQUAL_UINT32(1, queue.dropped);
+
+    beat_event event;
+    for (uint32_t i = 0; i < BEAT_EVENT_QUEUE_LENGTH; i++) {
+        TEST_ASSERT_TRUE(beat_event_pop(queue, &event));
+        TEST_ASSERT_EQUAL_UINT32(i, event.timestamp_us);
+        TEST_ASSERT_EQUAL_UINT8(i % 12, event.pitch_class);
+    }
+    TEST_ASSERT_FALSE(beat_event_pop(queue, &event));
+}
+
+// =============================================================================
+// TEST 2: Index wrap
+// =============================================================================
+void test_index_wrap(void) {
+    queue.write_index = 0xFFFFFFFDu;
+    queue.read_index = 0xFFFFFFFDu;
+
+    beat_event event;
+    for (uint32_t i = 0; i < 100; i++) {
+        TEST_ASSERT_TRUE(beat_event_push(queue, make_event(i)));
+        TEST_ASSERT_TRUE(beat_event_push(queue, make_event(i + 1000)));
+        TEST_ASSERT_TRUE(beat_event_pop(queue, &event));
+        TEST_ASSERT_EQUAL_UINT32(i, event.timestamp_us);
+        TEST_ASSERT_TRUE(beat_event_pop(queue, &event));
+        TEST_ASSERT_EQUAL_UINT32(i + 1000, event.timestamp_us);
+    }
+    TEST_ASSERT_FALSE(beat_event_pop(queue, &event));
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dropped);
+}
+
+// =============================================================================
+// TEST 3: Producer and consumer threads
+// =============================================================================
+void test_two_threads(void) {
+    const uint32_t total = 200000;
+    std::atomic<bool> done(false);
+    uint32_t received = 0, out_of_order = 0, torn = 0;
+
+    std::thread producer([&]() {
+        for (uint32_t i = 1; i <= total; i++) {
+            while (!beat_event_push(queue, make_event(i))) {
+                std::this_thread::yield();
+            }
+        }
+        done = true;
+    });
+
+    uint32_t last = 0;
+    beat_event event;
+    while (!done || queue.read_index != queue.write_index) {
+        if (beat_event_pop(queue, &event)) {
+            received++;
+            out_of_order += event.timestamp_us <= last;
+            torn += event.tempo_bin != event.timestamp_us % 64 || event.pitch_class != event.timestamp_us % 12;
+            last = event.timestamp_us;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    printf("[EVENTS] %lu pushed: %lu received, %lu full-queue retries, %lu out of order, %lu torn\n",
+           (unsigned long)total, (unsigned long)received, (unsigned long)queue.dropped,
+           (unsigned long)out_of_order, (unsigned long)torn);
+    TEST_ASSERT_EQUAL_UINT32(total, received);
+    TEST_ASSERT_EQUAL_UINT32(0, out_of_order);
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+}
+
+// =============================================================================
+// TEST 4: Stale events are skipped
+// =============================================================================
+void test_stale_skipped(void) {
+    const uint32_t now = 1000000;
+    beat_event_push(queue, make_event(now - 500000));                       // Queued while another pattern ran
+    beat_event_push(queue, make_event(now - BEAT_EVENT_MAX_AGE_US - 1));    // Just too old
+    beat_event_push(queue, make_event(now - 20000));                        // Fresh
+    beat_event_push(queue, make_event(now + 300));                          // Stamped after now was taken
+
+    beat_event event;
+    TEST_ASSERT_TRUE(beat_event_pop_recent(queue, &event, now, BEAT_EVENT_MAX_AGE_US));
+    TEST_ASSERT_EQUAL_UINT32(now - 20000, event.timestamp_us);
+    TEST_ASSERT_TRUE(beat_event_pop_recent(queue, &event, now, BEAT_EVENT_MAX_AGE_US));
+    TEST_ASSERT_EQUAL_UINT32(now + 300, event.timestamp_us);
+    TEST_ASSERT_FALSE(beat_event_pop_recent(queue, &event, now, BEAT_EVENT_MAX_AGE_US));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fifo_and_full);
+    RUN_TEST(test_index_wrap);
+    RUN_TEST(test_two_threads);
+    RUN_TEST(test_stale_skipped);
+
+    return UNITY_END();
+}
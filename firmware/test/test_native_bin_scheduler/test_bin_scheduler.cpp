@@ -0,0 +1,167 @@
+/**
+ * TEST SUITE: Interlaced Bin Scheduler (native)
+ *
+ * Validates bin_scheduler.h on the firmware's real group layout:
+ * - periods follow block length (short windows every frame, long ones less often)
+ * - every group is computed exactly once per period
+ * - phase assignment keeps per-frame work flat (worst frame vs unscheduled)
+ * - held bins ramp between results instead of stepping
+ *
+ * Run with: pio test -e native -f test_native_bin_scheduler
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "../../src/audio/octave_decimator.h"
+#include "../../src/audio/bin_scheduler.h"
+
+#define SAMPLE_RATE 16000
+#define SAMPLE_HISTORY_LENGTH 4096
+#define NUM_OCTAVE_STAGES 4
+#define OCTAVE_HISTORY_LENGTH 512
+#define NUM_FREQS 64
+#define LANES 4
+#define NUM_GROUPS (NUM_FREQS / LANES)
+#define HOP 128
+
+static uint32_t group_window[NUM_GROUPS];   // Full-rate samples
+static uint32_t group_cost[NUM_GROUPS];     // Bin-samples per update
+static uint8_t group_period[NUM_GROUPS];
+static uint8_t group_phase[NUM_GROUPS];
+static uint32_t slot_load[BIN_SCHEDULE_MAX_PERIOD];
+
+// Mirrors init_goertzel_constants_musical() + init_bin_schedule()
+static void init_schedule() {
+    float target[NUM_FREQS], bandwidth[NUM_FREQS];
+    for (int i = 0; i < NUM_FREQS; i++) {
+        target[i] = 110.0f * powf(2.0f, i / 12.0f);
+        bandwidth[i] = target[i] * (powf(2.0f, 1.0f / 24.0f) - 1.0f) * 4.0f;
+    }
+
+    for (int g = 0; g < NUM_GROUPS; g++) {
+        float top_freq = 0.0f, min_bandwidth = bandwidth[g * LANES];
+        for (int lane = 0; lane < LANES; lane++) {
+            top_freq = fmaxf(top_freq, target[g * LANES + lane]);
+            min_bandwidth = fminf(min_bandwidth, bandwidth[g * LANES + lane]);
+        }
+        uint8_t octave = octave_select_stage(top_freq, min_bandwidth, SAMPLE_RATE, NUM_OCTAVE_STAGES, OCTAVE_HISTORY_LENGTH);
+
+        uint16_t length = 0;
+        for (int lane = 0; lane < LANES; lane++) {
+            uint16_t full_rate_block_size = SAMPLE_RATE / bandwidth[g * LANES + lane];
+            while (full_rate_block_size % 4 != 0) {
+                full_rate_block_size -= 1;
+            }
+            uint16_t block_size = full_rate_block_size >> octave;
+            if (block_size > length) length = block_size;
+        }
+
+        group_window[g] = (uint32_t)length << octave;
+        group_cost[g] = (uint32_t)length * LANES;
+        group_period[g] = bin_schedule_period(group_window[g], HOP, BIN_SCHEDULE_MAX_PERIOD);
+    }
+
+    bin_schedule_assign(group_period, group_cost, NUM_GROUPS, BIN_SCHEDULE_MAX_PERIOD, group_phase, slot_load);
+}
+
+void setUp(void) {
+    init_schedule();
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Periods follow block length
+// =============================================================================
+void test_periods_follow_block_length(void) {
+    for (int g = 0; g < NUM_GROUPS; g++) {
+        const uint8_t p = group_period[g];
+        TEST_ASSERT_TRUE(p >= 1 && p <= BIN_SCHEDULE_MAX_PERIOD);
+        TEST_ASSERT_EQUAL(0, p & (p - 1));
+        TEST_ASSERT_TRUE(group_phase[g] < p);
+
+        // At most 1 / BIN_SCHEDULE_OVERLAP of the window is new between updates
+        TEST_ASSERT_TRUE(p == 1 || (uint32_t)p * HOP * BIN_SCHEDULE_OVERLAP <= group_window[g]);
+        // Windows shrink towards the top of the spectrum, so periods never grow
+        if (g > 0) {
+            TEST_ASSERT_TRUE(p <= group_period[g - 1]);
+        }
+        printf("[SCHED] group %2d: window %4u samples, period %u, phase %u\n", g, group_window[g], p, group_phase[g]);
+    }
+
+    // Lowest group integrates the longest and is interlaced, highest runs every frame
+    TEST_ASSERT_TRUE(group_period[0] > 1);
+    TEST_ASSERT_EQUAL(1, group_period[NUM_GROUPS - 1]);
+}
+
+// =============================================================================
+// TEST 2: Every group runs exactly once per period
+// =============================================================================
+void test_each_group_runs_once_per_period(void) {
+    for (int g = 0; g < NUM_GROUPS; g++) {
+        for (uint32_t start = 0; start < 64; start += group_period[g]) {
+            int runs = 0;
+            for (uint32_t frame = start; frame < start + group_period[g]; frame++) {
+                if (bin_schedule_due(group_period[g], group_phase[g], frame)) {
+                    TEST_ASSERT_EQUAL(0, bin_schedule_age(group_period[g], group_phase[g], frame));
+                    runs++;
+                }
+            }
+            TEST_ASSERT_EQUAL(1, runs);
+        }
+    }
+}
+
+// =============================================================================
+// TEST 3: Work per frame stays flat and below the unscheduled cost
+// =============================================================================
+void test_work_is_balanced(void) {
+    uint32_t unscheduled = 0, average = 0, largest_cost = 0;
+    for (int g = 0; g < NUM_GROUPS; g++) {
+        unscheduled += group_cost[g];
+        average += group_cost[g] / group_period[g];
+        if (group_cost[g] > largest_cost) largest_cost = group_cost[g];
+    }
+
+    uint32_t peak = 0, low = UINT32_MAX;
+    for (uint32_t frame = 0; frame < BIN_SCHEDULE_MAX_PERIOD * 4; frame++) {
+        uint32_t work = 0;
+        for (int g = 0; g < NUM_GROUPS; g++) {
+            if (bin_schedule_due(group_period[g], group_phase[g], frame)) work += group_cost[g];
+        }
+        TEST_ASSERT_EQUAL(slot_load[frame % BIN_SCHEDULE_MAX_PERIOD], work);
+        if (work > peak) peak = work;
+        if (work < low) low = work;
+    }
+
+    printf("[SCHED] work units/frame: unscheduled %u, scheduled %u..%u (mean %u)\n", unscheduled, low, peak, average);
+    TEST_ASSERT_TRUE(peak < unscheduled);
+    TEST_ASSERT_TRUE(peak - low <= largest_cost);
+}
+
+// =============================================================================
+// TEST 4: Held bins ramp between their last two results
+// =============================================================================
+void test_interpolation_ramps(void) {
+    // Period 1: always the latest result
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, bin_schedule_interpolate(1.0f, 3.0f, 1, 0));
+
+    // Period 4: quarter steps, reaching the latest result on the last frame
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, bin_schedule_interpolate(1.0f, 3.0f, 4, 0));
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, bin_schedule_interpolate(1.0f, 3.0f, 4, 1));
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, bin_schedule_interpolate(1.0f, 3.0f, 4, 2));
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, bin_schedule_interpolate(1.0f, 3.0f, 4, 3));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_periods_follow_block_length);
+    RUN_TEST(test_each_group_runs_once_per_period);
+    RUN_TEST(test_work_is_balanced);
+    RUN_TEST(test_interpolation_ramps);
+
+    return UNITY_END();
+}
@@ -0,0 +1,466 @@
+/**
+ * TEST SUITE: Constant-Q Spectral Engine (native)
+ *
+ * Validates the spectral-kernel CQT engine (cqt_kernel.h) against the Goertzel
+ * engine on the same input and reports the cost of both:
+ * - FFT against a direct DFT, full and block-sized frames
+ * - kernel frames sized to each bin's block, entry count against one shared frame
+ * - per-bin magnitudes, CQT vs grouped Goertzel, over a whole WAV file
+ * - per-frame work units (deterministic) and timings (reported only): original
+ *   full-rate Goertzel, current grouped/decimated Goertzel, and CQT (one FFT
+ *   per decimation stage and frame size)
+ *
+ * Input: the WAV named by K1_BENCH_WAV (16 kHz mono), or a synthesized
+ * music-like clip written to a temporary WAV and read back.
+ *
+ * Run with: pio test -e native -f test_native_cqt_engine
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include "../../src/audio/mirrored_ring.h"
+#include "../../src/audio/octave_decimator.h"
+#include "../../src/audio/goertzel_kernel.h"
+#include "../../src/audio/cqt_kernel.h"
+#include "../test_utils/wav_io.h"
+
+#define SAMPLE_RATE 16000
+#define SAMPLE_HISTORY_LENGTH 4096
+#define NUM_OCTAVE_STAGES 4
+#define OCTAVE_HISTORY_LENGTH 512
+#define NUM_FREQS 64
+#define CHUNK_SIZE 128
+#define CQT_FFT_SIZE 256
+#ifndef CQT_KERNEL_THRESHOLD
+#define CQT_KERNEL_THRESHOLD 0.001f
+#endif
+
+typedef struct {
+    float target_freq;
+    uint8_t octave;
+    uint16_t block_size;
+    uint16_t full_rate_block_size;
+    float window_step;
+    float coeff;
+    float omega;
+} test_bin;
+
+static test_bin bins[NUM_FREQS];
+static float window_lookup[4096];
+
+static float full_storage[SAMPLE_HISTORY_LENGTH * 2];
+static float octave_storage[NUM_OCTAVE_STAGES - 1][OCTAVE_HISTORY_LENGTH * 2];
+static mirrored_ring full_history = { full_storage, SAMPLE_HISTORY_LENGTH, 0 };
+static mirrored_ring octave_history[NUM_OCTAVE_STAGES - 1] = {
+    { octave_storage[0], OCTAVE_HISTORY_LENGTH, 0 },
+    { octave_storage[1], OCTAVE_HISTORY_LENGTH, 0 },
+    { octave_storage[2], OCTAVE_HISTORY_LENGTH, 0 },
+};
+static halfband_decimator octave_filters[NUM_OCTAVE_STAGES - 1];
+
+static goertzel_bin_group groups[NUM_FREQS / GOERTZEL_LANES];
+static std::vector<int16_t> group_windows;
+
+static cqt_complex twiddles[CQT_FFT_SIZE / 2];
+static cqt_complex frame[CQT_FFT_SIZE];
+static std::vector<cqt_kernel_entry> kernel_entries;
+static cqt_bin_kernel bin_kernels[NUM_FREQS];
+
+static WavData wav;
+
+static const float* stage_history(uint8_t octave) {
+    return octave == 0 ? mirrored_ring_window(full_history) : mirrored_ring_window(octave_history[octave - 1]);
+}
+
+static uint16_t stage_history_length(uint8_t octave) {
+    return octave == 0 ? SAMPLE_HISTORY_LENGTH : OCTAVE_HISTORY_LENGTH;
+}
+
+// Mirrors init_goertzel_constants_musical() / init_goertzel()
+static void init_bins() {
+    float bandwidths[NUM_FREQS];
+    for (int i = 0; i < NUM_FREQS; i++) {
+        bins[i].target_freq = 110.0f * powf(2.0f, i / 12.0f);
+        bandwidths[i] = bins[i].target_freq * (powf(2.0f, 1.0f / 24.0f) - 1.0f) * 4.0f;
+    }
+
+    for (int g = 0; g < NUM_FREQS; g += GOERTZEL_LANES) {
+        float top_freq = 0.0f, min_bandwidth = bandwidths[g];
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            top_freq = fmaxf(top_freq, bins[g + lane].target_freq);
+            min_bandwidth = fminf(min_bandwidth, bandwidths[g + lane]);
+        }
+        uint8_t octave = octave_select_stage(top_freq, min_bandwidth, SAMPLE_RATE, NUM_OCTAVE_STAGES, OCTAVE_HISTORY_LENGTH);
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            bins[g + lane].octave = octave;
+        }
+    }
+
+    for (int i = 0; i < NUM_FREQS; i++) {
+        test_bin& bin = bins[i];
+        uint16_t full_rate_block_size = SAMPLE_RATE / bandwidths[i];
+        full_rate_block_size -= full_rate_block_size % 4;
+        float k = (int)(0.5 + ((full_rate_block_size * bin.target_freq) / SAMPLE_RATE));
+
+        bin.full_rate_block_size = full_rate_block_size;
+        bin.block_size = full_rate_block_size >> bin.octave;
+        bin.window_step = 4096.0 / bin.block_size;
+        bin.omega = (2.0 * M_PI * k * (1 << bin.octave)) / full_rate_block_size;
+        bin.coeff = 2.0 * cos(bin.omega);
+    }
+
+    for (int i = 0; i < 2048; i++) {
+        float n_minus_halfN = i - 2048 / 2;
+        float weight = exp(-0.5 * pow((n_minus_halfN / (0.8 * 2048 / 2)), 2));
+        window_lookup[i] = window_lookup[4095 - i] = weight;
+    }
+}
+
+// Mirrors init_goertzel_window_tables()
+static void init_groups() {
+    size_t total = 0;
+    for (int g = 0; g < NUM_FREQS / GOERTZEL_LANES; g++) {
+        groups[g].first_bin = g * GOERTZEL_LANES;
+        groups[g].length = 0;
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            if (bins[g * GOERTZEL_LANES + lane].block_size > groups[g].length) {
+                groups[g].length = bins[g * GOERTZEL_LANES + lane].block_size;
+            }
+        }
+        total += groups[g].length * GOERTZEL_LANES;
+    }
+
+    group_windows.resize(total);
+    int16_t* table = group_windows.data();
+    for (int g = 0; g < NUM_FREQS / GOERTZEL_LANES; g++) {
+        uint16_t block_sizes[GOERTZEL_LANES];
+        float steps[GOERTZEL_LANES];
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            block_sizes[lane] = bins[g * GOERTZEL_LANES + lane].block_size;
+            steps[lane] = bins[g * GOERTZEL_LANES + lane].window_step;
+        }
+        goertzel_build_group_window(table, groups[g].length, block_sizes, steps, window_lookup);
+        groups[g].window = table;
+        table += groups[g].length * GOERTZEL_LANES;
+    }
+}
+
+// Mirrors init_cqt_engine()
+static void init_cqt() {
+    cqt_fft_init_twiddles(twiddles, CQT_FFT_SIZE);
+
+    static cqt_complex scratch[CQT_FFT_SIZE];
+    float window[CQT_FFT_SIZE];
+    for (int i = 0; i < NUM_FREQS; i++) {
+        float window_pos = 0.0f;
+        for (uint16_t n = 0; n < bins[i].block_size; n++) {
+            window[n] = window_lookup[uint32_t(window_pos)];
+            window_pos += bins[i].window_step;
+        }
+
+        const uint16_t frame_size = cqt_frame_size(bins[i].block_size);
+        uint16_t count = cqt_build_kernel(NULL, frame_size, bins[i].block_size, window, bins[i].omega, CQT_KERNEL_THRESHOLD, scratch, twiddles, CQT_FFT_SIZE);
+        bin_kernels[i].first = kernel_entries.size();
+        bin_kernels[i].count = count;
+        bin_kernels[i].frame_size = frame_size;
+        kernel_entries.resize(kernel_entries.size() + count);
+        cqt_build_kernel(&kernel_entries[bin_kernels[i].first], frame_size, bins[i].block_size, window, bins[i].omega, CQT_KERNEL_THRESHOLD, scratch, twiddles, CQT_FFT_SIZE);
+    }
+}
+
+static void feed_chunk(const float* samples) {
+    float stage_in[CHUNK_SIZE], stage_out[CHUNK_SIZE / 2];
+    uint16_t count = CHUNK_SIZE;
+
+    mirrored_ring_write(full_history, samples, CHUNK_SIZE);
+    memcpy(stage_in, samples, sizeof(stage_in));
+    for (int s = 0; s < NUM_OCTAVE_STAGES - 1; s++) {
+        halfband_decimate(octave_filters[s], stage_in, count, stage_out);
+        count /= 2;
+        mirrored_ring_write(octave_history[s], stage_out, count);
+        memcpy(stage_in, stage_out, count * sizeof(float));
+    }
+}
+
+// Original engine: 64 independent full-rate Goertzel passes
+static void magnitudes_full_rate(float* out) {
+    const float* history = stage_history(0);
+    for (int i = 0; i < NUM_FREQS; i++) {
+        const uint16_t block_size = bins[i].full_rate_block_size;
+        const float coeff = 2.0f * cosf(bins[i].omega / (1 << bins[i].octave));
+        const float window_step = 4096.0f / block_size;
+        const float* sample_ptr = &history[(SAMPLE_HISTORY_LENGTH - 1) - block_size];
+        float q1 = 0, q2 = 0, window_pos = 0.0f;
+        for (uint16_t n = 0; n < block_size; n++) {
+            float q0 = coeff * q1 - q2 + sample_ptr[n] * window_lookup[uint32_t(window_pos)];
+            q2 = q1;
+            q1 = q0;
+            window_pos += window_step;
+        }
+        out[i] = ((q1 * q1) + (q2 * q2) - q1 * q2 * coeff) / (block_size / 2.0f);
+    }
+}
+
+// Current Goertzel engine: calculate_magnitudes_grouped()
+static void magnitudes_goertzel(float* out) {
+    for (int g = 0; g < NUM_FREQS / GOERTZEL_LANES; g++) {
+        const uint8_t octave = bins[groups[g].first_bin].octave;
+        const float* history = &stage_history(octave)[(stage_history_length(octave) - 1) - groups[g].length];
+        float coeff[GOERTZEL_LANES], q1[GOERTZEL_LANES], q2[GOERTZEL_LANES];
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            coeff[lane] = bins[groups[g].first_bin + lane].coeff;
+        }
+        goertzel_run_group(history, groups[g].window, groups[g].length, coeff, q1, q2);
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            int bin = groups[g].first_bin + lane;
+            out[bin] = ((q1[lane] * q1[lane]) + (q2[lane] * q2[lane]) - q1[lane] * q2[lane] * coeff[lane]) / (bins[bin].block_size / 2.0f) * (1 << octave);
+        }
+    }
+}
+
+// CQT engine: calculate_magnitudes_cqt()
+static void magnitudes_cqt(float* out) {
+    int8_t loaded_octave = -1;
+    uint16_t loaded_size = 0;
+    for (int i = 0; i < NUM_FREQS; i++) {
+        const uint8_t octave = bins[i].octave;
+        const uint16_t size = bin_kernels[i].frame_size;
+        if (octave != loaded_octave || size != loaded_size) {
+            const float* history = &stage_history(octave)[(stage_history_length(octave) - 1) - size];
+            for (int m = 0; m < size; m++) {
+                frame[m].re = history[m];
+                frame[m].im = 0.0f;
+            }
+            cqt_fft(frame, size, twiddles, CQT_FFT_SIZE);
+            loaded_octave = octave;
+            loaded_size = size;
+        }
+        float magnitude_squared = cqt_apply_kernel(frame, &kernel_entries[bin_kernels[i].first], bin_kernels[i].count);
+        out[i] = magnitude_squared / (bins[i].block_size / 2.0f) * (1 << octave);
+    }
+}
+
+// Work units of one magnitudes_cqt() frame, as counted by calculate_magnitudes_cqt()
+static uint32_t cqt_work_units() {
+    uint32_t work = 0;
+    int8_t loaded_octave = -1;
+    uint16_t loaded_size = 0;
+    for (int i = 0; i < NUM_FREQS; i++) {
+        const uint16_t size = bin_kernels[i].frame_size;
+        if (bins[i].octave != loaded_octave || size != loaded_size) {
+            uint32_t stages = 0;
+            while ((1u << stages) < size) stages++;
+            work += (size / 2) * stages;
+            loaded_octave = bins[i].octave;
+            loaded_size = size;
+        }
+        work += bin_kernels[i].count;
+    }
+    return work;
+}
+
+// A few seconds of chords, kick and hi-hat noise at 16 kHz
+static void synthesize_clip(std::vector<float>& clip) {
+    const float chords[4][3] = { { 220.0f, 277.18f, 329.63f }, { 196.0f, 246.94f, 293.66f },
+                                 { 174.61f, 220.0f, 261.63f }, { 164.81f, 207.65f, 246.94f } };
+    clip.resize(SAMPLE_RATE * 4);
+    uint32_t seed = 1;
+    for (size_t n = 0; n < clip.size(); n++) {
+        float t = (float)n / SAMPLE_RATE;
+        const float* chord = chords[(n / (SAMPLE_RATE / 2)) % 4];
+        float s = 0.0f;
+        for (int v = 0; v < 3; v++) {
+            s += 0.12f * sinf(2.0f * (float)M_PI * chord[v] * t) + 0.03f * sinf(4.0f * (float)M_PI * chord[v] * t);
+        }
+        float beat_t = fmodf(t, 0.5f);
+        s += 0.4f * expf(-beat_t * 18.0f) * sinf(2.0f * (float)M_PI * 55.0f * beat_t);
+        seed = seed * 1664525u + 1013904223u;
+        float hat_t = fmodf(t + 0.25f, 0.5f);
+        s += 0.1f * expf(-hat_t * 60.0f) * ((float)(seed >> 8) / 16777216.0f - 0.5f);
+        clip[n] = s;
+    }
+}
+
+static void load_input() {
+    const char* path = getenv("K1_BENCH_WAV");
+    if (path != NULL && wav_load(path, wav) && wav.sample_rate == SAMPLE_RATE) {
+        printf("[INPUT] %s (%zu samples)\n", path, wav.samples.size());
+        return;
+    }
+
+    std::vector<float> clip;
+    synthesize_clip(clip);
+    const char* tmp_path = "/tmp/k1_cqt_bench.wav";
+    wav_save_mono16(tmp_path, clip.data(), clip.size(), SAMPLE_RATE);
+    TEST_ASSERT_TRUE(wav_load(tmp_path, wav));
+    printf("[INPUT] synthesized clip via %s (%zu samples)\n", tmp_path, wav.samples.size());
+}
+
+void setUp(void) {
+    memset(full_storage, 0, sizeof(full_storage));
+    memset(octave_storage, 0, sizeof(octave_storage));
+    full_history.head = 0;
+    for (int s = 0; s < NUM_OCTAVE_STAGES - 1; s++) {
+        octave_history[s].head = 0;
+        memset(&octave_filters[s], 0, sizeof(halfband_decimator));
+    }
+}
+
+void tearDown(void) {}
+
+// =============================================================================
+// TEST 1: FFT matches a direct DFT
+// =============================================================================
+void test_fft_matches_dft(void) {
+    cqt_complex data[CQT_FFT_SIZE];
+    for (int m = 0; m < CQT_FFT_SIZE; m++) {
+        data[m].re = sinf(0.37f * m) + 0.25f * cosf(1.9f * m);
+        data[m].im = 0.1f * sinf(0.05f * m);
+    }
+    cqt_complex input[CQT_FFT_SIZE];
+    memcpy(input, data, sizeof(input));
+    cqt_fft(data, CQT_FFT_SIZE, twiddles);
+
+    for (int j = 0; j < CQT_FFT_SIZE; j += 7) {
+        double re = 0.0, im = 0.0;
+        for (int m = 0; m < CQT_FFT_SIZE; m++) {
+            double a = -2.0 * M_PI * j * m / CQT_FFT_SIZE;
+            re += input[m].re * cos(a) - input[m].im * sin(a);
+            im += input[m].re * sin(a) + input[m].im * cos(a);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, (float)re, data[j].re);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, (float)im, data[j].im);
+    }
+
+    // Smaller frames share the CQT_FFT_SIZE twiddle table
+    cqt_complex small[32];
+    memcpy(small, input, sizeof(small));
+    cqt_fft(small, 32, twiddles, CQT_FFT_SIZE);
+    for (int j = 0; j < 32; j++) {
+        double re = 0.0, im = 0.0;
+        for (int m = 0; m < 32; m++) {
+            double a = -2.0 * M_PI * j * m / 32;
+            re += input[m].re * cos(a) - input[m].im * sin(a);
+            im += input[m].re * sin(a) + input[m].im * cos(a);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, (float)re, small[j].re);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, (float)im, small[j].im);
+    }
+}
+
+// =============================================================================
+// TEST 2: Every bin fits its FFT frame, kernels are sized to the block
+// =============================================================================
+void test_kernels_fit_and_are_pruned(void) {
+    for (int i = 0; i < NUM_FREQS; i++) {
+        TEST_ASSERT_TRUE(bins[i].block_size <= bin_kernels[i].frame_size);
+        TEST_ASSERT_TRUE(bin_kernels[i].frame_size < 2 * bins[i].block_size);
+        TEST_ASSERT_TRUE(bin_kernels[i].frame_size <= CQT_FFT_SIZE);
+        TEST_ASSERT_TRUE(bin_kernels[i].count > 0);
+        TEST_ASSERT_TRUE(bin_kernels[i].count <= bin_kernels[i].frame_size);
+    }
+    const size_t dense = (size_t)NUM_FREQS * CQT_FFT_SIZE;
+    printf("[CQT] %zu kernel entries for %d bins (%.1f per bin, %zu bytes), %.0f%% of %d-point kernels for every bin\n",
+           kernel_entries.size(), NUM_FREQS, (double)kernel_entries.size() / NUM_FREQS,
+           kernel_entries.size() * sizeof(cqt_kernel_entry), 100.0 * kernel_entries.size() / dense, CQT_FFT_SIZE);
+    // Block-sized frames hold under a third of the entries one shared frame needed
+    TEST_ASSERT_TRUE(kernel_entries.size() * 3 < dense);
+}
+
+// =============================================================================
+// TEST 3: CQT spectrogram matches the Goertzel engine over the WAV input
+// =============================================================================
+void test_cqt_matches_goertzel_on_wav(void) {
+    float goertzel[NUM_FREQS], cqt[NUM_FREQS];
+    double worst = 0.0;
+    uint32_t frames = 0;
+
+    for (size_t c = 0; c + CHUNK_SIZE <= wav.samples.size(); c += CHUNK_SIZE) {
+        feed_chunk(&wav.samples[c]);
+        if (c < SAMPLE_HISTORY_LENGTH) {
+            continue;  // histories still filling
+        }
+
+        magnitudes_goertzel(goertzel);
+        magnitudes_cqt(cqt);
+
+        float peak = 0.0f;
+        for (int i = 0; i < NUM_FREQS; i++) peak = fmaxf(peak, goertzel[i]);
+        if (peak <= 0.0f) continue;
+
+        for (int i = 0; i < NUM_FREQS; i++) {
+            double error = fabs(goertzel[i] - cqt[i]) / peak;
+            if (error > worst) worst = error;
+        }
+        frames++;
+    }
+
+    printf("[CQT] %u frames, worst per-bin error %.4f of frame peak\n", frames, worst);
+    TEST_ASSERT_TRUE(frames > 0);
+    TEST_ASSERT_TRUE(worst < 0.01);
+}
+
+// =============================================================================
+// TEST 4: Per-frame benchmark on the WAV input
+// =============================================================================
+void test_benchmark_engines(void) {
+    using clock = std::chrono::steady_clock;
+    float out[NUM_FREQS];
+    volatile float sink = 0.0f;
+    double full_ns = 0.0, goertzel_ns = 0.0, cqt_ns = 0.0;
+    uint32_t frames = 0;
+
+    for (size_t c = 0; c + CHUNK_SIZE <= wav.samples.size(); c += CHUNK_SIZE) {
+        feed_chunk(&wav.samples[c]);
+
+        auto t0 = clock::now();
+        magnitudes_full_rate(out);
+        sink = sink + out[0];
+        auto t1 = clock::now();
+        magnitudes_goertzel(out);
+        sink = sink + out[0];
+        auto t2 = clock::now();
+        magnitudes_cqt(out);
+        sink = sink + out[0];
+        auto t3 = clock::now();
+
+        full_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        goertzel_ns += std::chrono::duration<double, std::nano>(t2 - t1).count();
+        cqt_ns += std::chrono::duration<double, std::nano>(t3 - t2).count();
+        frames++;
+    }
+
+    // Work units: samples through a resonator (Goertzel), kernel MACs plus FFT butterflies (CQT)
+    uint32_t full_work = 0, goertzel_work = 0;
+    for (int i = 0; i < NUM_FREQS; i++) {
+        full_work += bins[i].full_rate_block_size;
+        goertzel_work += bins[i].block_size;
+    }
+    const uint32_t cqt_work = cqt_work_units();
+
+    printf("[BENCH] per frame: full-rate Goertzel %.1f us, grouped/decimated Goertzel %.1f us, CQT %.1f us\n",
+           full_ns / frames / 1000.0, goertzel_ns / frames / 1000.0, cqt_ns / frames / 1000.0);
+    printf("[BENCH] work units per frame: full-rate Goertzel %u, grouped/decimated Goertzel %u, CQT %u\n",
+           (unsigned)full_work, (unsigned)goertzel_work, (unsigned)cqt_work);
+    TEST_ASSERT_TRUE(goertzel_work < full_work);
+    TEST_ASSERT_TRUE(cqt_work < full_work);
+}
+
+int main(int argc, char** argv) {
+    init_bins();
+    init_groups();
+    init_cqt();
+
+    UNITY_BEGIN();
+
+    load_input();
+    RUN_TEST(test_fft_matches_dft);
+    RUN_TEST(test_kernels_fit_and_are_pruned);
+    RUN_TEST(test_cqt_matches_goertzel_on_wav);
+    RUN_TEST(test_benchmark_engines);
+
+    return UNITY_END();
+}
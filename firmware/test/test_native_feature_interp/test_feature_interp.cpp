@@ -0,0 +1,183 @@
+/**
+ * TEST SUITE: Render-Rate Feature Interpolation (native)
+ *
+ * Validates the previous -> current frame blend (feature_interp.h):
+ * - weights at the edges: before the frame, one period after, first
+ *   frame / stalled audio, timer wrap
+ * - linear mode is continuous across frame arrivals when frames are on time
+ * - at 120 and 200 FPS render over 8 ms (default) and 20 ms (reduced
+ *   rate) analysis frames with timing jitter, interpolated features move
+ *   smoothly where held values stair-step
+ *
+ * Run with: pio test -e native -f test_native_feature_interp
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../src/audio/feature_interp.h"
+
+#define AUDIO_FRAME_US 8000
+#define REDUCED_AUDIO_FRAME_US 20000
+
+// What the snapshot carries for one feature
+typedef struct {
+    float previous;
+    float current;
+    uint32_t previous_us;
+    uint32_t current_us;
+} published_feature;
+
+// Smooth feature with some motion (a VU envelope, say)
+static float feature_signal(uint32_t t_us) {
+    const float t = t_us * 1e-6f;
+    return 0.5f + 0.3f * sinf(2.0f * (float)M_PI * 1.7f * t) + 0.15f * sinf(2.0f * (float)M_PI * 5.3f * t);
+}
+
+void setUp(void) {
+    srand(11);
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Weights at the edges
+// =============================================================================
+void test_weight_edges(void) {
+    // Render timestamp before the current frame: still on the previous one
+    feature_interp w = feature_interp_weights(10000, 18000, 17000);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, w.linear);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, w.damped);
+
+    // Halfway through the period
+    w = feature_interp_weights(10000, 18000, 22000);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f, w.linear);
+    TEST_ASSERT_TRUE(w.damped > 0.5f && w.damped < 1.0f);
+
+    // One period on: linear reaches the current frame, damped within 4%
+    w = feature_interp_weights(10000, 18000, 26000);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, w.linear);
+    TEST_ASSERT_TRUE(w.damped > 0.95f && w.damped < 1.0f);
+
+    // Late next frame: linear holds, damped keeps settling
+    w = feature_interp_weights(10000, 18000, 40000);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, w.linear);
+    TEST_ASSERT_TRUE(w.damped > 0.999f);
+
+    // First frame (no previous) and stalled audio snap to the current frame
+    w = feature_interp_weights(0, 5000000, 5000100);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, w.linear);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, w.damped);
+    w = feature_interp_weights(18000, 18000, 18100);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, w.linear);
+
+    // esp_timer truncated to 32 bits wraps; the period does not
+    w = feature_interp_weights(0xFFFFE000u, 0x00000000u, 0x00001000u);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f, w.linear);
+}
+
+// =============================================================================
+// TEST 2: Linear mode is continuous across frame arrivals
+// =============================================================================
+void test_linear_continuity(void) {
+    published_feature feature = {0.2f, 0.6f, 0, AUDIO_FRAME_US};
+
+    // Just before the next frame arrives
+    const uint32_t arrival_us = 2 * AUDIO_FRAME_US;
+    const float before = feature_interp_blend(feature.previous, feature.current,
+                                              feature_interp_weights(feature.previous_us, feature.current_us, arrival_us - 1).linear);
+
+    // Next frame published: current becomes previous
+    feature.previous = feature.current;
+    feature.previous_us = feature.current_us;
+    feature.current = 0.9f;
+    feature.current_us = arrival_us;
+    const float after = feature_interp_blend(feature.previous, feature.current,
+                                             feature_interp_weights(feature.previous_us, feature.current_us, arrival_us).linear);
+
+    printf("[INTERP] across a frame arrival: %.5f -> %.5f\n", before, after);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, before, after);
+}
+
+// =============================================================================
+// TEST 3: Smoothness at render rate
+// =============================================================================
+static void render_run(uint32_t audio_period_us, uint32_t render_period_us, float* held_jerk, float* linear_jerk, float* damped_jerk,
+                       float* held_error, float* linear_error, float* damped_error) {
+    published_feature feature = {0.0f, 0.0f, 0, 0};
+    uint32_t next_audio_us = audio_period_us;
+    uint32_t frames = 0;
+    float last[3][2] = {{0}};
+    double jerk[3] = {0}, error[3] = {0};
+
+    for (uint32_t render_us = render_period_us; render_us < 10000000; render_us += render_period_us) {
+        // Audio frames published up to this render timestamp, stamped up to 1 ms before publication
+        while (next_audio_us <= render_us) {
+            const uint32_t stamp_us = next_audio_us - (uint32_t)(rand() % 1000);
+            feature.previous = feature.current;
+            feature.previous_us = feature.current_us;
+            feature.current = feature_signal(stamp_us);
+            feature.current_us = stamp_us;
+            next_audio_us += audio_period_us;
+        }
+
+        const feature_interp w = feature_interp_weights(feature.previous_us, feature.current_us, render_us);
+        const float value[3] = {
+            feature.current,
+            feature_interp_blend(feature.previous, feature.current, feature_interp_weight(w, FEATURE_INTERP_LINEAR)),
+            feature_interp_blend(feature.previous, feature.current, feature_interp_weight(w, FEATURE_INTERP_DAMPED)),
+        };
+
+        // Jerkiness: second difference across render frames; error: against the true signal
+        if (++frames > 10) {
+            for (int m = 0; m < 3; m++) {
+                const float second = value[m] - 2.0f * last[m][0] + last[m][1];
+                jerk[m] += second * second;
+                const float miss = value[m] - feature_signal(render_us);
+                error[m] += miss * miss;
+            }
+        }
+        for (int m = 0; m < 3; m++) {
+            last[m][1] = last[m][0];
+            last[m][0] = value[m];
+        }
+    }
+
+    const uint32_t counted = frames - 10;
+    *held_jerk = sqrtf(jerk[0] / counted);
+    *linear_jerk = sqrtf(jerk[1] / counted);
+    *damped_jerk = sqrtf(jerk[2] / counted);
+    *held_error = sqrtf(error[0] / counted);
+    *linear_error = sqrtf(error[1] / counted);
+    *damped_error = sqrtf(error[2] / counted);
+}
+
+void test_render_smoothness(void) {
+    const uint32_t audio_periods[] = {AUDIO_FRAME_US, REDUCED_AUDIO_FRAME_US, REDUCED_AUDIO_FRAME_US};
+    const uint32_t render_periods[] = {5000, 8333, 5000};
+    for (int p = 0; p < 3; p++) {
+        float held_jerk, linear_jerk, damped_jerk, held_error, linear_error, damped_error;
+        render_run(audio_periods[p], render_periods[p], &held_jerk, &linear_jerk, &damped_jerk, &held_error, &linear_error, &damped_error);
+
+        printf("[INTERP] %u FPS over %u us audio frames: RMS second difference held %.5f, linear %.5f, damped %.5f; "
+               "RMS error vs signal held %.4f, linear %.4f, damped %.4f\n",
+               (unsigned)(1000000 / render_periods[p]), (unsigned)audio_periods[p],
+               held_jerk, linear_jerk, damped_jerk, held_error, linear_error, damped_error);
+        TEST_ASSERT_TRUE(linear_jerk < held_jerk / 4.0f);
+        TEST_ASSERT_TRUE(damped_jerk < held_jerk / 2.0f);
+        TEST_ASSERT_TRUE(damped_error < linear_error);   // Less added lag
+        TEST_ASSERT_TRUE(linear_error < 2.5f * held_error);
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_weight_edges);
+    RUN_TEST(test_linear_continuity);
+    RUN_TEST(test_render_smoothness);
+
+    return UNITY_END();
+}
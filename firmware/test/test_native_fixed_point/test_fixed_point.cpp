@@ -0,0 +1,253 @@
+/**
+ * TEST SUITE: Fixed-Point Goertzel Path (native)
+ *
+ * Validates the AUDIO_FIXED_POINT kernels (goertzel_fixed.h) against the float
+ * path on every bin:
+ * - spectral bins (16 kHz layout, longest blocks) for loud, quiet and noisy input
+ * - 4-lane fixed kernel matches the single-bin fixed kernel exactly
+ * - tempo bins over a 125 Hz novelty curve
+ * - worst-case full-scale on-bin input does not wrap the int32 state
+ *
+ * Run with: pio test -e native -f test_native_fixed_point
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "../../src/audio/goertzel_fixed.h"
+
+#define SAMPLE_RATE 16000
+#define SAMPLE_HISTORY_LENGTH 4096
+#define NUM_FREQS 64
+#define NUM_TEMPI 64
+#define NOVELTY_HISTORY_LENGTH 2048
+#define NOVELTY_LOG_HZ 125                  // One novelty sample per 8 ms audio frame
+
+typedef struct {
+    uint16_t block_size;
+    float window_step;
+    float coeff;
+    int32_t coeff_q30;
+    uint8_t fixed_shift;
+} test_bin;
+
+static test_bin bins[NUM_FREQS];
+static test_bin tempo_bins[NUM_TEMPI];
+static float window_float[4096];
+static int16_t window_q15[4096];
+static float history_float[SAMPLE_HISTORY_LENGTH];
+static int16_t history_q15[SAMPLE_HISTORY_LENGTH];
+
+static void finish_bin(test_bin& bin, float k) {
+    float w = (2.0 * M_PI * k) / bin.block_size;
+    bin.coeff = 2.0 * cos(w);
+    bin.window_step = 4096.0 / bin.block_size;
+    bin.coeff_q30 = goertzel_coeff_to_q30(bin.coeff);
+    bin.fixed_shift = goertzel_fixed_shift(bin.block_size, bin.coeff);
+}
+
+static void init_bins() {
+    // Spectral bins as in init_goertzel() at full rate (longest blocks = worst case)
+    for (int i = 0; i < NUM_FREQS; i++) {
+        float target = 110.0f * powf(2.0f, i / 12.0f);
+        uint16_t block_size = SAMPLE_RATE / (target * (powf(2.0f, 1.0f / 24.0f) - 1.0f) * 4.0f);
+        block_size -= block_size % 4;
+        bins[i].block_size = block_size;
+        finish_bin(bins[i], (int)(0.5 + (block_size * target) / SAMPLE_RATE));
+    }
+
+    // Tempo bins as in init_tempo_goertzel_constants(): 32-192 BPM
+    for (int i = 0; i < NUM_TEMPI; i++) {
+        float target_hz = (32.0f + (160.0f * i) / NUM_TEMPI) / 60.0f;
+        float step_hz = (160.0f / NUM_TEMPI) / 60.0f;
+        uint16_t block_size = NOVELTY_LOG_HZ / (step_hz * 0.5f);
+        if (block_size > NOVELTY_HISTORY_LENGTH) block_size = NOVELTY_HISTORY_LENGTH;
+        tempo_bins[i].block_size = block_size;
+        finish_bin(tempo_bins[i], (int)(0.5 + (block_size * target_hz) / NOVELTY_LOG_HZ));
+    }
+
+    // Gaussian window, sigma 0.8 (init_window_lookup)
+    for (int i = 0; i < 2048; i++) {
+        float n_minus_halfN = i - 2048 / 2;
+        float weight = exp(-0.5 * pow((n_minus_halfN / (0.8 * 2048 / 2)), 2));
+        window_float[i] = window_float[4095 - i] = weight;
+        window_q15[i] = window_q15[4095 - i] = goertzel_float_to_q15(weight);
+    }
+}
+
+// Float path: calculate_magnitude_of_bin() loop, normalised magnitude squared
+static float magnitude_float(const test_bin& bin, const float* samples) {
+    float q1 = 0, q2 = 0, window_pos = 0.0f;
+    for (uint16_t i = 0; i < bin.block_size; i++) {
+        float q0 = bin.coeff * q1 - q2 + samples[i] * window_float[uint32_t(window_pos)];
+        q2 = q1;
+        q1 = q0;
+        window_pos += bin.window_step;
+    }
+    return ((q1 * q1) + (q2 * q2) - q1 * q2 * bin.coeff) / (bin.block_size / 2.0f);
+}
+
+static float magnitude_from_state(const test_bin& bin, int32_t q1_fixed, int32_t q2_fixed) {
+    float q1 = goertzel_fixed_to_float(q1_fixed, bin.fixed_shift);
+    float q2 = goertzel_fixed_to_float(q2_fixed, bin.fixed_shift);
+    return ((q1 * q1) + (q2 * q2) - q1 * q2 * bin.coeff) / (bin.block_size / 2.0f);
+}
+
+static float magnitude_fixed(const test_bin& bin, const int16_t* samples) {
+    int32_t q1, q2;
+    goertzel_run_fixed(samples, bin.block_size, window_q15, bin.window_step, bin.coeff_q30, bin.fixed_shift, &q1, &q2);
+    return magnitude_from_state(bin, q1, q2);
+}
+
+static void fill_history(float tone_hz, float tone_amp, float noise_amp, uint32_t seed) {
+    for (int i = 0; i < SAMPLE_HISTORY_LENGTH; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = (float)(seed >> 8) / 16777216.0f - 0.5f;
+        history_float[i] = tone_amp * sinf(2.0f * (float)M_PI * tone_hz * i / SAMPLE_RATE) + noise_amp * noise;
+        history_q15[i] = goertzel_float_to_q15(history_float[i]);
+    }
+}
+
+// Compare every spectral bin; error bound relative to the frame peak plus a floor
+// for the Q15 input quantisation (1 LSB = 3e-5 full scale)
+static void assert_spectral_bins_match(float relative_bound) {
+    float reference[NUM_FREQS];
+    float peak = 0.0f;
+    for (int i = 0; i < NUM_FREQS; i++) {
+        const float* samples = &history_float[(SAMPLE_HISTORY_LENGTH - 1) - bins[i].block_size];
+        reference[i] = magnitude_float(bins[i], samples);
+        peak = fmaxf(peak, reference[i]);
+    }
+
+    for (int i = 0; i < NUM_FREQS; i++) {
+        const int16_t* samples = &history_q15[(SAMPLE_HISTORY_LENGTH - 1) - bins[i].block_size];
+        TEST_ASSERT_FLOAT_WITHIN(peak * relative_bound + 1e-6f, reference[i], magnitude_fixed(bins[i], samples));
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// =============================================================================
+// TEST 1: Scaling analysis stays inside the int32 budget
+// =============================================================================
+void test_shift_bounds(void) {
+    for (int i = 0; i < NUM_FREQS; i++) {
+        float sine = sqrtf(1.0f - 0.25f * bins[i].coeff * bins[i].coeff);
+        double bound = (double)bins[i].block_size / sine * (1 << 30) / (1 << bins[i].fixed_shift);
+        TEST_ASSERT_TRUE(bound <= (double)(1 << 29));
+        TEST_ASSERT_TRUE(bins[i].fixed_shift < 30);
+    }
+}
+
+// =============================================================================
+// TEST 2: Spectral bins, loud / quiet / noisy input
+// =============================================================================
+void test_spectral_bins_match_float(void) {
+    fill_history(440.0f, 0.5f, 0.01f, 1);
+    assert_spectral_bins_match(1e-3f);
+
+    fill_history(110.0f, 0.5f, 0.0f, 2);
+    assert_spectral_bins_match(1e-3f);
+
+    fill_history(1975.5f, 0.02f, 0.002f, 3);
+    assert_spectral_bins_match(5e-3f);
+
+    fill_history(0.0f, 0.0f, 0.2f, 4);
+    assert_spectral_bins_match(5e-3f);
+}
+
+// =============================================================================
+// TEST 3: 4-lane fixed kernel == single-bin fixed kernel
+// =============================================================================
+void test_group_kernel_matches_single(void) {
+    fill_history(659.25f, 0.3f, 0.05f, 5);
+
+    for (int g = 0; g < NUM_FREQS; g += GOERTZEL_LANES) {
+        uint16_t length = 0, block_sizes[GOERTZEL_LANES];
+        float steps[GOERTZEL_LANES];
+        int32_t coeff[GOERTZEL_LANES];
+        uint8_t shift[GOERTZEL_LANES];
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            const test_bin& bin = bins[g + lane];
+            if (bin.block_size > length) length = bin.block_size;
+            block_sizes[lane] = bin.block_size;
+            steps[lane] = bin.window_step;
+            coeff[lane] = bin.coeff_q30;
+            shift[lane] = bin.fixed_shift;
+        }
+
+        static int16_t table[SAMPLE_HISTORY_LENGTH * GOERTZEL_LANES];
+        goertzel_build_group_window(table, length, block_sizes, steps, window_q15);
+
+        int32_t q1[GOERTZEL_LANES], q2[GOERTZEL_LANES];
+        goertzel_run_group_fixed(&history_q15[(SAMPLE_HISTORY_LENGTH - 1) - length], table, length, coeff, shift, q1, q2);
+
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            const test_bin& bin = bins[g + lane];
+            int32_t q1_single, q2_single;
+            goertzel_run_fixed(&history_q15[(SAMPLE_HISTORY_LENGTH - 1) - bin.block_size], bin.block_size,
+                               window_q15, bin.window_step, bin.coeff_q30, bin.fixed_shift, &q1_single, &q2_single);
+            TEST_ASSERT_EQUAL_INT(q1_single, q1[lane]);
+            TEST_ASSERT_EQUAL_INT(q2_single, q2[lane]);
+        }
+    }
+}
+
+// =============================================================================
+// TEST 4: Tempo bins over a novelty pulse train
+// =============================================================================
+void test_tempo_bins_match_float(void) {
+    static float novelty_float[NOVELTY_HISTORY_LENGTH];
+    static int16_t novelty_q15[NOVELTY_HISTORY_LENGTH];
+
+    // 120 BPM onsets with decay, normalised to 0.0-1.0 like novelty_curve_normalized
+    for (int i = 0; i < NOVELTY_HISTORY_LENGTH; i++) {
+        float phase = fmodf(i * (2.0f / NOVELTY_LOG_HZ), 1.0f);
+        novelty_float[i] = expf(-phase * 8.0f) * 0.9f + 0.05f;
+        novelty_q15[i] = goertzel_float_to_q15(novelty_float[i]);
+    }
+
+    float reference[NUM_TEMPI];
+    float peak = 0.0f;
+    for (int i = 0; i < NUM_TEMPI; i++) {
+        reference[i] = magnitude_float(tempo_bins[i], &novelty_float[(NOVELTY_HISTORY_LENGTH - 1) - tempo_bins[i].block_size]);
+        peak = fmaxf(peak, reference[i]);
+    }
+    for (int i = 0; i < NUM_TEMPI; i++) {
+        float fixed = magnitude_fixed(tempo_bins[i], &novelty_q15[(NOVELTY_HISTORY_LENGTH - 1) - tempo_bins[i].block_size]);
+        TEST_ASSERT_FLOAT_WITHIN(peak * 1e-3f, reference[i], fixed);
+    }
+}
+
+// =============================================================================
+// TEST 5: Worst case - full-scale square wave on the lowest bin
+// =============================================================================
+void test_full_scale_does_not_wrap(void) {
+    const test_bin& bin = bins[0];
+    float k = acosf(bin.coeff * 0.5f) * bin.block_size / (2.0f * (float)M_PI);
+
+    for (int i = 0; i < SAMPLE_HISTORY_LENGTH; i++) {
+        history_float[i] = sinf(2.0f * (float)M_PI * k * i / bin.block_size) >= 0.0f ? 1.0f : -1.0f;
+        history_q15[i] = goertzel_float_to_q15(history_float[i]);
+    }
+
+    const float* samples_float = &history_float[(SAMPLE_HISTORY_LENGTH - 1) - bin.block_size];
+    const int16_t* samples_q15 = &history_q15[(SAMPLE_HISTORY_LENGTH - 1) - bin.block_size];
+    float reference = magnitude_float(bin, samples_float);
+    TEST_ASSERT_FLOAT_WITHIN(reference * 1e-3f, reference, magnitude_fixed(bin, samples_q15));
+}
+
+int main(int argc, char** argv) {
+    init_bins();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_shift_bounds);
+    RUN_TEST(test_spectral_bins_match_float);
+    RUN_TEST(test_group_kernel_matches_single);
+    RUN_TEST(test_tempo_bins_match_float);
+    RUN_TEST(test_full_scale_does_not_wrap);
+
+    return UNITY_END();
+}
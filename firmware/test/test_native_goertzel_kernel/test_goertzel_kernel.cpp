@@ -0,0 +1,232 @@
+/**
+ * TEST SUITE: Multi-bin Goertzel Kernel (native)
+ *
+ * Validates that goertzel_run_group() with baked Q15 window tables produces the
+ * same per-bin magnitudes as the single-bin calculate_magnitude_of_bin() loop
+ * (window_lookup walked by a float window_pos), and reports the cost of a full
+ * 64-bin frame with both approaches on the host.
+ *
+ * Run with: pio test -e native -f test_native_goertzel_kernel
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include "../../src/audio/goertzel_kernel.h"
+
+#define SAMPLE_RATE 16000
+#define NUM_FREQS 64
+#define HISTORY_LENGTH 4096
+#define BENCH_FRAMES 200
+
+typedef struct {
+    uint16_t block_size;
+    float window_step;
+    float coeff;
+} test_bin;
+
+static test_bin bins[NUM_FREQS];
+static float window_lookup[4096];
+static float history[HISTORY_LENGTH];
+
+static goertzel_bin_group groups[NUM_FREQS / GOERTZEL_LANES];
+static int16_t* window_storage = NULL;
+
+// Same bin layout as init_goertzel_constants_musical(): half-step bins from 55 Hz,
+// bandwidth = 4x the quarter-step neighbour distance, block divisible by 4
+static void init_bins() {
+    for (int i = 0; i < NUM_FREQS; i++) {
+        float target = 55.0f * powf(2.0f, i / 12.0f);
+        float neighbor_distance = target * (powf(2.0f, 1.0f / 24.0f) - 1.0f);
+
+        uint16_t block_size = (uint16_t)(SAMPLE_RATE / (neighbor_distance * 4.0f));
+        block_size -= block_size % 4;
+        if (block_size > HISTORY_LENGTH - 1) {
+            block_size = HISTORY_LENGTH - 1;
+        }
+
+        float k = (int)(0.5f + (block_size * target) / SAMPLE_RATE);
+        float w = (2.0f * (float)M_PI * k) / block_size;
+
+        bins[i].block_size = block_size;
+        bins[i].window_step = 4096.0f / block_size;
+        bins[i].coeff = 2.0f * cosf(w);
+    }
+
+    // Gaussian window, sigma 0.8 (init_window_lookup)
+    for (int i = 0; i < 2048; i++) {
+        float n_minus_halfN = i - 2048 / 2;
+        float weight = expf(-0.5f * powf(n_minus_halfN / (0.8f * 2048 / 2), 2));
+        window_lookup[i] = weight;
+        window_lookup[4095 - i] = weight;
+    }
+}
+
+static void init_groups() {
+    uint32_t total = 0;
+    for (int g = 0; g < NUM_FREQS / GOERTZEL_LANES; g++) {
+        uint16_t length = 0;
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            if (bins[g * GOERTZEL_LANES + lane].block_size > length) {
+                length = bins[g * GOERTZEL_LANES + lane].block_size;
+            }
+        }
+        groups[g].first_bin = g * GOERTZEL_LANES;
+        groups[g].length = length;
+        total += (uint32_t)length * GOERTZEL_LANES;
+    }
+
+    window_storage = (int16_t*)malloc(total * sizeof(int16_t));
+    int16_t* table = window_storage;
+    for (int g = 0; g < NUM_FREQS / GOERTZEL_LANES; g++) {
+        uint16_t block_sizes[GOERTZEL_LANES];
+        float steps[GOERTZEL_LANES];
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            block_sizes[lane] = bins[groups[g].first_bin + lane].block_size;
+            steps[lane] = bins[groups[g].first_bin + lane].window_step;
+        }
+        goertzel_build_group_window(table, groups[g].length, block_sizes, steps, window_lookup);
+        groups[g].window = table;
+        table += (uint32_t)groups[g].length * GOERTZEL_LANES;
+    }
+}
+
+// Previous implementation (goertzel.cpp calculate_magnitude_of_bin, minus bin scale)
+static float magnitude_reference(int bin) {
+    float q1 = 0, q2 = 0, window_pos = 0.0f;
+    const uint16_t block_size = bins[bin].block_size;
+    const float coeff = bins[bin].coeff;
+    const float* sample_ptr = &history[(HISTORY_LENGTH - 1) - block_size];
+
+    for (uint16_t i = 0; i < block_size; i++) {
+        float q0 = coeff * q1 - q2 + sample_ptr[i] * window_lookup[uint32_t(window_pos)];
+        q2 = q1;
+        q1 = q0;
+        window_pos += bins[bin].window_step;
+    }
+
+    return ((q1 * q1) + (q2 * q2) - q1 * q2 * coeff) / (block_size / 2.0f);
+}
+
+static void magnitudes_grouped(float* out) {
+    for (int g = 0; g < NUM_FREQS / GOERTZEL_LANES; g++) {
+        float coeff[GOERTZEL_LANES], q1[GOERTZEL_LANES], q2[GOERTZEL_LANES];
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            coeff[lane] = bins[groups[g].first_bin + lane].coeff;
+        }
+
+        goertzel_run_group(&history[(HISTORY_LENGTH - 1) - groups[g].length], groups[g].window, groups[g].length, coeff, q1, q2);
+
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            int bin = groups[g].first_bin + lane;
+            out[bin] = ((q1[lane] * q1[lane]) + (q2[lane] * q2[lane]) - q1[lane] * q2[lane] * coeff[lane]) / (bins[bin].block_size / 2.0f);
+        }
+    }
+}
+
+static void fill_history(uint32_t seed, float tone_hz) {
+    for (int i = 0; i < HISTORY_LENGTH; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = (float)(seed >> 8) / 16777216.0f - 0.5f;
+        history[i] = 0.5f * sinf(2.0f * (float)M_PI * tone_hz * i / SAMPLE_RATE) + 0.1f * noise;
+    }
+}
+
+void setUp(void) {
+    if (window_storage == NULL) {
+        init_bins();
+        init_groups();
+    }
+}
+
+void tearDown(void) {}
+
+// =============================================================================
+// TEST 1: Zero-padded lanes reproduce each bin's own block exactly
+// =============================================================================
+void test_window_table_matches_lookup_walk(void) {
+    for (int g = 0; g < NUM_FREQS / GOERTZEL_LANES; g++) {
+        for (int lane = 0; lane < GOERTZEL_LANES; lane++) {
+            const test_bin& bin = bins[groups[g].first_bin + lane];
+            uint16_t pad = groups[g].length - bin.block_size;
+            float window_pos = 0.0f;
+
+            for (uint16_t i = 0; i < pad; i++) {
+                TEST_ASSERT_EQUAL_INT16(0, groups[g].window[i * GOERTZEL_LANES + lane]);
+            }
+            for (uint16_t i = 0; i < bin.block_size; i++) {
+                float expected = window_lookup[uint32_t(window_pos)];
+                float actual = groups[g].window[(pad + i) * GOERTZEL_LANES + lane] / GOERTZEL_WINDOW_Q15_SCALE;
+                TEST_ASSERT_FLOAT_WITHIN(1.0f / 32767.0f, expected, actual);
+                window_pos += bin.window_step;
+            }
+        }
+    }
+}
+
+// =============================================================================
+// TEST 2: Grouped magnitudes match the single-bin reference
+// =============================================================================
+void test_magnitudes_match_reference(void) {
+    const float tones[] = { 110.0f, 440.0f, 1318.5f, 3520.0f };
+    float grouped[NUM_FREQS];
+
+    for (int t = 0; t < 4; t++) {
+        fill_history(t + 1, tones[t]);
+        magnitudes_grouped(grouped);
+
+        float peak = 0.0f;
+        for (int i = 0; i < NUM_FREQS; i++) {
+            float reference = magnitude_reference(i);
+            if (reference > peak) peak = reference;
+        }
+
+        // Q15 window quantisation: error well below 0.1% of the frame peak
+        for (int i = 0; i < NUM_FREQS; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(peak * 1e-3f, magnitude_reference(i), grouped[i]);
+        }
+    }
+}
+
+// =============================================================================
+// TEST 3: Full 64-bin frame benchmark (before / after)
+// =============================================================================
+void test_benchmark_frame(void) {
+    using clock = std::chrono::steady_clock;
+    float grouped[NUM_FREQS];
+    volatile float sink = 0.0f;
+    fill_history(99, 440.0f);
+
+    auto t0 = clock::now();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        history[0] = (float)f * 1e-6f;  // defeat loop-invariant hoisting
+        for (int i = 0; i < NUM_FREQS; i++) {
+            sink = sink + magnitude_reference(i);
+        }
+    }
+    auto t1 = clock::now();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        history[0] = (float)f * 1e-6f;
+        magnitudes_grouped(grouped);
+        sink = sink + grouped[0];
+    }
+    auto t2 = clock::now();
+
+    double single_us = std::chrono::duration<double, std::micro>(t1 - t0).count() / BENCH_FRAMES;
+    double grouped_us = std::chrono::duration<double, std::micro>(t2 - t1).count() / BENCH_FRAMES;
+
+    printf("[BENCH] 64-bin frame: single-bin %.1f us, %d-lane grouped %.1f us (%.1fx)\n",
+           single_us, GOERTZEL_LANES, grouped_us, single_us / (grouped_us > 0.0 ? grouped_us : 1.0));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_window_table_matches_lookup_walk);
+    RUN_TEST(test_magnitudes_match_reference);
+    RUN_TEST(test_benchmark_frame);
+
+    return UNITY_END();
+}
@@ -0,0 +1,295 @@
+/**
+ * TEST SUITE: I2S Ingest Stage (native)
+ *
+ * Validates the fused conversion / DC-blocking / scaling pass (i2s_ingest.h)
+ * on raw I2S capture data:
+ * - 32-bit slot to 18-bit sample conversion and clamping
+ * - microphone bias removed without a boot transient, whatever the bias
+ * - musical band passes untouched (110 Hz bottom bin and up)
+ * - every target (mirrored ring, Q15 ring, debug capture) receives the same chunk
+ * - cost per chunk against the previous three-pass path (reported)
+ *
+ * Input: raw little-endian 32-bit I2S slots (as read from the SPH0645 DMA)
+ * from the file named by K1_I2S_PCM, or a synthesized capture written to a
+ * temporary file and read back.
+ *
+ * Run with: pio test -e native -f test_native_i2s_ingest
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "../../src/audio/mirrored_ring.h"
+#include "../../src/audio/i2s_ingest.h"
+
+#define SAMPLE_RATE 16000
+#define CHUNK_SIZE 128
+#define SAMPLE_HISTORY_LENGTH 4096
+
+static std::vector<int32_t> capture;
+
+static bool load_pcm(const char* path, std::vector<int32_t>& out) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+    int32_t slot;
+    out.clear();
+    while (fread(&slot, sizeof(slot), 1, f) == 1) {
+        out.push_back(slot);
+    }
+    fclose(f);
+    return out.size() >= CHUNK_SIZE;
+}
+
+// 18-bit microphone samples with a bias, packed into I2S slots
+static void synthesize_capture(std::vector<int32_t>& out, int32_t bias, float frequency, float amplitude, uint32_t count) {
+    out.resize(count);
+    for (uint32_t n = 0; n < count; n++) {
+        float noise = ((rand() / (float)RAND_MAX) - 0.5f) * 200.0f;
+        float tone = amplitude * I2S_SAMPLE_LIMIT * sinf(2.0f * M_PI * frequency * n / SAMPLE_RATE);
+        int32_t sample = bias + (int32_t)(tone + noise);
+        out[n] = (int32_t)((uint32_t)sample << I2S_SAMPLE_SHIFT);
+    }
+}
+
+// Run a capture through the stage, one chunk at a time
+static void ingest_all(const std::vector<int32_t>& in, std::vector<float>& out) {
+    dc_blocker dc = {};
+    out.resize(in.size() / CHUNK_SIZE * CHUNK_SIZE);
+    for (size_t c = 0; c + CHUNK_SIZE <= in.size(); c += CHUNK_SIZE) {
+        i2s_ingest_targets targets = {};
+        targets.samples = &out[c];
+        i2s_ingest_chunk(&in[c], CHUNK_SIZE, dc, targets);
+    }
+}
+
+static double rms(const float* x, size_t count) {
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) sum += (double)x[i] * x[i];
+    return sqrt(sum / count);
+}
+
+void setUp(void) {
+    srand(7);
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Slot conversion and clamping
+// =============================================================================
+void test_slot_conversion(void) {
+    TEST_ASSERT_EQUAL_INT32(0, i2s_slot_to_sample(0));
+    TEST_ASSERT_EQUAL_INT32(1000, i2s_slot_to_sample(1000 << I2S_SAMPLE_SHIFT));
+    TEST_ASSERT_EQUAL_INT32(-1000, i2s_slot_to_sample((int32_t)((uint32_t)-1000 << I2S_SAMPLE_SHIFT)));
+    TEST_ASSERT_EQUAL_INT32(I2S_SAMPLE_LIMIT - 1, i2s_slot_to_sample(INT32_MAX));
+    TEST_ASSERT_EQUAL_INT32(-I2S_SAMPLE_LIMIT, i2s_slot_to_sample(INT32_MIN));
+}
+
+// =============================================================================
+// TEST 2: Bias removed on the capture file, with no boot transient
+// =============================================================================
+void test_bias_removed_from_capture(void) {
+    const char* path = getenv("K1_I2S_PCM");
+    if (path == NULL || !load_pcm(path, capture)) {
+        // Bias of the unit the old "+7000 ... -360" offset was tuned for
+        synthesize_capture(capture, -6640, 440.0f, 0.2f, SAMPLE_RATE * 3);
+        const char* tmp_path = "/tmp/k1_i2s_ingest.pcm";
+        FILE* f = fopen(tmp_path, "wb");
+        TEST_ASSERT_NOT_NULL(f);
+        fwrite(capture.data(), sizeof(int32_t), capture.size(), f);
+        fclose(f);
+        TEST_ASSERT_TRUE(load_pcm(tmp_path, capture));
+        printf("[INPUT] synthesized capture via %s (%zu slots)\n", tmp_path, capture.size());
+    } else {
+        printf("[INPUT] %s (%zu slots)\n", path, capture.size());
+    }
+
+    std::vector<float> out;
+    ingest_all(capture, out);
+
+    // Raw bias for reference
+    double raw_mean = 0.0;
+    for (int32_t slot : capture) raw_mean += i2s_slot_to_sample(slot);
+    raw_mean /= capture.size() * (double)I2S_SAMPLE_LIMIT;
+
+    double mean = 0.0;
+    const size_t settled = SAMPLE_RATE / 2;
+    for (size_t i = settled; i < out.size(); i++) mean += out[i];
+    mean /= (out.size() - settled);
+
+    // Boot: the first 50 ms must not swing further than the settled signal does
+    float settled_peak = 0.0f, boot_peak = 0.0f;
+    for (size_t i = settled; i < out.size(); i++) settled_peak = fmaxf(settled_peak, fabsf(out[i]));
+    for (size_t i = 0; i < SAMPLE_RATE / 20; i++) boot_peak = fmaxf(boot_peak, fabsf(out[i]));
+
+    printf("[DC] input bias %.4f -> output mean %.6f, boot peak %.3f vs settled peak %.3f\n", raw_mean, mean, boot_peak, settled_peak);
+    TEST_ASSERT_TRUE(fabs(mean) < 1e-3);
+    TEST_ASSERT_TRUE(boot_peak < settled_peak * 1.1f);
+}
+
+// =============================================================================
+// TEST 3: Different microphone biases all end up centred
+// =============================================================================
+void test_any_bias_is_tracked(void) {
+    const int32_t biases[] = { -20000, -6640, 0, 3000, 15000 };
+    for (int32_t bias : biases) {
+        std::vector<int32_t> in;
+        std::vector<float> out;
+        synthesize_capture(in, bias, 220.0f, 0.1f, SAMPLE_RATE);
+        ingest_all(in, out);
+
+        double mean = 0.0;
+        for (size_t i = SAMPLE_RATE / 2; i < out.size(); i++) mean += out[i];
+        mean /= out.size() - SAMPLE_RATE / 2;
+        TEST_ASSERT_TRUE(fabs(mean) < 1e-3);
+    }
+}
+
+// =============================================================================
+// TEST 4: Musical band passes (bottom bin 110 Hz)
+// =============================================================================
+void test_passband(void) {
+    const float frequencies[] = { 110.0f, 440.0f, 4000.0f };
+    for (float frequency : frequencies) {
+        std::vector<int32_t> in;
+        std::vector<float> out;
+        synthesize_capture(in, -6640, frequency, 0.25f, SAMPLE_RATE * 2);
+        ingest_all(in, out);
+
+        double gain = rms(&out[SAMPLE_RATE], SAMPLE_RATE) / (0.25 / sqrt(2.0));
+        printf("[HPF] %6.0f Hz: %.3f dB\n", frequency, 20.0 * log10(gain));
+        TEST_ASSERT_TRUE(fabs(20.0 * log10(gain)) < 0.1);
+    }
+}
+
+// =============================================================================
+// TEST 5: Every target receives the same chunk
+// =============================================================================
+void test_targets_agree(void) {
+    static float ring_storage[SAMPLE_HISTORY_LENGTH * 2];
+    static int16_t ring_q15_storage[SAMPLE_HISTORY_LENGTH * 2];
+    mirrored_ring ring = { ring_storage, SAMPLE_HISTORY_LENGTH, 0 };
+    mirrored_ring_q15 ring_q15 = { ring_q15_storage, SAMPLE_HISTORY_LENGTH, 0 };
+    int16_t recording[CHUNK_SIZE * 30];
+
+    std::vector<int32_t> in;
+    synthesize_capture(in, 1234, 330.0f, 0.5f, CHUNK_SIZE * 30);
+
+    dc_blocker dc_a = {}, dc_b = {};
+    for (int c = 0; c < 30; c++) {
+        float* slot = mirrored_ring_slot(ring);
+        i2s_ingest_targets a = {};
+        a.samples = slot;
+        a.samples_mirror = slot + SAMPLE_HISTORY_LENGTH;
+        a.recording = &recording[c * CHUNK_SIZE];
+        i2s_ingest_chunk(&in[c * CHUNK_SIZE], CHUNK_SIZE, dc_a, a);
+        mirrored_ring_advance(ring, CHUNK_SIZE);
+
+        float scratch[CHUNK_SIZE];
+        i2s_ingest_targets b = {};
+        b.samples = scratch;
+        b.q15 = mirrored_ring_slot(ring_q15);
+        b.q15_mirror = b.q15 + SAMPLE_HISTORY_LENGTH;
+        i2s_ingest_chunk(&in[c * CHUNK_SIZE], CHUNK_SIZE, dc_b, b);
+        mirrored_ring_advance(ring_q15, CHUNK_SIZE);
+    }
+
+    const float* window = mirrored_ring_window(ring);
+    const int16_t* window_q15 = mirrored_ring_window(ring_q15);
+    for (int i = 0; i < CHUNK_SIZE * 30; i++) {
+        const float sample = window[SAMPLE_HISTORY_LENGTH - CHUNK_SIZE * 30 + i];
+        TEST_ASSERT_EQUAL_INT16(goertzel_float_to_q15(sample), window_q15[SAMPLE_HISTORY_LENGTH - CHUNK_SIZE * 30 + i]);
+        TEST_ASSERT_EQUAL_INT16(goertzel_float_to_q15(sample), recording[i]);
+    }
+}
+
+// =============================================================================
+// TEST 6: Cost per chunk, previous three-pass path vs fused
+// =============================================================================
+void test_benchmark(void) {
+    static float ring_storage[SAMPLE_HISTORY_LENGTH * 2];
+    mirrored_ring ring = { ring_storage, SAMPLE_HISTORY_LENGTH, 0 };
+    std::vector<int32_t> in;
+    synthesize_capture(in, -6640, 440.0f, 0.2f, CHUNK_SIZE * 64);
+    const uint32_t chunks = 50000;
+    volatile float sink = 0.0f;
+
+    // Previous: convert with fixed offset, scale pass, copy into ring
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t c = 0; c < chunks; c++) {
+        const int32_t* raw = &in[(c & 63) * CHUNK_SIZE];
+        float new_samples[CHUNK_SIZE];
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+            int32_t v = (raw[i] >> 14) + 7000;
+            v = v > 131072 ? 131072 : (v < -131072 ? -131072 : v);
+            new_samples[i] = v - 360;
+        }
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+            new_samples[i] *= 1.0f / 131072.0f;
+        }
+        mirrored_ring_write(ring, new_samples, CHUNK_SIZE);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    sink = sink + ring_storage[5];
+
+    // Same work unfused: previous passes plus a separate per-sample DC pass
+    float x_prev = 0.0f, y_prev = 0.0f;
+    for (uint32_t c = 0; c < chunks; c++) {
+        const int32_t* raw = &in[(c & 63) * CHUNK_SIZE];
+        float new_samples[CHUNK_SIZE];
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+            new_samples[i] = (float)i2s_slot_to_sample(raw[i]);
+        }
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+            const float y = new_samples[i] - x_prev + I2S_DC_BLOCK_POLE * y_prev;
+            x_prev = new_samples[i];
+            y_prev = y;
+            new_samples[i] = y;
+        }
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+            new_samples[i] *= 1.0f / 131072.0f;
+        }
+        mirrored_ring_write(ring, new_samples, CHUNK_SIZE);
+    }
+    auto t_unfused = std::chrono::steady_clock::now();
+    sink = sink + ring_storage[5];
+
+    // Fused
+    dc_blocker dc = {};
+    for (uint32_t c = 0; c < chunks; c++) {
+        float* slot = mirrored_ring_slot(ring);
+        i2s_ingest_targets targets = {};
+        targets.samples = slot;
+        targets.samples_mirror = slot + SAMPLE_HISTORY_LENGTH;
+        i2s_ingest_chunk(&in[(c & 63) * CHUNK_SIZE], CHUNK_SIZE, dc, targets);
+        mirrored_ring_advance(ring, CHUNK_SIZE);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    sink = sink + ring_storage[5];
+
+    double previous_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / chunks;
+    double unfused_ns = std::chrono::duration<double, std::nano>(t_unfused - t1).count() / chunks;
+    double fused_ns = std::chrono::duration<double, std::nano>(t2 - t_unfused).count() / chunks;
+    printf("[BENCH] per chunk: previous %.0f ns (fixed offset), DC-blocked unfused %.0f ns, fused %.0f ns\n",
+           previous_ns, unfused_ns, fused_ns);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_slot_conversion);
+    RUN_TEST(test_bias_removed_from_capture);
+    RUN_TEST(test_any_bias_is_tracked);
+    RUN_TEST(test_passband);
+    RUN_TEST(test_targets_agree);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}
@@ -0,0 +1,117 @@
+/**
+ * TEST SUITE: Latency Histogram (native)
+ *
+ * Validates the mic-to-photon stage histograms (latency_histogram.h):
+ * - buckets cover 0 us to ~1 s without gaps, exact below 8 us, under 1/8
+ *   relative width above, and saturate beyond the range
+ * - p50/p95/p99 of a skewed latency distribution match exact percentiles
+ *   to within the bucket width
+ * - a reader's clear request takes effect at the writer's next sample
+ *
+ * Run with: pio test -e native -f test_native_latency_histogram
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include "../../src/audio/latency_histogram.h"
+
+static latency_histogram histogram;
+
+void setUp(void) {
+    srand(17);
+    latency_histogram_clear(histogram);
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Bucket layout
+// =============================================================================
+void test_bucket_layout(void) {
+    for (uint32_t us = 0; us < 8; us++) {
+        TEST_ASSERT_EQUAL_UINT32(us, latency_bucket_upper_us(latency_bucket(us)));
+    }
+
+    uint16_t last_bucket = 0;
+    float worst_width = 0.0f;
+    for (uint32_t us = 1; us < (1u << LATENCY_MAX_EXPONENT); us++) {
+        const uint16_t bucket = latency_bucket(us);
+        TEST_ASSERT_TRUE(bucket == last_bucket || bucket == last_bucket + 1);   // No gaps
+        TEST_ASSERT_TRUE(us <= latency_bucket_upper_us(bucket));
+        if (bucket > 0) {
+            TEST_ASSERT_TRUE(us > latency_bucket_upper_us(bucket - 1));
+        }
+        const float width = (float)(latency_bucket_upper_us(bucket) - us) / us;
+        worst_width = fmaxf(worst_width, width);
+        last_bucket = bucket;
+    }
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_BUCKETS - 1, last_bucket);
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_BUCKETS - 1, latency_bucket(5000000));
+    printf("[LATENCY] %d buckets to %u us, worst overstatement %.1f%%\n",
+           LATENCY_BUCKETS, latency_bucket_upper_us(LATENCY_BUCKETS - 1), worst_width * 100.0f);
+    TEST_ASSERT_TRUE(worst_width <= 0.125f);
+}
+
+// =============================================================================
+// TEST 2: Percentiles against exact values
+// =============================================================================
+void test_percentiles(void) {
+    // Mostly ~12 ms mic-to-LED with a long tail (missed render frames, RMT waits)
+    std::vector<uint32_t> samples;
+    for (int i = 0; i < 20000; i++) {
+        float us = 9000.0f + 6000.0f * (rand() / (float)RAND_MAX);
+        if (rand() % 20 == 0) {
+            us += 8333.0f * (1 + rand() % 3);
+        }
+        if (rand() % 500 == 0) {
+            us += 30000.0f;
+        }
+        samples.push_back((uint32_t)us);
+        latency_histogram_add(histogram, (uint32_t)us);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    const float fractions[] = {0.50f, 0.95f, 0.99f};
+    for (float fraction : fractions) {
+        const uint32_t exact = samples[(size_t)ceilf(fraction * samples.size()) - 1];
+        const uint32_t reported = latency_histogram_percentile(histogram, fraction);
+        printf("[LATENCY] p%.0f exact %u us, reported %u us\n", fraction * 100.0f, exact, reported);
+        TEST_ASSERT_TRUE(reported >= exact);
+        TEST_ASSERT_TRUE(reported <= exact + exact / 8 + 1);
+    }
+    TEST_ASSERT_EQUAL_UINT32(samples.back(), histogram.max_us);
+    TEST_ASSERT_EQUAL_UINT32(samples.back(), latency_histogram_percentile(histogram, 1.0f));
+}
+
+// =============================================================================
+// TEST 3: Clear requested by the reader
+// =============================================================================
+void test_clear_request(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, latency_histogram_percentile(histogram, 0.5f));
+
+    for (int i = 0; i < 100; i++) {
+        latency_histogram_add(histogram, 20000);
+    }
+    latency_histogram_request_clear(histogram);
+    TEST_ASSERT_EQUAL_UINT32(100, histogram.total);   // Not cleared under the writer
+
+    latency_histogram_add(histogram, 3000);
+    TEST_ASSERT_EQUAL_UINT32(1, histogram.total);
+    TEST_ASSERT_EQUAL_UINT32(3000, histogram.max_us);
+    TEST_ASSERT_EQUAL_UINT32(3000, latency_histogram_percentile(histogram, 0.99f));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bucket_layout);
+    RUN_TEST(test_percentiles);
+    RUN_TEST(test_clear_request);
+
+    return UNITY_END();
+}
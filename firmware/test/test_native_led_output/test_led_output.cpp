@@ -0,0 +1,323 @@
+/**
+ * TEST SUITE: LED Output Stage (native)
+ *
+ * Validates the fused output stage (led_output.h) that turns the CRGBF frame
+ * into GRB bytes:
+ * - the gamma curve, and brightness / warmth folded into the index scale,
+ *   match the float formula they replace
+ * - rounding, ordered dither, GRB order and clamping of out-of-range values
+ * - sigma-delta dither: time-averaged error against the float target on dim
+ *   (twilight) levels, spatial decorrelation, every level below one step kept
+ *   (time average exact, pulses evenly spaced; pulse rate per level reported)
+ * - per-frame cost against the previous float quantizer (reported)
+ *
+ * Run with: pio test -e native -f test_native_led_output
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "../../src/led_output.h"
+
+#define NUM_LEDS 180
+
+static led_output_stage stage;
+static float frame[NUM_LEDS * 3];
+static uint8_t grb[NUM_LEDS * 3];
+
+// Drive the stage approximates, in 8-bit steps
+static float reference_drive(float value, float brightness, float warmth, uint8_t channel) {
+    const float gain = 1.0f - warmth * (1.0f - LED_INCANDESCENT_GAIN[channel]);
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return 255.0f * powf(value * brightness, stage.gamma) * gain;
+}
+
+// The float quantizer this stage replaced, temporal dithering on (the default)
+static void legacy_quantize(const float* rgb, float brightness, uint8_t* out) {
+    const float dither_table[4] = {0.25, 0.50, 0.75, 1.00};
+    static uint8_t dither_step = 0;
+    dither_step++;
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        for (uint8_t c = 0; c < 3; c++) {
+            const float decimal = rgb[3 * i + c] * brightness * 254;
+            const uint8_t whole = decimal;
+            const float fract = decimal - whole;
+            out[3 * i + (c == 0 ? 1 : (c == 1 ? 0 : 2))] = whole + (fract >= dither_table[dither_step % 4]);
+        }
+    }
+}
+
+void setUp(void) {
+    srand(22);
+    led_output_init(stage, LED_OUTPUT_GAMMA);
+    for (uint16_t i = 0; i < NUM_LEDS * 3; i++) {
+        frame[i] = rand() / (float)RAND_MAX;
+    }
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Curve, brightness and warmth against the float formula
+// =============================================================================
+void test_curve_and_levels(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, stage.curve[0]);
+    TEST_ASSERT_EQUAL_UINT32(LED_DRIVE_MAX, stage.curve[LED_CURVE_SIZE - 1]);
+    uint32_t below_q8_8 = 0;                      // Entries a Q8.8 curve would hold as 0
+    for (uint32_t i = 1; i < LED_CURVE_SIZE; i++) {
+        TEST_ASSERT_TRUE(stage.curve[i] >= stage.curve[i - 1]);
+        below_q8_8 += stage.curve[i] > 0 && stage.curve[i] < LED_DRIVE_ONE / 512;
+    }
+    printf("[LED] curve: %u nonzero entries under 1/512 step (lost at Q8.8)\n", (unsigned)below_q8_8);
+    TEST_ASSERT_TRUE(below_q8_8 > 0);
+
+    static const float brightness_levels[] = {1.0f, 0.6f, 0.2f};
+    static const float warmth_levels[] = {0.0f, 0.5f, 1.0f};
+    float worst = 0.0f;
+    for (float brightness : brightness_levels) {
+        for (float warmth : warmth_levels) {
+            led_output_set_levels(stage, brightness, warmth);
+            for (uint8_t c = 0; c < 3; c++) {
+                for (int step = 0; step <= 1000; step++) {
+                    const float value = step / 1000.0f;
+                    const float drive = led_output_drive(stage, value, c) / (float)LED_DRIVE_ONE;
+                    const float error = fabsf(drive - reference_drive(value, brightness, warmth, c));
+                    if (error > worst) {
+                        worst = error;
+                    }
+                }
+            }
+        }
+    }
+    printf("[LED] curve (gamma %.1f, %d entries): worst drive error %.3f steps over brightness x warmth\n",
+           stage.gamma, LED_CURVE_SIZE, worst);
+    TEST_ASSERT_TRUE(worst < 0.25f);
+
+    // Gamma 1.0 reproduces the old linear mapping
+    led_output_init(stage, 1.0f);
+    for (int level = 0; level <= 255; level++) {
+        TEST_ASSERT_FLOAT_WITHIN(0.07f, (float)level, led_output_drive(stage, level / 255.0f, 0) / (float)LED_DRIVE_ONE);
+    }
+}
+
+// =============================================================================
+// TEST 2: Rounding, ordered dither, byte order, clamping
+// =============================================================================
+void test_quantize(void) {
+    // Red, green, blue, over-range and negative LEDs
+    float rgb[5 * 3] = {
+        1.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 1.0f,
+        7.5f, 1.2f, 1.0f,
+        -0.5f, -3.0f, 0.0f,
+    };
+    uint8_t out[5 * 3];
+    led_output_quantize(stage, rgb, 5, LED_DITHER_OFF, out);
+    const uint8_t expected[5 * 3] = {0, 255, 0, 255, 0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, out, 5 * 3);
+
+    // Full white keeps to 255 under every dither threshold
+    for (int f = 0; f < 4; f++) {
+        led_output_quantize(stage, rgb, 5, LED_DITHER_ORDERED, out);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, out, 5 * 3);
+    }
+
+    // Rounding and the 4-frame dither average both land on the Q8.8 drive
+    float worst_round = 0.0f;
+    float worst_dither = 0.0f;
+    for (int step = 0; step < 400; step++) {
+        float level[3] = {step / 400.0f, step / 400.0f, step / 400.0f};
+        const float drive = led_output_drive(stage, level[0], 0) / (float)LED_DRIVE_ONE;
+        uint8_t byte[3];
+        led_output_quantize(stage, level, 1, LED_DITHER_OFF, byte);
+        worst_round = fmaxf(worst_round, fabsf(byte[1] - drive));
+
+        float sum = 0.0f;
+        for (int f = 0; f < 4; f++) {
+            led_output_quantize(stage, level, 1, LED_DITHER_ORDERED, byte);
+            sum += byte[1];
+        }
+        worst_dither = fmaxf(worst_dither, fabsf(sum / 4.0f - drive));
+    }
+    printf("[LED] quantize: worst rounding error %.3f steps, worst 4-frame dither average error %.3f steps\n",
+           worst_round, worst_dither);
+    TEST_ASSERT_TRUE(worst_round <= 0.5f);
+    TEST_ASSERT_TRUE(worst_dither <= 0.25f);
+}
+
+// =============================================================================
+// TEST 3: Sigma-delta dither on dim levels
+// =============================================================================
+void test_sigma_delta(void) {
+    const int frames = 160;                      // One second at 160 FPS
+    const float brightness = 0.35f;
+    led_output_set_levels(stage, brightness, 0.0f);
+
+    // A twilight ramp: perceptual levels giving 0.2 - 8 steps of drive
+    float ramp[NUM_LEDS * 3];
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        const float level = 0.10f + 0.45f * i / (NUM_LEDS - 1);
+        ramp[3 * i + 0] = level;
+        ramp[3 * i + 1] = 0.6f * level;
+        ramp[3 * i + 2] = 0.3f * level;
+    }
+
+    static const char* names[] = {"rounding", "ordered", "sigma-delta"};
+    float worst[3] = {0.0f, 0.0f, 0.0f};
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    uint16_t counted = 0;
+    for (uint8_t mode = LED_DITHER_OFF; mode <= LED_DITHER_SIGMA_DELTA; mode++) {
+        static float sum[NUM_LEDS * 3];
+        memset(sum, 0, sizeof(sum));
+        for (int f = 0; f < frames; f++) {
+            led_output_quantize(stage, ramp, NUM_LEDS, (led_dither_mode)mode, grb);
+            for (uint16_t i = 0; i < NUM_LEDS; i++) {
+                sum[3 * i + 0] += grb[3 * i + 1];
+                sum[3 * i + 1] += grb[3 * i + 0];
+                sum[3 * i + 2] += grb[3 * i + 2];
+            }
+        }
+        counted = 0;
+        for (uint16_t k = 0; k < NUM_LEDS * 3; k++) {
+            const float target = reference_drive(ramp[k], brightness, 0.0f, k % 3);
+            if (target < LED_DITHER_FLOOR / (float)LED_DRIVE_ONE) {
+                continue;                        // Sent as off when a floor is built in
+            }
+            const float error = fabsf(sum[k] / frames - target);
+            worst[mode] = fmaxf(worst[mode], error);
+            mean[mode] += error;
+            counted++;
+        }
+        mean[mode] /= counted;
+        printf("[LED] twilight ramp, %u channels over %d frames: %-11s mean error %.3f, worst %.3f steps\n",
+               counted, frames, names[mode], mean[mode], worst[mode]);
+    }
+    TEST_ASSERT_TRUE(worst[LED_DITHER_SIGMA_DELTA] < 0.1f);
+    TEST_ASSERT_TRUE(mean[LED_DITHER_SIGMA_DELTA] < mean[LED_DITHER_ORDERED]);
+    TEST_ASSERT_TRUE(mean[LED_DITHER_ORDERED] < mean[LED_DITHER_OFF]);
+
+    // A uniform dim field (0.3 of a step): ordered dither lights every LED on the same
+    // frame; sigma-delta spreads the steps so about 30% are lit on any frame
+    led_output_init(stage, 1.0f);
+    for (uint16_t k = 0; k < NUM_LEDS * 3; k++) {
+        frame[k] = 0.3f / 255.0f;
+    }
+    uint16_t most_lit = 0;
+    uint16_t fewest_lit = NUM_LEDS;
+    for (int f = 0; f < 20; f++) {
+        led_output_quantize(stage, frame, NUM_LEDS, LED_DITHER_SIGMA_DELTA, grb);
+        uint16_t lit = 0;
+        for (uint16_t i = 0; i < NUM_LEDS; i++) {
+            lit += grb[3 * i + 1] > 0;
+        }
+        most_lit = lit > most_lit ? lit : most_lit;
+        fewest_lit = lit < fewest_lit ? lit : fewest_lit;
+    }
+    printf("[LED] uniform field at 0.3 step: %u-%u of %d LEDs lit per frame (ordered: 0 or %d)\n",
+           fewest_lit, most_lit, NUM_LEDS, NUM_LEDS);
+    TEST_ASSERT_TRUE(most_lit <= NUM_LEDS * 0.3f + 4);
+    TEST_ASSERT_TRUE(fewest_lit >= NUM_LEDS * 0.3f - 4);
+
+    // Below one step: the pulses average to the drive over any run of frames and are evenly
+    // spaced (dark runs differ by at most one frame); under a built-in floor nothing is lit
+    const uint32_t run = 4096;
+    for (uint32_t drive = 97; drive < LED_DRIVE_ONE; drive += 331) {
+        uint16_t residual = 0;
+        uint32_t lit = 0, gap = 0, shortest_gap = run, longest_gap = 0;
+        bool seen_pulse = false;
+        for (uint32_t f = 0; f < run; f++) {
+            if (led_sigma_delta(drive, residual) > 0) {
+                if (seen_pulse) {
+                    shortest_gap = gap < shortest_gap ? gap : shortest_gap;
+                    longest_gap = gap > longest_gap ? gap : longest_gap;
+                }
+                seen_pulse = true;
+                gap = 0;
+                lit++;
+            } else {
+                gap++;
+            }
+        }
+        if (drive < LED_DITHER_FLOOR) {
+            TEST_ASSERT_EQUAL_UINT32(0, lit);
+            continue;
+        }
+        TEST_ASSERT_UINT32_WITHIN(1, (uint32_t)(((uint64_t)drive * run) >> LED_DRIVE_SHIFT), lit);
+        if (lit > 1) {
+            TEST_ASSERT_TRUE(longest_gap - shortest_gap <= 1);
+        }
+    }
+
+    // What a sub-step level looks like on the strip: pulses per second at 150 FPS
+    printf("[LED] sigma-delta pulse rate at 150 FPS:");
+    for (uint32_t divisor = 2; divisor <= 64; divisor *= 2) {
+        uint16_t residual = 0;
+        uint32_t lit = 0;
+        for (uint32_t f = 0; f < 150 * 64; f++) {
+            lit += led_sigma_delta(LED_DRIVE_ONE / divisor, residual) > 0;
+        }
+        printf(" 1/%u step %.1f Hz%s", (unsigned)divisor, lit / 64.0f, divisor < 64 ? "," : "\n");
+    }
+
+    // Full drive never wraps past 255 whatever the residual
+    led_output_init(stage, LED_OUTPUT_GAMMA);
+    for (uint16_t k = 0; k < NUM_LEDS * 3; k++) {
+        frame[k] = 1.0f;
+    }
+    for (int f = 0; f < 8; f++) {
+        led_output_quantize(stage, frame, NUM_LEDS, LED_DITHER_SIGMA_DELTA, grb);
+        for (uint16_t k = 0; k < NUM_LEDS * 3; k++) {
+            TEST_ASSERT_EQUAL_UINT8(255, grb[k]);
+        }
+    }
+}
+
+// =============================================================================
+// TEST 4: Cost per frame against the float quantizer
+// =============================================================================
+void test_quantize_cost(void) {
+    const int runs = 20000;
+    volatile uint32_t sink = 0;
+    led_output_set_levels(stage, 0.8f, 0.3f);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++) {
+        legacy_quantize(frame, 0.8f, grb);
+        sink += grb[r % (NUM_LEDS * 3)];
+    }
+    const double legacy_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++) {
+        led_output_quantize(stage, frame, NUM_LEDS, LED_DITHER_ORDERED, grb);
+        sink += grb[r % (NUM_LEDS * 3)];
+    }
+    const double fused_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++) {
+        led_output_quantize(stage, frame, NUM_LEDS, LED_DITHER_SIGMA_DELTA, grb);
+        sink += grb[r % (NUM_LEDS * 3)];
+    }
+    const double sigma_delta_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    printf("[LED] %d LEDs per frame: float quantizer %.0f ns (linear), output stage %.0f ns (gamma, warmth), both dithered\n",
+           NUM_LEDS, legacy_ns, fused_ns);
+    printf("[LED] %d LEDs per frame: sigma-delta output stage %.0f ns\n", NUM_LEDS, sigma_delta_ns);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_curve_and_levels);
+    RUN_TEST(test_quantize);
+    RUN_TEST(test_sigma_delta);
+    RUN_TEST(test_quantize_cost);
+
+    return UNITY_END();
+}
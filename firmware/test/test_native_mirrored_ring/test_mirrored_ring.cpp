@@ -0,0 +1,119 @@
+/**
+ * TEST SUITE: Mirrored Ring Sample History (native)
+ *
+ * Validates that the mirrored ring used for sample_history exposes exactly the
+ * same oldest → newest window as the previous shift_and_copy_arrays() memmove,
+ * and reports the per-chunk ingestion cost of both approaches on the host.
+ *
+ * Run with: pio test -e native -f test_native_mirrored_ring
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include "../../src/audio/mirrored_ring.h"
+
+#define HISTORY_LENGTH 4096
+#define CHUNK_SIZE 128
+#define BENCH_CHUNKS 20000
+
+static float ring_storage[HISTORY_LENGTH * 2];
+static mirrored_ring ring = { ring_storage, HISTORY_LENGTH, 0 };
+static float reference_history[HISTORY_LENGTH];
+
+// Previous implementation (goertzel.h shift_and_copy_arrays)
+static void shift_and_copy_reference(float* dest, int dest_len, const float* src, int src_len) {
+    memmove(dest, dest + src_len, (dest_len - src_len) * sizeof(float));
+    memcpy(dest + (dest_len - src_len), src, src_len * sizeof(float));
+}
+
+static void fill_chunk(float* chunk, uint32_t seed) {
+    for (int i = 0; i < CHUNK_SIZE; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        chunk[i] = (float)(seed >> 8) / 16777216.0f - 0.5f;
+    }
+}
+
+void setUp(void) {
+    mirrored_ring_clear(ring);
+    memset(reference_history, 0, sizeof(reference_history));
+}
+
+void tearDown(void) {}
+
+// =============================================================================
+// TEST 1: Window matches memmove reference across many wraps
+// =============================================================================
+void test_window_matches_reference(void) {
+    float chunk[CHUNK_SIZE];
+
+    // 100 chunks = 3+ full wraps of the 4096-sample history
+    for (uint32_t c = 0; c < 100; c++) {
+        fill_chunk(chunk, c + 1);
+        shift_and_copy_reference(reference_history, HISTORY_LENGTH, chunk, CHUNK_SIZE);
+        mirrored_ring_write(ring, chunk, CHUNK_SIZE);
+
+        const float* window = mirrored_ring_window(ring);
+        TEST_ASSERT_EQUAL_MEMORY(reference_history, window, sizeof(reference_history));
+    }
+}
+
+// =============================================================================
+// TEST 2: Non-chunk-aligned writes and single-sample pushes
+// =============================================================================
+void test_unaligned_writes_and_push(void) {
+    float chunk[CHUNK_SIZE];
+
+    for (uint32_t c = 0; c < 200; c++) {
+        uint16_t count = 1 + (c * 37) % CHUNK_SIZE;
+        fill_chunk(chunk, c + 7);
+        shift_and_copy_reference(reference_history, HISTORY_LENGTH, chunk, count);
+        mirrored_ring_write(ring, chunk, count);
+
+        shift_and_copy_reference(reference_history, HISTORY_LENGTH, &chunk[0], 1);
+        mirrored_ring_push(ring, chunk[0]);
+    }
+
+    TEST_ASSERT_EQUAL_MEMORY(reference_history, mirrored_ring_window(ring), sizeof(reference_history));
+}
+
+// =============================================================================
+// TEST 3: Per-chunk ingestion benchmark (before / after)
+// =============================================================================
+void test_benchmark_chunk_ingestion(void) {
+    using clock = std::chrono::steady_clock;
+    float chunk[CHUNK_SIZE];
+    fill_chunk(chunk, 42);
+
+    auto t0 = clock::now();
+    for (int c = 0; c < BENCH_CHUNKS; c++) {
+        chunk[0] = (float)c;  // defeat loop-invariant hoisting
+        shift_and_copy_reference(reference_history, HISTORY_LENGTH, chunk, CHUNK_SIZE);
+    }
+    auto t1 = clock::now();
+    for (int c = 0; c < BENCH_CHUNKS; c++) {
+        chunk[0] = (float)c;
+        mirrored_ring_write(ring, chunk, CHUNK_SIZE);
+    }
+    auto t2 = clock::now();
+
+    double memmove_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / BENCH_CHUNKS;
+    double ring_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / BENCH_CHUNKS;
+
+    // Both paths must leave the same history behind
+    TEST_ASSERT_EQUAL_MEMORY(reference_history, mirrored_ring_window(ring), sizeof(reference_history));
+
+    printf("[BENCH] per-chunk ingestion: memmove %.1f ns, mirrored ring %.1f ns (%.1fx)\n",
+           memmove_ns, ring_ns, memmove_ns / (ring_ns > 0.0 ? ring_ns : 1.0));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_window_matches_reference);
+    RUN_TEST(test_unaligned_writes_and_push);
+    RUN_TEST(test_benchmark_chunk_ingestion);
+
+    return UNITY_END();
+}
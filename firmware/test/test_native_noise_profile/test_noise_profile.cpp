@@ -0,0 +1,149 @@
+/**
+ * TEST SUITE: Persisted Noise Profile (native)
+ *
+ * Validates the boot-time noise profile logic (noise_profile.h):
+ * - profiles only match the setup they were taken with (not the gain,
+ *   which is applied after the subtraction)
+ * - the setup hash reacts to any change in the bin layout
+ * - a 32-frame probe of an unchanged room stays under the drift limit,
+ *   while a louder or quieter room, or a different spectral shape, trips it
+ * - why the probe compares mean levels: a 32-frame floor (running max) is
+ *   biased low against the stored 512-frame one
+ *
+ * Bin energies are chi-square distributed, which is what |Goertzel|^2 of
+ * background noise looks like.
+ *
+ * Run with: pio test -e native -f test_native_noise_profile
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../../src/audio/noise_profile.h"
+
+#define NUM_FREQS 64
+#define NOISE_CALIBRATION_FRAMES 512
+#define NOISE_PROBE_FRAMES 32
+#define NOISE_PROBE_DRIFT_LIMIT 0.35f
+
+static float room_level[NUM_FREQS];
+
+// One frame of background-noise bin energy (exponential, mean = level)
+static float noise_energy(float level) {
+    float u = (rand() + 1.0f) / ((float)RAND_MAX + 2.0f);
+    return -logf(u) * level;
+}
+
+// Mirrors collect_and_filter_noise() during calibration / probe:
+// floor = 0.75 x running max, level = mean
+static void learn_room(float* floor, float* level, uint32_t frames, float gain, float tilt) {
+    memset(floor, 0, sizeof(float) * NUM_FREQS);
+    memset(level, 0, sizeof(float) * NUM_FREQS);
+    for (uint32_t f = 0; f < frames; f++) {
+        for (int i = 0; i < NUM_FREQS; i++) {
+            float mean = room_level[i] * gain * (1.0f + tilt * (i - NUM_FREQS / 2) / (NUM_FREQS / 2));
+            float input = noise_energy(mean);
+            if (input > floor[i]) {
+                floor[i] = input * 0.75f;
+            }
+            level[i] += input;
+        }
+    }
+    for (int i = 0; i < NUM_FREQS; i++) {
+        level[i] /= frames;
+    }
+}
+
+void setUp(void) {
+    srand(42);
+    for (int i = 0; i < NUM_FREQS; i++) {
+        room_level[i] = 0.001f * (1.0f + 0.5f * sinf(i * 0.3f));
+    }
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Format and setup hash gate a stored profile
+// =============================================================================
+void test_profile_matching(void) {
+    noise_profile profile;
+    profile.format = NOISE_PROFILE_FORMAT;
+    profile.config_hash = 0x12345678;
+
+    TEST_ASSERT_TRUE(noise_profile_matches(profile, 0x12345678));
+    TEST_ASSERT_FALSE(noise_profile_matches(profile, 0x12345679));
+
+    profile.format = NOISE_PROFILE_FORMAT - 1;     // Format 1 blobs also carried a gain
+    TEST_ASSERT_FALSE(noise_profile_matches(profile, 0x12345678));
+}
+
+// =============================================================================
+// TEST 2: Setup hash changes with the bin layout
+// =============================================================================
+void test_hash_tracks_layout(void) {
+    uint16_t block_sizes[NUM_FREQS];
+    for (int i = 0; i < NUM_FREQS; i++) {
+        block_sizes[i] = 1240 - i * 18;
+    }
+
+    uint32_t base = noise_profile_hash_bytes(NOISE_PROFILE_HASH_SEED, block_sizes, sizeof(block_sizes));
+    TEST_ASSERT_EQUAL_UINT32(base, noise_profile_hash_bytes(NOISE_PROFILE_HASH_SEED, block_sizes, sizeof(block_sizes)));
+
+    for (int i = 0; i < NUM_FREQS; i += 7) {
+        block_sizes[i] += 4;
+        TEST_ASSERT_TRUE(base != noise_profile_hash_bytes(NOISE_PROFILE_HASH_SEED, block_sizes, sizeof(block_sizes)));
+        block_sizes[i] -= 4;
+    }
+}
+
+// =============================================================================
+// TEST 3: Probe accepts the same room and rejects a changed one
+// =============================================================================
+void test_probe_drift(void) {
+    float stored_floor[NUM_FREQS], stored_level[NUM_FREQS];
+    float probed_floor[NUM_FREQS], probed_level[NUM_FREQS];
+    learn_room(stored_floor, stored_level, NOISE_CALIBRATION_FRAMES, 1.0f, 0.0f);
+
+    // Same room, many boots
+    float worst_same = 0.0f, worst_same_floor = 0.0f;
+    for (int boot = 0; boot < 50; boot++) {
+        learn_room(probed_floor, probed_level, NOISE_PROBE_FRAMES, 1.0f, 0.0f);
+        worst_same = fmaxf(worst_same, noise_profile_drift(stored_level, probed_level, NUM_FREQS));
+        worst_same_floor = fmaxf(worst_same_floor, noise_profile_drift(stored_floor, probed_floor, NUM_FREQS));
+    }
+
+    // Changed rooms
+    learn_room(probed_floor, probed_level, NOISE_PROBE_FRAMES, 2.0f, 0.0f);
+    float louder = noise_profile_drift(stored_level, probed_level, NUM_FREQS);
+    learn_room(probed_floor, probed_level, NOISE_PROBE_FRAMES, 0.5f, 0.0f);
+    float quieter = noise_profile_drift(stored_level, probed_level, NUM_FREQS);
+    learn_room(probed_floor, probed_level, NOISE_PROBE_FRAMES, 1.0f, 1.0f);
+    float tilted = noise_profile_drift(stored_level, probed_level, NUM_FREQS);
+
+    printf("[NOISE] level drift: same room worst %.2f, +3 dB %.2f, -3 dB %.2f, tilted %.2f (limit %.2f)\n",
+           worst_same, louder, quieter, tilted, NOISE_PROBE_DRIFT_LIMIT);
+    printf("[NOISE] floor drift, same room worst %.2f (running max is biased by frame count)\n", worst_same_floor);
+    TEST_ASSERT_TRUE(worst_same < NOISE_PROBE_DRIFT_LIMIT);
+    TEST_ASSERT_TRUE(louder > NOISE_PROBE_DRIFT_LIMIT);
+    TEST_ASSERT_TRUE(quieter > NOISE_PROBE_DRIFT_LIMIT);
+    TEST_ASSERT_TRUE(tilted > NOISE_PROBE_DRIFT_LIMIT);
+    TEST_ASSERT_TRUE(worst_same_floor > worst_same);
+
+    // Nothing stored but noise present: always drift
+    float empty[NUM_FREQS] = {0};
+    TEST_ASSERT_TRUE(noise_profile_drift(empty, probed_level, NUM_FREQS) > NOISE_PROBE_DRIFT_LIMIT);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_profile_matching);
+    RUN_TEST(test_hash_tracks_layout);
+    RUN_TEST(test_probe_drift);
+
+    return UNITY_END();
+}
@@ -0,0 +1,227 @@
+/**
+ * TEST SUITE: Novelty History Ring (native)
+ *
+ * Validates the circular novelty history and its running max
+ * (sliding_max.h) against the shifting history it replaces
+ * (update_novelty_curve() / normalize_novelty_curve()):
+ * - the deque max equals a full rescan for rising, falling, tied and
+ *   random inputs, including across the wrap
+ * - auto_scale, every normalized sample and every tempo bin come out
+ *   bit-identical to the memmove + rescan + normalized-copy path
+ * - per-frame bookkeeping cost, old vs new (reported)
+ *
+ * Run with: pio test -e native -f test_native_novelty_history
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "../../src/audio/sliding_max.h"
+#include "../../src/audio/tempo_bank.h"
+
+#define NOVELTY_HISTORY_LENGTH 2048
+#define NOVELTY_LOG_HZ 125                  // One novelty sample per 8 ms audio frame
+#define TEMPO_BINS_FIRST 9
+#define TEMPO_BINS_LAST 44
+
+// Old path: shifted histories and a materialized normalized copy
+static float old_curve[NOVELTY_HISTORY_LENGTH];
+static float old_vu[NOVELTY_HISTORY_LENGTH];
+static float old_normalized[NOVELTY_HISTORY_LENGTH];
+static float old_max_val, old_max_val_smooth, old_scale;
+static tempo_bank old_bank;
+
+// New path: rings, running max, scale applied on read
+static float ring_curve[NOVELTY_HISTORY_LENGTH];
+static float ring_vu[NOVELTY_HISTORY_LENGTH];
+static uint16_t ring_head;
+static uint16_t max_slots[NOVELTY_HISTORY_LENGTH];
+static sliding_max ring_max;
+static float new_max_val, new_max_val_smooth, new_scale;
+static tempo_bank new_bank;
+
+static void old_frame(float novelty, float level) {
+    tempo_bank_push(old_bank, novelty, old_curve[0]);
+    memmove(old_curve, old_curve + 1, (NOVELTY_HISTORY_LENGTH - 1) * sizeof(float));
+    old_curve[NOVELTY_HISTORY_LENGTH - 1] = novelty;
+    memmove(old_vu, old_vu + 1, (NOVELTY_HISTORY_LENGTH - 1) * sizeof(float));
+    old_vu[NOVELTY_HISTORY_LENGTH - 1] = level;
+
+    old_max_val *= 0.99;
+    for (uint16_t i = 0; i < NOVELTY_HISTORY_LENGTH; i++) {
+        old_max_val = fmax(old_max_val, old_curve[i]);
+    }
+    old_max_val_smooth = fmax(0.1f, old_max_val_smooth * 0.99f + old_max_val * 0.01f);
+    old_scale = 1.0 / old_max_val_smooth;
+    for (uint16_t i = 0; i < NOVELTY_HISTORY_LENGTH; i++) {
+        old_normalized[i] = old_curve[i] * old_scale;
+    }
+}
+
+// Mirrors update_novelty_curve() + normalize_novelty_curve()
+static void new_frame(float novelty, float level) {
+    const uint16_t slot = ring_head;
+    tempo_bank_push(new_bank, novelty, ring_curve[slot]);
+    ring_curve[slot] = novelty;
+    ring_vu[slot] = level;
+    sliding_max_push(ring_max, ring_curve, slot);
+    ring_head = (slot + 1) & (NOVELTY_HISTORY_LENGTH - 1);
+
+    new_max_val *= 0.99;
+    new_max_val = fmax(new_max_val, sliding_max_value(ring_max, ring_curve));
+    new_max_val_smooth = fmax(0.1f, new_max_val_smooth * 0.99f + new_max_val * 0.01f);
+    new_scale = 1.0 / new_max_val_smooth;
+}
+
+static float ring_at(const float* ring, uint16_t index) {
+    return ring[(ring_head + index) & (NOVELTY_HISTORY_LENGTH - 1)];
+}
+
+static float rescan_max(void) {
+    float max_val = 0.0f;
+    for (uint16_t i = 0; i < NOVELTY_HISTORY_LENGTH; i++) {
+        max_val = fmaxf(max_val, ring_curve[i]);
+    }
+    return max_val;
+}
+
+static float novelty_sample(uint32_t frame) {
+    float value = 0.05f * (rand() / (float)RAND_MAX);
+    if (frame % 25 == 0) {
+        value += 0.5f + (rand() / (float)RAND_MAX) * (1.0f + (frame / 3000) % 3);
+    }
+    return value;
+}
+
+void setUp(void) {
+    srand(11);
+    memset(old_curve, 0, sizeof(old_curve));
+    memset(old_vu, 0, sizeof(old_vu));
+    memset(ring_curve, 0, sizeof(ring_curve));
+    memset(ring_vu, 0, sizeof(ring_vu));
+    ring_head = 0;
+    ring_max = { max_slots, NOVELTY_HISTORY_LENGTH, 0, 0 };
+    old_max_val = new_max_val = 0.00001f;
+    old_max_val_smooth = new_max_val_smooth = 0.1f;
+
+    float window[NOVELTY_HISTORY_LENGTH];
+    for (uint16_t m = 0; m < NOVELTY_HISTORY_LENGTH; m++) {
+        float x = (m - NOVELTY_HISTORY_LENGTH / 2.0f) / (0.8f * NOVELTY_HISTORY_LENGTH / 2.0f);
+        window[m] = expf(-0.5f * x * x);
+    }
+    tempo_bank_init(old_bank, NOVELTY_HISTORY_LENGTH, TEMPO_BINS_FIRST, TEMPO_BINS_LAST, window, TEMPO_BANK_DAMPING);
+    tempo_bank_init(new_bank, NOVELTY_HISTORY_LENGTH, TEMPO_BINS_FIRST, TEMPO_BINS_LAST, window, TEMPO_BANK_DAMPING);
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Running max equals a full rescan
+// =============================================================================
+static uint32_t check_against_rescan(float (*sample)(uint32_t), uint32_t frames) {
+    uint32_t mismatches = 0;
+    for (uint32_t n = 0; n < frames; n++) {
+        const uint16_t slot = ring_head;
+        ring_curve[slot] = sample(n);
+        sliding_max_push(ring_max, ring_curve, slot);
+        ring_head = (slot + 1) & (NOVELTY_HISTORY_LENGTH - 1);
+        mismatches += sliding_max_value(ring_max, ring_curve) != rescan_max();
+    }
+    return mismatches;
+}
+
+static float rising(uint32_t n) { return (float)n; }
+static float falling(uint32_t n) { return 10000.0f - (float)n; }
+static float tied(uint32_t n) { return (float)((n / 700) % 3); }
+static float random_sample(uint32_t) { return rand() / (float)RAND_MAX; }
+
+void test_max_matches_rescan(void) {
+    float (*inputs[])(uint32_t) = { rising, falling, tied, random_sample };
+    const char* names[] = { "rising", "falling", "tied", "random" };
+    for (int i = 0; i < 4; i++) {
+        setUp();
+        uint32_t mismatches = check_against_rescan(inputs[i], 3 * NOVELTY_HISTORY_LENGTH + 17);
+        printf("[NOVELTY] %s: %lu mismatches, deque depth %u\n", names[i], (unsigned long)mismatches, ring_max.count);
+        TEST_ASSERT_EQUAL_UINT32(0, mismatches);
+        TEST_ASSERT_TRUE(ring_max.count <= NOVELTY_HISTORY_LENGTH);
+    }
+}
+
+// =============================================================================
+// TEST 2: Tempo outputs are bit-identical to the shifting path
+// =============================================================================
+void test_bit_identical(void) {
+    const uint32_t frames = 20000;
+    uint32_t scale_mismatches = 0, sample_mismatches = 0, bin_mismatches = 0;
+
+    for (uint32_t n = 0; n < frames; n++) {
+        const float novelty = novelty_sample(n);
+        const float level = 0.3f * (rand() / (float)RAND_MAX);
+        old_frame(novelty, level);
+        new_frame(novelty, level);
+
+        scale_mismatches += memcmp(&old_scale, &new_scale, sizeof(float)) != 0;
+
+        if (n % 97 == 0) {
+            for (uint16_t i = 0; i < NOVELTY_HISTORY_LENGTH; i++) {
+                const float normalized = ring_at(ring_curve, i) * new_scale;
+                const float vu = ring_at(ring_vu, i);
+                sample_mismatches += memcmp(&old_normalized[i], &normalized, sizeof(float)) != 0;
+                sample_mismatches += memcmp(&old_vu[i], &vu, sizeof(float)) != 0;
+            }
+            for (uint16_t k = TEMPO_BINS_FIRST; k <= TEMPO_BINS_LAST; k++) {
+                float old_re, old_im, new_re, new_im;
+                tempo_bank_read(old_bank, k, old_scale, &old_re, &old_im);
+                tempo_bank_read(new_bank, k, new_scale, &new_re, &new_im);
+                bin_mismatches += memcmp(&old_re, &new_re, sizeof(float)) != 0 || memcmp(&old_im, &new_im, sizeof(float)) != 0;
+            }
+        }
+    }
+
+    printf("[NOVELTY] %lu frames: %lu scale, %lu sample, %lu tempo bin mismatches\n", (unsigned long)frames,
+           (unsigned long)scale_mismatches, (unsigned long)sample_mismatches, (unsigned long)bin_mismatches);
+    TEST_ASSERT_EQUAL_UINT32(0, scale_mismatches);
+    TEST_ASSERT_EQUAL_UINT32(0, sample_mismatches);
+    TEST_ASSERT_EQUAL_UINT32(0, bin_mismatches);
+}
+
+// =============================================================================
+// TEST 3: Per-frame bookkeeping cost
+// =============================================================================
+void test_benchmark(void) {
+    const uint32_t frames = 20000;
+    float inputs[256];
+    for (int i = 0; i < 256; i++) {
+        inputs[i] = novelty_sample(i);
+    }
+
+    // Both paths include the same tempo bank push
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < frames; n++) {
+        old_frame(inputs[n & 255], 0.1f);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < frames; n++) {
+        new_frame(inputs[n & 255], 0.1f);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double old_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / frames;
+    double new_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / frames;
+    printf("[BENCH] per novelty frame: shift + rescan + copy %.0f ns, ring + running max %.0f ns (%.0fx)\n",
+           old_ns, new_ns, old_ns / new_ns);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_max_matches_rescan);
+    RUN_TEST(test_bit_identical);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}
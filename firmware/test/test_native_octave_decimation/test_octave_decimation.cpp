@@ -0,0 +1,313 @@
+/**
+ * TEST SUITE: Octave Decimation Front End (native)
+ *
+ * Validates the half-band decimation tree used for the low Goertzel bins:
+ * - half-band stage response (flat passband, folded-back band rejected)
+ * - per-bin spectra from decimated histories match the full-rate Goertzel
+ *   (previous calculate_magnitude_of_bin() behaviour) for tones and noise
+ * - Goertzel multiply-add count per frame, before / after
+ *
+ * Run with: pio test -e native -f test_native_octave_decimation
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "../../src/audio/mirrored_ring.h"
+#include "../../src/audio/octave_decimator.h"
+
+#define SAMPLE_RATE 16000
+#define SAMPLE_HISTORY_LENGTH 4096
+#define NUM_OCTAVE_STAGES 4
+#define OCTAVE_HISTORY_LENGTH 512
+#define NUM_FREQS 64
+#define LANES 4
+#define CHUNK_SIZE 128
+
+typedef struct {
+    float target_freq;
+    uint8_t octave;
+    uint16_t block_size;
+    float window_step;
+    float coeff;
+} test_bin;
+
+static test_bin bins_full[NUM_FREQS];     // Previous layout: everything at 16 kHz
+static test_bin bins_octave[NUM_FREQS];   // Decimated layout
+static float window_lookup[4096];
+
+static float full_storage[SAMPLE_HISTORY_LENGTH * 2];
+static float octave_storage[NUM_OCTAVE_STAGES - 1][OCTAVE_HISTORY_LENGTH * 2];
+static mirrored_ring full_history = { full_storage, SAMPLE_HISTORY_LENGTH, 0 };
+static mirrored_ring octave_history[NUM_OCTAVE_STAGES - 1] = {
+    { octave_storage[0], OCTAVE_HISTORY_LENGTH, 0 },
+    { octave_storage[1], OCTAVE_HISTORY_LENGTH, 0 },
+    { octave_storage[2], OCTAVE_HISTORY_LENGTH, 0 },
+};
+static halfband_decimator octave_filters[NUM_OCTAVE_STAGES - 1];
+
+// Mirrors init_goertzel(): full-rate block divisible by 4 and DFT bin, then
+// the same block duration at the bin's decimation stage
+static void init_bin(test_bin& bin, float bandwidth) {
+    uint16_t full_rate_block_size = SAMPLE_RATE / bandwidth;
+    while (full_rate_block_size % 4 != 0) {
+        full_rate_block_size -= 1;
+    }
+    if (full_rate_block_size > SAMPLE_HISTORY_LENGTH - 1) {
+        full_rate_block_size = SAMPLE_HISTORY_LENGTH - 1;
+    }
+
+    float k = (int)(0.5 + ((full_rate_block_size * bin.target_freq) / SAMPLE_RATE));
+
+    const uint16_t history_length = bin.octave == 0 ? SAMPLE_HISTORY_LENGTH : OCTAVE_HISTORY_LENGTH;
+    bin.block_size = full_rate_block_size >> bin.octave;
+    if (bin.block_size > history_length - 1) {
+        bin.block_size = history_length - 1;
+    }
+    bin.window_step = 4096.0 / bin.block_size;
+
+    float w = (2.0 * M_PI * k * (1 << bin.octave)) / full_rate_block_size;
+    bin.coeff = 2.0 * cos(w);
+}
+
+// Mirrors init_goertzel_constants_musical() (half-step bins from 110 Hz)
+static void init_bins() {
+    float bandwidths[NUM_FREQS];
+    for (int i = 0; i < NUM_FREQS; i++) {
+        float target = 110.0f * powf(2.0f, i / 12.0f);
+        bandwidths[i] = target * (powf(2.0f, 1.0f / 24.0f) - 1.0f) * 4.0f;
+        bins_full[i].target_freq = bins_octave[i].target_freq = target;
+        bins_full[i].octave = 0;
+    }
+
+    for (int g = 0; g < NUM_FREQS; g += LANES) {
+        float top_freq = 0.0f, min_bandwidth = bandwidths[g];
+        for (int lane = 0; lane < LANES; lane++) {
+            top_freq = fmaxf(top_freq, bins_octave[g + lane].target_freq);
+            min_bandwidth = fminf(min_bandwidth, bandwidths[g + lane]);
+        }
+        uint8_t octave = octave_select_stage(top_freq, min_bandwidth, SAMPLE_RATE, NUM_OCTAVE_STAGES, OCTAVE_HISTORY_LENGTH);
+        for (int lane = 0; lane < LANES; lane++) {
+            bins_octave[g + lane].octave = octave;
+        }
+    }
+
+    for (int i = 0; i < NUM_FREQS; i++) {
+        init_bin(bins_full[i], bandwidths[i]);
+        init_bin(bins_octave[i], bandwidths[i]);
+    }
+
+    for (int i = 0; i < 2048; i++) {
+        float n_minus_halfN = i - 2048 / 2;
+        float weight = exp(-0.5 * pow((n_minus_halfN / (0.8 * 2048 / 2)), 2));
+        window_lookup[i] = weight;
+        window_lookup[4095 - i] = weight;
+    }
+}
+
+// Mirrors feed_octave_histories()
+static void feed_chunk(const float* samples) {
+    float stage_in[CHUNK_SIZE], stage_out[CHUNK_SIZE / 2];
+    uint16_t count = CHUNK_SIZE;
+
+    mirrored_ring_write(full_history, samples, CHUNK_SIZE);
+    memcpy(stage_in, samples, sizeof(stage_in));
+    for (int s = 0; s < NUM_OCTAVE_STAGES - 1; s++) {
+        halfband_decimate(octave_filters[s], stage_in, count, stage_out);
+        count /= 2;
+        mirrored_ring_write(octave_history[s], stage_out, count);
+        memcpy(stage_in, stage_out, count * sizeof(float));
+    }
+}
+
+// calculate_magnitude_of_bin() without the perceptual bin scale
+static float magnitude_of_bin(const test_bin& bin) {
+    const float* history = bin.octave == 0 ? mirrored_ring_window(full_history) : mirrored_ring_window(octave_history[bin.octave - 1]);
+    const uint16_t history_length = bin.octave == 0 ? SAMPLE_HISTORY_LENGTH : OCTAVE_HISTORY_LENGTH;
+    const float* sample_ptr = &history[(history_length - 1) - bin.block_size];
+
+    float q1 = 0, q2 = 0, window_pos = 0.0f;
+    for (uint16_t i = 0; i < bin.block_size; i++) {
+        float q0 = bin.coeff * q1 - q2 + sample_ptr[i] * window_lookup[uint32_t(window_pos)];
+        q2 = q1;
+        q1 = q0;
+        window_pos += bin.window_step;
+    }
+
+    float magnitude_squared = (q1 * q1) + (q2 * q2) - q1 * q2 * bin.coeff;
+    return magnitude_squared / (bin.block_size / 2.0) * (1 << bin.octave);
+}
+
+static void run_signal(float tone_hz, float tone_amp, float noise_amp, uint32_t seed) {
+    float chunk[CHUNK_SIZE];
+    uint32_t n = 0;
+
+    // 48 chunks: fills the 4096-sample history plus filter settling
+    for (int c = 0; c < 48; c++) {
+        for (int i = 0; i < CHUNK_SIZE; i++, n++) {
+            seed = seed * 1664525u + 1013904223u;
+            float noise = (float)(seed >> 8) / 16777216.0f - 0.5f;
+            chunk[i] = tone_amp * sinf(2.0f * (float)M_PI * tone_hz * n / SAMPLE_RATE) + noise_amp * noise;
+        }
+        feed_chunk(chunk);
+    }
+}
+
+static float stage_gain(float tone_fraction_of_input_rate) {
+    halfband_decimator stage = {};
+    float in[CHUNK_SIZE], out[CHUNK_SIZE / 2];
+    double power = 0.0;
+    uint32_t n = 0;
+
+    for (int c = 0; c < 64; c++) {
+        for (int i = 0; i < CHUNK_SIZE; i++, n++) {
+            in[i] = sinf(2.0f * (float)M_PI * tone_fraction_of_input_rate * n);
+        }
+        halfband_decimate(stage, in, CHUNK_SIZE, out);
+        if (c >= 8) {
+            for (int j = 0; j < CHUNK_SIZE / 2; j++) power += out[j] * out[j];
+        }
+    }
+    return sqrt(power / (56 * CHUNK_SIZE / 2) * 2.0);
+}
+
+void setUp(void) {
+    memset(full_storage, 0, sizeof(full_storage));
+    memset(octave_storage, 0, sizeof(octave_storage));
+    full_history.head = 0;
+    for (int s = 0; s < NUM_OCTAVE_STAGES - 1; s++) {
+        octave_history[s].head = 0;
+        memset(&octave_filters[s], 0, sizeof(halfband_decimator));
+    }
+}
+
+void tearDown(void) {}
+
+// =============================================================================
+// TEST 1: Half-band stage passband / stopband
+// =============================================================================
+void test_halfband_response(void) {
+    // Passband: up to 0.4 x output rate = 0.2 x input rate
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 1.0f, stage_gain(0.05f));
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 1.0f, stage_gain(0.2f));
+
+    // Band that folds back onto the passband: >= 0.3 x input rate, ~59 dB down
+    TEST_ASSERT_LESS_THAN(0.0015f, stage_gain(0.3f));
+    TEST_ASSERT_LESS_THAN(0.0015f, stage_gain(0.42f));
+}
+
+// =============================================================================
+// TEST 2: Bass bins actually move to decimated stages
+// =============================================================================
+void test_bins_assigned_to_octaves(void) {
+    TEST_ASSERT_EQUAL_INT(NUM_OCTAVE_STAGES - 1, bins_octave[0].octave);
+
+    for (int i = 0; i < NUM_FREQS; i++) {
+        float stage_rate = SAMPLE_RATE >> bins_octave[i].octave;
+        TEST_ASSERT_TRUE(bins_octave[i].target_freq <= OCTAVE_PASSBAND * stage_rate);
+        if (i > 0) {
+            TEST_ASSERT_TRUE(bins_octave[i].octave <= bins_octave[i - 1].octave);
+        }
+    }
+}
+
+static void compute_spectra(float* reference, float* decimated) {
+    for (int i = 0; i < NUM_FREQS; i++) {
+        reference[i] = magnitude_of_bin(bins_full[i]);
+        decimated[i] = magnitude_of_bin(bins_octave[i]);
+    }
+}
+
+// =============================================================================
+// TEST 3: Tone spectra match the full-rate implementation
+// =============================================================================
+void test_tone_spectra_match_full_rate(void) {
+    // On-bin tones across every stage plus an off-bin tone, over light noise
+    const float tones[] = { 110.0f, 233.08f, 440.0f, 987.77f, 1760.0f, 3520.0f, 150.0f };
+
+    for (unsigned t = 0; t < sizeof(tones) / sizeof(tones[0]); t++) {
+        setUp();
+        run_signal(tones[t], 0.5f, 0.01f, t + 1);
+
+        float reference[NUM_FREQS], decimated[NUM_FREQS];
+        compute_spectra(reference, decimated);
+
+        int peak_ref = 0, peak_dec = 0;
+        for (int i = 0; i < NUM_FREQS; i++) {
+            if (reference[i] > reference[peak_ref]) peak_ref = i;
+            if (decimated[i] > decimated[peak_dec]) peak_dec = i;
+        }
+        TEST_ASSERT_EQUAL_INT(peak_ref, peak_dec);
+
+        // Block truncation (>> octave) shifts each bin's response very slightly
+        for (int i = 0; i < NUM_FREQS; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(reference[peak_ref] * 0.05f, reference[i], decimated[i]);
+        }
+    }
+}
+
+// =============================================================================
+// TEST 4: Noise floor level and alias rejection
+// =============================================================================
+void test_noise_and_alias_rejection(void) {
+    float reference[NUM_FREQS], decimated[NUM_FREQS];
+
+    // White noise: the filter delay means the decimated bins see a slightly older
+    // window, so compare the average level per stage over 16 frames rather than bin-for-bin
+    double ref_sum[NUM_OCTAVE_STAGES] = {0}, dec_sum[NUM_OCTAVE_STAGES] = {0};
+    for (int frame = 0; frame < 16; frame++) {
+        run_signal(0.0f, 0.0f, 0.5f, 11 + frame);
+        compute_spectra(reference, decimated);
+        for (int i = 0; i < NUM_FREQS; i++) {
+            ref_sum[bins_octave[i].octave] += reference[i];
+            dec_sum[bins_octave[i].octave] += decimated[i];
+        }
+    }
+    for (int octave = 0; octave < NUM_OCTAVE_STAGES; octave++) {
+        TEST_ASSERT_FLOAT_WITHIN(0.2 * ref_sum[octave], ref_sum[octave], dec_sum[octave]);
+    }
+
+    // 7 kHz tone: far above every decimated stage, must not fold onto the bass bins
+    setUp();
+    run_signal(7000.0f, 0.5f, 0.0f, 12);
+    compute_spectra(reference, decimated);
+    float reference_max = 0.0f, decimated_max = 0.0f;
+    for (int i = 0; i < NUM_FREQS; i++) {
+        reference_max = fmaxf(reference_max, reference[i]);
+        decimated_max = fmaxf(decimated_max, decimated[i]);
+    }
+    TEST_ASSERT_LESS_THAN(2.0f * reference_max + 1e-6f, decimated_max);
+}
+
+// =============================================================================
+// TEST 5: Multiply-add count per frame (before / after)
+// =============================================================================
+void test_multiply_add_count(void) {
+    uint32_t full_macs = 0, octave_macs = 0;
+    for (int i = 0; i < NUM_FREQS; i++) {
+        full_macs += bins_full[i].block_size;
+        octave_macs += bins_octave[i].block_size;
+    }
+
+    // Half-band cost per 128-sample chunk: 64 + 32 + 16 outputs, 11 taps each
+    uint32_t filter_macs = (CHUNK_SIZE / 2 + CHUNK_SIZE / 4 + CHUNK_SIZE / 8) * ((HALFBAND_DELAY + 1) / 2 + 1);
+
+    printf("[BENCH] Goertzel samples/frame: full-rate %u, decimated %u + %u filter (%.1fx)\n",
+           full_macs, octave_macs, filter_macs, (double)full_macs / (octave_macs + filter_macs));
+
+    TEST_ASSERT_TRUE(full_macs > 3 * (octave_macs + filter_macs));
+}
+
+int main(int argc, char** argv) {
+    init_bins();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_halfband_response);
+    RUN_TEST(test_bins_assigned_to_octaves);
+    RUN_TEST(test_tone_spectra_match_full_rate);
+    RUN_TEST(test_noise_and_alias_rejection);
+    RUN_TEST(test_multiply_add_count);
+
+    return UNITY_END();
+}
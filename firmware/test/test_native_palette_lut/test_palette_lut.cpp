@@ -0,0 +1,213 @@
+/**
+ * TEST SUITE: Palette LUT (native)
+ *
+ * Validates the palette lookup tables (palette_lut.h) behind color_from_palette():
+ * - table lookups return the colours of the keyframe interpolation they replace,
+ *   for progress in and out of 0.0-1.0
+ * - the span fill matches per-LED lookups
+ * - the slot cache: hits, lazy fills and eviction on palette change
+ * - per-frame cost against the keyframe path (reported)
+ *
+ * Run with: pio test -e native -f test_native_palette_lut
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "../../src/palette_lut.h"
+
+#define NUM_LEDS 180
+
+// Palette 0 (Sunset Real) and 23 (Lava) from palettes.h
+static const uint8_t sunset_real[] = {
+    0, 120, 0, 0,
+    22, 179, 22, 0,
+    51, 255, 104, 0,
+    85, 167, 22, 18,
+    135, 100, 0, 103,
+    198, 16, 0, 130,
+    255, 0, 0, 160,
+};
+static const uint8_t lava[] = {
+    0, 0, 0, 0,
+    46, 18, 0, 0,
+    96, 113, 0, 0,
+    108, 142, 3, 1,
+    119, 175, 17, 1,
+    146, 213, 44, 2,
+    174, 255, 82, 4,
+    188, 255, 115, 4,
+    202, 255, 156, 4,
+    218, 255, 203, 4,
+    234, 255, 255, 4,
+    244, 255, 255, 71,
+    255, 255, 255, 255,
+};
+
+static palette_lut_cache cache;
+static CRGBF span[NUM_LEDS];
+
+// The keyframe path color_from_palette() used before the tables (flash reads as plain loads)
+static CRGBF reference_color(const uint8_t* data, uint8_t num_entries, float progress, float brightness) {
+    progress = fmodf(progress, 1.0f);
+    if (progress < 0.0f) progress += 1.0f;
+    uint8_t pos = (uint8_t)(progress * 255.0f);
+
+    uint8_t entry1_idx = 0, entry2_idx = 0;
+    uint8_t pos1 = 0, pos2 = 255;
+    for (uint8_t i = 0; i < num_entries - 1; i++) {
+        uint8_t p1 = data[i * 4 + 0];
+        uint8_t p2 = data[(i + 1) * 4 + 0];
+        if (pos >= p1 && pos <= p2) {
+            entry1_idx = i;
+            entry2_idx = i + 1;
+            pos1 = p1;
+            pos2 = p2;
+            break;
+        }
+    }
+
+    float blend = 0.0f;
+    if (pos2 > pos1) {
+        blend = (float)(pos - pos1) / (float)(pos2 - pos1);
+    }
+    float r = (data[entry1_idx * 4 + 1] * (1.0f - blend) + data[entry2_idx * 4 + 1] * blend) / 255.0f;
+    float g = (data[entry1_idx * 4 + 2] * (1.0f - blend) + data[entry2_idx * 4 + 2] * blend) / 255.0f;
+    float b = (data[entry1_idx * 4 + 3] * (1.0f - blend) + data[entry2_idx * 4 + 3] * blend) / 255.0f;
+    return CRGBF(r * brightness, g * brightness, b * brightness);
+}
+
+void setUp(void) {
+    palette_lut_cache_init(cache);
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Table lookups match the keyframe path
+// =============================================================================
+void test_lut_matches_keyframes(void) {
+    CRGBF lut[PALETTE_LUT_SIZE];
+    const uint8_t* palettes[] = {sunset_real, lava};
+    const uint8_t counts[] = {7, 13};
+    float worst = 0.0f;
+    uint32_t samples = 0;
+    for (uint8_t p = 0; p < 2; p++) {
+        palette_lut_build(lut, palettes[p], counts[p]);
+        for (int step = -2000; step <= 6000; step++) {
+            const float progress = step / 1999.0f;           // -1.0 to 3.0, off the byte grid
+            const float brightness = (step & 7) / 7.0f;
+            const CRGBF expected = reference_color(palettes[p], counts[p], progress, brightness);
+            const CRGBF actual = palette_lut_color(lut, progress, brightness);
+            worst = fmaxf(worst, fabsf(actual.r - expected.r));
+            worst = fmaxf(worst, fabsf(actual.g - expected.g));
+            worst = fmaxf(worst, fabsf(actual.b - expected.b));
+            samples++;
+        }
+        // Keyframe colours land exactly on their positions
+        TEST_ASSERT_EQUAL_FLOAT(palettes[p][1] / 255.0f, lut[0].r);
+        TEST_ASSERT_EQUAL_FLOAT(palettes[p][(counts[p] - 1) * 4 + 3] / 255.0f, lut[255].b);
+    }
+    printf("[PALETTE] %u lookups (progress -1.0 to 3.0): worst difference from keyframe path %.2e\n",
+           samples, worst);
+    TEST_ASSERT_TRUE(worst < 1e-6f);
+}
+
+// =============================================================================
+// TEST 2: Span fill matches per-LED lookups
+// =============================================================================
+void test_span_fill(void) {
+    CRGBF lut[PALETTE_LUT_SIZE];
+    palette_lut_build(lut, lava, 13);
+    const float phase = 0.73f;
+    const float step = 1.0f / NUM_LEDS;
+    palette_lut_fill(lut, span, NUM_LEDS, phase, step, 0.4f);
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        const CRGBF expected = palette_lut_color(lut, phase + i * step, 0.4f);
+        TEST_ASSERT_EQUAL_FLOAT(expected.r, span[i].r);
+        TEST_ASSERT_EQUAL_FLOAT(expected.g, span[i].g);
+        TEST_ASSERT_EQUAL_FLOAT(expected.b, span[i].b);
+    }
+}
+
+// =============================================================================
+// TEST 3: Slot cache
+// =============================================================================
+void test_slot_cache(void) {
+    TEST_ASSERT_TRUE(palette_lut_find(cache, 0) == nullptr);   // Empty slots hit nothing, palette 0 included
+
+    CRGBF* first = palette_lut_claim(cache, 0);
+    palette_lut_build(first, sunset_real, 7);
+    TEST_ASSERT_TRUE(palette_lut_find(cache, 0) == first);
+
+    CRGBF* second = palette_lut_claim(cache, 23);
+    palette_lut_build(second, lava, 13);
+    TEST_ASSERT_TRUE(second != first);
+    TEST_ASSERT_TRUE(palette_lut_find(cache, 0) == first);
+    TEST_ASSERT_TRUE(palette_lut_find(cache, 23) == second);
+
+    // A third palette evicts the oldest fill, keeping the one before
+    CRGBF* third = palette_lut_claim(cache, 5);
+    TEST_ASSERT_TRUE(third == first);
+    TEST_ASSERT_TRUE(palette_lut_find(cache, 0) == nullptr);
+    TEST_ASSERT_TRUE(palette_lut_find(cache, 23) == second);
+    TEST_ASSERT_TRUE(palette_lut_find(cache, 5) == third);
+}
+
+// =============================================================================
+// TEST 4: Cost per frame against the keyframe path
+// =============================================================================
+void test_lookup_cost(void) {
+    const int runs = 5000;
+    volatile float sink = 0.0f;
+    CRGBF lut[PALETTE_LUT_SIZE];
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++) {
+        for (uint16_t i = 0; i < NUM_LEDS; i++) {
+            span[i] = reference_color(lava, 13, r * 0.001f + i / (float)NUM_LEDS, 0.8f);
+        }
+        sink += span[r % NUM_LEDS].r;
+    }
+    const double keyframe_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++) {
+        for (uint16_t i = 0; i < NUM_LEDS; i++) {
+            span[i] = palette_lut_color(lut, r * 0.001f + i / (float)NUM_LEDS, 0.8f);
+        }
+        sink += span[r % NUM_LEDS].r;
+    }
+    const double lookup_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++) {
+        palette_lut_fill(lut, span, NUM_LEDS, r * 0.001f, 1.0f / NUM_LEDS, 0.8f);
+        sink += span[r % NUM_LEDS].r;
+    }
+    const double fill_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++) {
+        palette_lut_build(lut, r & 1 ? lava : sunset_real, r & 1 ? 13 : 7);
+        sink += lut[r & 255].g;
+    }
+    const double build_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    printf("[PALETTE] %d LEDs per frame: keyframe path %.0f ns, table lookups %.0f ns (%.1fx), span fill %.0f ns; table build %.0f ns\n",
+           NUM_LEDS, keyframe_ns, lookup_ns, keyframe_ns / lookup_ns, fill_ns, build_ns);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_lut_matches_keyframes);
+    RUN_TEST(test_span_fill);
+    RUN_TEST(test_slot_cache);
+    RUN_TEST(test_lookup_cost);
+
+    return UNITY_END();
+}
@@ -0,0 +1,223 @@
+/**
+ * TEST SUITE: Pitch Tracker (native)
+ *
+ * Validates the McLeod pitch tracker (pitch_tracker.h) on input that took the
+ * firmware's path: synthesized at 16 kHz and decimated through the half-band
+ * stage to the 8 kHz octave stage it reads on target:
+ * - f0 accuracy (cents) from 65 Hz (C2) to 1047 Hz (C6) on sines, harmonic-rich tones
+ *   and tones in noise, with no octave errors
+ * - noise and silence report no pitch
+ * - the FFT NSDF matches the direct O(W^2) form (both costs reported)
+ *
+ * Run with: pio test -e native -f test_native_pitch_tracker
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include "../../src/audio/octave_decimator.h"
+#include "../../src/audio/pitch_tracker.h"
+
+#define SAMPLE_RATE 16000
+#define PITCH_OCTAVE 1
+#define PITCH_RATE (SAMPLE_RATE >> PITCH_OCTAVE)
+#define CHUNK_SIZE 128
+
+static pitch_tracker tracker;
+
+typedef enum { WAVE_SINE, WAVE_HARMONIC, WAVE_NOISY } wave_shape;
+
+static float noise_sample() {
+    return 2.0f * (rand() / (float)RAND_MAX) - 1.0f;
+}
+
+// 16 kHz tone through one half-band stage; newest PITCH_WINDOW samples at 8 kHz into `window`
+static void render_stage_window(float f0, wave_shape shape, float* window) {
+    halfband_decimator stages[PITCH_OCTAVE] = {};
+    float chunk[CHUNK_SIZE];
+    float half[CHUNK_SIZE / 2];
+    float history[PITCH_WINDOW];
+    const uint32_t chunks = (PITCH_WINDOW / (CHUNK_SIZE / 2)) + 4;   // Warm the filters up
+    uint32_t n = 0;
+    uint32_t written = 0;
+    for (uint32_t c = 0; c < chunks; c++) {
+        for (uint16_t i = 0; i < CHUNK_SIZE; i++, n++) {
+            const float t = n / (float)SAMPLE_RATE;
+            float x = 0.0f;
+            if (shape == WAVE_SINE) {
+                x = 0.5f * sinf(2.0f * (float)M_PI * f0 * t);
+            } else {
+                // Sawtooth-like: harmonics 1/k up to 3 kHz; above 200 Hz the fundamental
+                // drops to the level of the 2nd harmonic (voice-like)
+                for (uint16_t k = 1; k * f0 < 3000.0f; k++) {
+                    const float weight = (k == 1 && f0 > 200.0f) ? 0.5f : 1.0f;
+                    x += weight * 0.3f * sinf(2.0f * (float)M_PI * k * f0 * t) / k;
+                }
+                if (shape == WAVE_NOISY) {
+                    x += 0.05f * noise_sample();
+                }
+            }
+            chunk[i] = x;
+        }
+        halfband_decimate(stages[0], chunk, CHUNK_SIZE, half);
+        for (uint16_t i = 0; i < CHUNK_SIZE / 2; i++) {
+            history[written++ % PITCH_WINDOW] = half[i];
+        }
+    }
+    for (uint16_t i = 0; i < PITCH_WINDOW; i++) {
+        window[i] = history[(written + i) % PITCH_WINDOW];
+    }
+}
+
+static float cents_error(float measured, float expected) {
+    return 1200.0f * log2f(measured / expected);
+}
+
+// Reference: n(tau) = 2 r / m by direct sums
+static void nsdf_direct(const float* window, float* nsdf) {
+    float mean = 0.0f;
+    for (uint16_t j = 0; j < PITCH_WINDOW; j++) {
+        mean += window[j];
+    }
+    mean /= PITCH_WINDOW;
+    for (uint16_t tau = 0; tau <= PITCH_MAX_LAG + 1; tau++) {
+        float r = 0.0f;
+        float m = 0.0f;
+        for (uint16_t j = 0; j + tau < PITCH_WINDOW; j++) {
+            const float a = window[j] - mean;
+            const float b = window[j + tau] - mean;
+            r += a * b;
+            m += a * a + b * b;
+        }
+        nsdf[tau] = m > 0.0f ? 2.0f * r / m : 0.0f;
+    }
+}
+
+void setUp(void) {
+    srand(20);
+    pitch_tracker_init(tracker);
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: f0 accuracy over the musical range
+// =============================================================================
+void test_pitch_accuracy(void) {
+    static const char* names[] = {"sine", "harmonic", "harmonic+noise"};
+    float window[PITCH_WINDOW];
+    for (uint8_t shape = WAVE_SINE; shape <= WAVE_NOISY; shape++) {
+        float worst_cents = 0.0f;
+        float lowest_clarity = 1.0f;
+        uint16_t tones = 0;
+        // Semitone steps, C2 (65 Hz) to C6 (1047 Hz)
+        for (int note = 36; note <= 84; note++) {
+            const float f0 = 440.0f * powf(2.0f, (note - 69) / 12.0f);
+            render_stage_window(f0, (wave_shape)shape, window);
+            const pitch_estimate estimate = pitch_track(tracker, window, PITCH_RATE);
+            TEST_ASSERT_TRUE(estimate.f0_hz > 0.0f);
+            const float cents = fabsf(cents_error(estimate.f0_hz, f0));
+            if (cents > worst_cents) {
+                worst_cents = cents;
+            }
+            if (estimate.clarity < lowest_clarity) {
+                lowest_clarity = estimate.clarity;
+            }
+            TEST_ASSERT_FLOAT_WITHIN(0.25f, (float)note, estimate.midi_note);
+            tones++;
+        }
+        printf("[PITCH] %-15s %u tones 65-1047 Hz: worst error %.1f cents, lowest clarity %.3f\n",
+               names[shape], tones, worst_cents, lowest_clarity);
+        TEST_ASSERT_TRUE(worst_cents < 15.0f);   // Octave errors would be 1200
+        TEST_ASSERT_TRUE(lowest_clarity > 0.8f);
+    }
+}
+
+// =============================================================================
+// TEST 2: Noise and silence are unpitched
+// =============================================================================
+void test_unpitched_input(void) {
+    float window[PITCH_WINDOW];
+    uint16_t pitched = 0;
+    float highest_clarity = 0.0f;
+    for (int trial = 0; trial < 50; trial++) {
+        for (uint16_t i = 0; i < PITCH_WINDOW; i++) {
+            window[i] = 0.3f * noise_sample();
+        }
+        const pitch_estimate estimate = pitch_track(tracker, window, PITCH_RATE);
+        if (estimate.f0_hz > 0.0f) {
+            pitched++;
+        }
+        if (estimate.clarity > highest_clarity) {
+            highest_clarity = estimate.clarity;
+        }
+    }
+    printf("[PITCH] white noise: %u of 50 windows pitched, highest clarity %.3f\n", pitched, highest_clarity);
+    TEST_ASSERT_EQUAL(0, pitched);
+
+    for (uint16_t i = 0; i < PITCH_WINDOW; i++) {
+        window[i] = 0.01f;               // DC only
+    }
+    const pitch_estimate silent = pitch_track(tracker, window, PITCH_RATE);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, silent.f0_hz);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, silent.clarity);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, silent.midi_note);
+}
+
+// =============================================================================
+// TEST 3: FFT NSDF matches the direct form and beats it
+// =============================================================================
+void test_fft_nsdf_matches_direct(void) {
+    float window[PITCH_WINDOW];
+    float direct[PITCH_MAX_LAG + 2];
+    render_stage_window(196.0f, WAVE_NOISY, window);
+
+    TEST_ASSERT_TRUE(pitch_nsdf(tracker, window));
+    nsdf_direct(window, direct);
+    float max_difference = 0.0f;
+    for (uint16_t tau = 0; tau <= PITCH_MAX_LAG + 1; tau++) {
+        const float difference = fabsf(tracker.nsdf[tau] - direct[tau]);
+        if (difference > max_difference) {
+            max_difference = difference;
+        }
+    }
+    TEST_ASSERT_TRUE(max_difference < 1e-4f);
+
+    const int runs = 2000;
+    volatile float sink = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        pitch_nsdf(tracker, window);
+        sink += tracker.nsdf[1];
+    }
+    const double fft_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        nsdf_direct(window, direct);
+        sink += direct[1];
+    }
+    const double direct_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        sink += pitch_track(tracker, window, PITCH_RATE).f0_hz;
+    }
+    const double track_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    printf("[PITCH] NSDF max |FFT - direct| %.2e; per frame: FFT %.0f ns, direct %.0f ns (%.1fx), full estimate %.0f ns\n",
+           max_difference, fft_ns, direct_ns, direct_ns / fft_ns, track_ns);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pitch_accuracy);
+    RUN_TEST(test_unpitched_input);
+    RUN_TEST(test_fft_nsdf_matches_direct);
+
+    return UNITY_END();
+}
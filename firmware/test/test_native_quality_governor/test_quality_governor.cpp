@@ -0,0 +1,251 @@
+/**
+ * TEST SUITE: Audio Quality Governor (native)
+ *
+ * Validates the Core 1 overload governor (quality_governor.h) on a simulated
+ * audio task (chunks due every 8 ms, one analysis per wake):
+ * - every level does less work per frame than the one above it on the
+ *   default (Goertzel) engine, counted on the firmware's real bin layout:
+ *   Goertzel bin-samples, tempo readouts and secondary passes per frame
+ * - a load spike that backs the task up steps the level down until frames
+ *   fit again, and the level comes back once the load drops
+ * - a load that only fits at a reduced level does not make the governor
+ *   oscillate (step-up wait backs off)
+ *
+ * Run with: pio test -e native -f test_native_quality_governor
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../src/audio/octave_decimator.h"
+#include "../../src/audio/bin_scheduler.h"
+#include "../../src/audio/quality_governor.h"
+
+#define AUDIO_FRAME_US 8000
+#define HOP 128
+#define SAMPLE_RATE 16000
+#define NUM_OCTAVE_STAGES 4
+#define OCTAVE_HISTORY_LENGTH 512
+#define NUM_FREQS 64
+#define LANES 4
+#define NUM_GROUPS (NUM_FREQS / LANES)
+
+static quality_governor governor;
+
+// Simulated audio task: frame k's chunks are complete at k * AUDIO_FRAME_US
+typedef struct {
+    uint32_t now_us;                     // Task time (end of the last frame)
+    uint32_t consumed;                   // Frames' worth of chunks taken so far
+    uint32_t late_frames;
+    uint32_t backlog_max;                // Most frames found at one wake
+} audio_task_sim;
+
+// One wake: take every complete frame, analyse once at `cost_us`, feed the governor
+static void audio_task_step(audio_task_sim& sim, uint32_t cost_us) {
+    uint32_t wake_us = (sim.consumed + 1) * AUDIO_FRAME_US;
+    if (sim.now_us > wake_us) {
+        wake_us = sim.now_us;
+    }
+    const uint32_t found = wake_us / AUDIO_FRAME_US - sim.consumed;
+    const uint32_t newest_us = (sim.consumed + found) * AUDIO_FRAME_US;
+    sim.consumed += found;
+    sim.now_us = wake_us + cost_us;
+
+    const bool late = found > 1;
+    if (late) {
+        sim.late_frames++;
+    }
+    if (found > sim.backlog_max) {
+        sim.backlog_max = found;
+    }
+    const int32_t slack_us = (int32_t)AUDIO_FRAME_US - (int32_t)(sim.now_us - newest_us);
+    quality_governor_frame(governor, slack_us, late, AUDIO_FRAME_US);
+}
+
+// Frame cost at each level: full cost scaled by what the level still runs, +-5% jitter
+static uint32_t frame_cost_us(uint32_t full_cost_us, uint8_t level) {
+    static const float scale[QUALITY_LEVELS] = {1.00f, 0.85f, 0.70f, 0.55f};
+    const float jitter = 0.95f + 0.10f * (rand() / (float)RAND_MAX);
+    return (uint32_t)(full_cost_us * scale[level] * jitter);
+}
+
+// Goertzel group windows and costs as init_goertzel_constants_musical() lays them out
+static uint32_t group_window[NUM_GROUPS];   // Full-rate samples
+static uint32_t group_cost[NUM_GROUPS];     // Bin-samples per update
+
+static void init_groups() {
+    float target[NUM_FREQS], bandwidth[NUM_FREQS];
+    for (int i = 0; i < NUM_FREQS; i++) {
+        target[i] = 110.0f * powf(2.0f, i / 12.0f);
+        bandwidth[i] = target[i] * (powf(2.0f, 1.0f / 24.0f) - 1.0f) * 4.0f;
+    }
+    for (int g = 0; g < NUM_GROUPS; g++) {
+        float top_freq = 0.0f, min_bandwidth = bandwidth[g * LANES];
+        for (int lane = 0; lane < LANES; lane++) {
+            top_freq = fmaxf(top_freq, target[g * LANES + lane]);
+            min_bandwidth = fminf(min_bandwidth, bandwidth[g * LANES + lane]);
+        }
+        const uint8_t octave = octave_select_stage(top_freq, min_bandwidth, SAMPLE_RATE, NUM_OCTAVE_STAGES, OCTAVE_HISTORY_LENGTH);
+        uint16_t length = 0;
+        for (int lane = 0; lane < LANES; lane++) {
+            uint16_t full_rate_block_size = SAMPLE_RATE / bandwidth[g * LANES + lane];
+            full_rate_block_size -= full_rate_block_size % 4;
+            const uint16_t block_size = full_rate_block_size >> octave;
+            length = block_size > length ? block_size : length;
+        }
+        group_window[g] = (uint32_t)length << octave;
+        group_cost[g] = (uint32_t)length * LANES;
+    }
+}
+
+// Scheduled Goertzel bin-samples at a level: mean and busiest frame of the cycle (init_bin_schedule())
+static void goertzel_work(const audio_quality& q, double* mean, uint32_t* peak) {
+    uint8_t periods[NUM_GROUPS], phases[NUM_GROUPS];
+    uint32_t slot_load[BIN_SCHEDULE_MAX_PERIOD];
+    *mean = 0.0;
+    for (int g = 0; g < NUM_GROUPS; g++) {
+        periods[g] = bin_schedule_period(group_window[g], HOP, BIN_SCHEDULE_MAX_PERIOD, q.bin_overlap, q.bin_min_period);
+        *mean += (double)group_cost[g] / periods[g];
+    }
+    bin_schedule_assign(periods, group_cost, NUM_GROUPS, BIN_SCHEDULE_MAX_PERIOD, phases, slot_load);
+    *peak = 0;
+    for (uint8_t s = 0; s < BIN_SCHEDULE_MAX_PERIOD; s++) {
+        *peak = slot_load[s] > *peak ? slot_load[s] : *peak;
+    }
+}
+
+void setUp(void) {
+    srand(18);
+    quality_governor_init(governor);
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Levels only ever shed work
+// =============================================================================
+void test_levels_shed_work(void) {
+    for (uint8_t level = 1; level < QUALITY_LEVELS; level++) {
+        const audio_quality above = audio_quality_for_level(level - 1);
+        const audio_quality q = audio_quality_for_level(level);
+        TEST_ASSERT_TRUE(q.tempo_readout_interval >= above.tempo_readout_interval);
+        TEST_ASSERT_TRUE(q.refresh_interval >= above.refresh_interval);
+        TEST_ASSERT_TRUE(q.bin_overlap <= above.bin_overlap);
+        TEST_ASSERT_TRUE(q.refresh_interval >= 1 && q.bin_overlap >= 1);
+    }
+    TEST_ASSERT_EQUAL(audio_quality_for_level(QUALITY_LEVELS - 1).bin_overlap, audio_quality_for_level(200).bin_overlap);
+    TEST_ASSERT_EQUAL(bin_schedule_period(3200, HOP, BIN_SCHEDULE_MAX_PERIOD),
+                      bin_schedule_period(3200, HOP, BIN_SCHEDULE_MAX_PERIOD, BIN_SCHEDULE_OVERLAP, 1));
+
+    // Per-frame work on the default engine: each level drops at least one part and raises none,
+    // and the levels that change the bin schedule (2 and 3) cut the Goertzel work itself
+    init_groups();
+    double goertzel_mean[QUALITY_LEVELS];
+    uint32_t goertzel_peak[QUALITY_LEVELS];
+    for (uint8_t level = 0; level < QUALITY_LEVELS; level++) {
+        const audio_quality q = audio_quality_for_level(level);
+        goertzel_work(q, &goertzel_mean[level], &goertzel_peak[level]);
+        printf("[GOVERNOR] level %u per frame: Goertzel %.0f bin-samples (busiest %u), %.3f tempo readouts, %.2f secondary passes\n",
+               level, goertzel_mean[level], goertzel_peak[level], 1.0 / q.tempo_readout_interval, 1.0 / q.refresh_interval);
+        if (level == 0) {
+            continue;
+        }
+        const audio_quality above = audio_quality_for_level(level - 1);
+        TEST_ASSERT_TRUE(goertzel_mean[level] <= goertzel_mean[level - 1]);
+        TEST_ASSERT_TRUE(goertzel_mean[level] < goertzel_mean[level - 1] ||
+                         q.tempo_readout_interval > above.tempo_readout_interval ||
+                         q.refresh_interval > above.refresh_interval);
+    }
+    TEST_ASSERT_TRUE(goertzel_mean[2] < goertzel_mean[1] * 0.8);
+    TEST_ASSERT_TRUE(goertzel_peak[2] < goertzel_peak[1]);
+    TEST_ASSERT_TRUE(goertzel_mean[3] < goertzel_mean[2] * 0.8);
+    TEST_ASSERT_TRUE(goertzel_peak[3] < goertzel_peak[2]);
+}
+
+// =============================================================================
+// TEST 2: Step down under overload, back up when it clears
+// =============================================================================
+void test_overload_and_recovery(void) {
+    audio_task_sim sim = {0, 0, 0, 0};
+
+    // Normal load: full quality throughout
+    for (int i = 0; i < 2000; i++) {
+        audio_task_step(sim, frame_cost_us(3000, governor.level));
+    }
+    TEST_ASSERT_EQUAL(0, governor.level);
+    TEST_ASSERT_EQUAL_UINT32(0, sim.late_frames);
+
+    // Heavy load (9 ms per frame at full quality): backs up until the level drops
+    const uint32_t late_before = sim.late_frames;
+    uint32_t settled_after = 0;
+    for (int i = 0; i < 4000; i++) {
+        const uint8_t level = governor.level;
+        audio_task_step(sim, frame_cost_us(9000, level));
+        if (governor.level != level) {
+            settled_after = i + 1;
+        }
+    }
+    const uint32_t heavy_late = sim.late_frames - late_before;
+    printf("[GOVERNOR] heavy load: level %u after %u frames, %u late frames, backlog max %u frames\n",
+           governor.level, settled_after, heavy_late, sim.backlog_max);
+    TEST_ASSERT_TRUE(governor.level >= 1);
+    TEST_ASSERT_TRUE(settled_after < 100);
+    TEST_ASSERT_TRUE(heavy_late < 50);
+    TEST_ASSERT_TRUE(sim.backlog_max <= 2);
+
+    // No backlog once settled
+    const uint32_t late_settled = sim.late_frames;
+    for (int i = 0; i < 2000; i++) {
+        audio_task_step(sim, frame_cost_us(9000, governor.level));
+    }
+    TEST_ASSERT_EQUAL_UINT32(late_settled, sim.late_frames);
+
+    // Load drops: full quality again within a step-up wait per level
+    uint32_t recovered_after = 0;
+    for (int i = 0; i < 4000 && governor.level > 0; i++) {
+        audio_task_step(sim, frame_cost_us(3000, governor.level));
+        recovered_after = i + 1;
+    }
+    printf("[GOVERNOR] load dropped: back to level 0 after %u frames (%.1f s)\n",
+           recovered_after, recovered_after * AUDIO_FRAME_US / 1e6f);
+    TEST_ASSERT_EQUAL(0, governor.level);
+    TEST_ASSERT_TRUE(recovered_after <= (QUALITY_LEVELS - 1) * (QUALITY_CALM_FRAMES + 10));
+}
+
+// =============================================================================
+// TEST 3: No oscillation around a load that only fits at a reduced level
+// =============================================================================
+void test_no_oscillation(void) {
+    audio_task_sim sim = {0, 0, 0, 0};
+
+    // Overruns at full quality, comfortable at level 1 (looks like headroom to step up into)
+    static const uint32_t cost_us[QUALITY_LEVELS] = {8500, 3200, 2800, 2400};
+    const uint32_t frames = 60000;         // 8 minutes
+    uint32_t frames_at_full = 0;
+    for (uint32_t i = 0; i < frames; i++) {
+        if (governor.level == 0) {
+            frames_at_full++;
+        }
+        audio_task_step(sim, cost_us[governor.level]);
+    }
+
+    // Without back-off this would retry every QUALITY_CALM_FRAMES frames
+    const uint32_t naive_retries = frames / QUALITY_CALM_FRAMES;
+    printf("[GOVERNOR] %u frames: %u step-ups (%u without back-off), %u late frames, %u frames at full quality\n",
+           frames, governor.step_ups, naive_retries, sim.late_frames, frames_at_full);
+    TEST_ASSERT_TRUE(governor.step_ups * 4 < naive_retries);
+    TEST_ASSERT_TRUE(sim.late_frames <= governor.step_ups + 1);
+    TEST_ASSERT_TRUE(frames_at_full <= 2 * (governor.step_ups + 1));   // Each retry is taken back at once
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_levels_shed_work);
+    RUN_TEST(test_overload_and_recovery);
+    RUN_TEST(test_no_oscillation);
+
+    return UNITY_END();
+}
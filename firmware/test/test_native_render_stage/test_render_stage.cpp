@@ -0,0 +1,177 @@
+/**
+ * TEST SUITE: Render Stage (native)
+ *
+ * Validates the shared post-process between patterns and the LEDs (render_stage.h):
+ * - centre-origin half frames land on mirrored pairs about the strip centre
+ * - full frames pass through, in place, clamped to 0.0-1.0
+ * - softness: 0 passes frames untouched, higher values trail toward the new frame
+ * - per-frame cost (reported) of a half frame plus the stage against the
+ *   full-strip render, mirror and clamp loops it replaces
+ *
+ * Run with: pio test -e native -f test_native_render_stage
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include "../../src/render_stage.h"
+
+#define NUM_LEDS RENDER_STRIP_LENGTH
+#define HALF RENDER_HALF_LENGTH
+
+static render_stage stage;
+static CRGBF half[HALF];
+static CRGBF strip[NUM_LEDS];
+
+void setUp(void) {
+    stage = render_stage();
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        strip[i] = CRGBF();
+    }
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Mirroring and clamping
+// =============================================================================
+void test_mirror_and_clamp(void) {
+    for (uint16_t d = 0; d < HALF; d++) {
+        half[d] = CRGBF(d / (float)HALF, 1.0f - d / (float)HALF, 0.5f);
+    }
+    half[3] = CRGBF(1.7f, -0.4f, 2.0f);              // Additive overshoot, negative
+
+    render_stage_finish(stage, half, true, 0.0f, strip);
+    for (uint16_t d = 0; d < HALF; d++) {
+        const CRGBF& left = strip[HALF - 1 - d];
+        const CRGBF& right = strip[HALF + d];
+        TEST_ASSERT_EQUAL_FLOAT(left.r, right.r);
+        TEST_ASSERT_EQUAL_FLOAT(left.g, right.g);
+        TEST_ASSERT_EQUAL_FLOAT(left.b, right.b);
+    }
+    // [0] on the centre pair (89, 90), the last entry on both edges
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, strip[89].r);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, strip[90].r);
+    TEST_ASSERT_EQUAL_FLOAT(half[HALF - 1].r, strip[0].r);
+    TEST_ASSERT_EQUAL_FLOAT(half[HALF - 1].r, strip[NUM_LEDS - 1].r);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, strip[HALF + 3].r);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, strip[HALF + 3].g);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, strip[HALF - 4].b);
+
+    // Full frames pass through in place, clamped
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        strip[i] = CRGBF(i / (float)NUM_LEDS, 0.25f, (i & 1) ? 3.0f : -1.0f);
+    }
+    render_stage_finish(stage, strip, false, 0.0f, strip);
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(i / (float)NUM_LEDS, strip[i].r);
+        TEST_ASSERT_EQUAL_FLOAT(0.25f, strip[i].g);
+        TEST_ASSERT_EQUAL_FLOAT((i & 1) ? 1.0f : 0.0f, strip[i].b);
+    }
+}
+
+// =============================================================================
+// TEST 2: Softness frame blend
+// =============================================================================
+void test_softness(void) {
+    // A step from black to white: frames until the output passes 90%
+    static const float softness_levels[] = {0.0f, 0.25f, 0.5f, 1.0f};
+    uint16_t previous_frames = 0;
+    for (float softness : softness_levels) {
+        stage = render_stage();
+        for (uint16_t d = 0; d < HALF; d++) {
+            half[d] = CRGBF(1.0f, 1.0f, 1.0f);
+        }
+        uint16_t frames = 0;
+        do {
+            render_stage_finish(stage, half, true, softness, strip);
+            frames++;
+        } while (strip[0].r < 0.9f && frames < 1000);
+        printf("[RENDER] softness %.2f: step response reaches 90%% in %u frames\n", softness, frames);
+        TEST_ASSERT_TRUE(frames >= previous_frames);
+        previous_frames = frames;
+        if (softness == 0.0f) {
+            TEST_ASSERT_EQUAL(1, frames);
+            TEST_ASSERT_EQUAL_FLOAT(1.0f, strip[0].r);
+        }
+    }
+    TEST_ASSERT_TRUE(previous_frames <= 30);         // Softness 1.0 still settles within ~200 ms at 150 FPS
+
+    // A switch from a full pattern to a half one blends each side from its own last frame
+    stage = render_stage();
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        strip[i] = CRGBF(i < HALF ? 1.0f : 0.0f, 0.0f, 0.0f);
+    }
+    render_stage_finish(stage, strip, false, 0.0f, strip);
+    for (uint16_t d = 0; d < HALF; d++) {
+        half[d] = CRGBF(0.5f, 0.0f, 0.0f);
+    }
+    render_stage_finish(stage, half, true, 1.0f, strip);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f + 0.5f * RENDER_SOFTNESS_MAX, strip[0].r);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f * (1.0f - RENDER_SOFTNESS_MAX), strip[NUM_LEDS - 1].r);
+}
+
+// =============================================================================
+// TEST 3: Cost per frame against per-pattern full-strip loops
+// =============================================================================
+
+// A centre-symmetric gradient as the patterns drew it before: all 180 LEDs, mirror, clamp
+static void render_full_strip(float phase, CRGBF* out) {
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        const float position = fabsf((float)i - NUM_LEDS / 2.0f) / (NUM_LEDS / 2.0f);
+        const float v = 0.5f + 0.5f * sinf(6.0f * position + phase);
+        out[i] = CRGBF(v, v * position, 1.0f - v);
+    }
+    for (uint16_t i = 0; i < NUM_LEDS / 2; i++) {
+        out[NUM_LEDS - 1 - i] = out[i];
+    }
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        out[i].r = fmaxf(0.0f, fminf(1.0f, out[i].r));
+        out[i].g = fmaxf(0.0f, fminf(1.0f, out[i].g));
+        out[i].b = fmaxf(0.0f, fminf(1.0f, out[i].b));
+    }
+}
+
+// The same gradient on the half-strip contract
+static void render_half_strip(float phase, CRGBF* out) {
+    for (uint16_t d = 0; d < HALF; d++) {
+        const float position = d / (float)HALF;
+        const float v = 0.5f + 0.5f * sinf(6.0f * position + phase);
+        out[d] = CRGBF(v, v * position, 1.0f - v);
+    }
+}
+
+void test_render_cost(void) {
+    const int runs = 20000;
+    volatile float sink = 0.0f;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++) {
+        render_full_strip(r * 0.01f, strip);
+        sink += strip[r % NUM_LEDS].r;
+    }
+    const double full_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++) {
+        render_half_strip(r * 0.01f, half);
+        render_stage_finish(stage, half, true, 0.25f, strip);
+        sink += strip[r % NUM_LEDS].r;
+    }
+    const double half_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    printf("[RENDER] %d LEDs per frame: full-strip pattern + mirror + clamp %.0f ns, half pattern + stage (with softness) %.0f ns\n",
+           NUM_LEDS, full_ns, half_ns);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mirror_and_clamp);
+    RUN_TEST(test_softness);
+    RUN_TEST(test_render_cost);
+
+    return UNITY_END();
+}
@@ -0,0 +1,281 @@
+/**
+ * TEST SUITE: Fused Spectrum Smoothing (native)
+ *
+ * Regression test for the post-Goertzel stage of calculate_magnitudes():
+ * the previous implementation (full re-sum of the 6-frame and 8-frame
+ * rings for every bin, then separate gain / clip / VU passes) against the
+ * fused two-pass version built on running_mean.h.
+ *
+ * Both run on the same raw magnitudes (noise floor, silence, transients,
+ * gain changes) for many ring laps; every published value must agree to
+ * float rounding (running sums are not bit-exact re-sums, so the bound is
+ * 1e-5 of full scale, and the per-lap resync keeps it from growing).
+ *
+ * Run with: pio test -e native -f test_native_spectral_smoothing
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <chrono>
+#include "../../src/audio/running_mean.h"
+
+#define NUM_FREQS 64
+#define NUM_AVERAGE_SAMPLES 6
+#define NUM_SPECTROGRAM_AVERAGE_SAMPLES 8
+#define NUM_FRAMES 20000
+
+static inline float clip_float(float val) {
+    return fmax(0.0f, fmin(1.0f, val));
+}
+
+typedef struct {
+    float spectrogram[NUM_FREQS];
+    float spectrogram_smooth[NUM_FREQS];
+    float vu_level;
+    float vu_level_raw;
+} stage_output;
+
+// Shared inputs
+static float noise_spectrum[NUM_FREQS];
+
+static float filter_noise(float magnitude, uint16_t bin) {
+    float out = magnitude - noise_spectrum[bin];
+    return out < 0.0f ? 0.0f : out;
+}
+
+// -----------------------------------------------------------------------------
+// Previous implementation (verbatim structure of the old calculate_magnitudes())
+// -----------------------------------------------------------------------------
+struct reference_stage {
+    float magnitudes_avg[NUM_AVERAGE_SAMPLES][NUM_FREQS] = {};
+    float magnitudes_smooth[NUM_FREQS] = {};
+    float max_val_smooth = 0.0f;
+    uint32_t iter = 0;
+    float spectrogram_average[NUM_SPECTROGRAM_AVERAGE_SAMPLES][NUM_FREQS] = {};
+    uint8_t spectrogram_average_index = 0;
+
+    void run(const float* raw_in, float gain, stage_output& out) {
+        float magnitudes_raw[NUM_FREQS];
+        float spectrogram[NUM_FREQS], spectrogram_smooth[NUM_FREQS];
+        iter++;
+
+        float max_val = 0.0;
+        for (uint16_t i = 0; i < NUM_FREQS; i++) {
+            magnitudes_raw[i] = filter_noise(raw_in[i], i);
+            magnitudes_avg[iter % NUM_AVERAGE_SAMPLES][i] = magnitudes_raw[i];
+
+            float magnitudes_avg_result = 0.0;
+            for (uint8_t a = 0; a < NUM_AVERAGE_SAMPLES; a++) {
+                magnitudes_avg_result += magnitudes_avg[a][i];
+            }
+            magnitudes_avg_result /= NUM_AVERAGE_SAMPLES;
+            magnitudes_smooth[i] = magnitudes_avg_result;
+            if (magnitudes_smooth[i] > max_val) {
+                max_val = magnitudes_smooth[i];
+            }
+        }
+
+        if (max_val > max_val_smooth) {
+            float delta = max_val - max_val_smooth;
+            max_val_smooth += delta * 0.005;
+        }
+        if (max_val < max_val_smooth) {
+            float delta = max_val_smooth - max_val;
+            max_val_smooth -= delta * 0.005;
+        }
+        if (max_val_smooth < 0.000001) {
+            max_val_smooth = 0.000001;
+        }
+        float autoranger_scale = 1.0 / (max_val_smooth);
+
+        for (uint16_t i = 0; i < NUM_FREQS; i++) {
+            spectrogram[i] = clip_float(magnitudes_smooth[i] * autoranger_scale);
+        }
+
+        spectrogram_average_index++;
+        if (spectrogram_average_index >= NUM_SPECTROGRAM_AVERAGE_SAMPLES) {
+            spectrogram_average_index = 0;
+        }
+        for (uint16_t i = 0; i < NUM_FREQS; i++) {
+            spectrogram_average[spectrogram_average_index][i] = spectrogram[i];
+            spectrogram_smooth[i] = 0;
+            for (uint16_t a = 0; a < NUM_SPECTROGRAM_AVERAGE_SAMPLES; a++) {
+                spectrogram_smooth[i] += spectrogram_average[a][i];
+            }
+            spectrogram_smooth[i] /= float(NUM_SPECTROGRAM_AVERAGE_SAMPLES);
+        }
+
+        for (uint16_t i = 0; i < NUM_FREQS; i++) {
+            spectrogram[i] = clip_float(spectrogram[i] * gain);
+            spectrogram_smooth[i] = clip_float(spectrogram_smooth[i] * gain);
+        }
+
+        float vu_sum = 0.0f;
+        for (uint16_t i = 0; i < NUM_FREQS; i++) {
+            vu_sum += spectrogram_smooth[i];
+        }
+        float vu_level_calculated = vu_sum / NUM_FREQS;
+
+        memcpy(out.spectrogram, spectrogram, sizeof(spectrogram));
+        memcpy(out.spectrogram_smooth, spectrogram_smooth, sizeof(spectrogram_smooth));
+        out.vu_level = vu_level_calculated;
+        out.vu_level_raw = vu_level_calculated * max_val_smooth;
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Fused implementation (mirrors calculate_magnitudes())
+// -----------------------------------------------------------------------------
+struct fused_stage {
+    float magnitudes_avg[NUM_AVERAGE_SAMPLES][NUM_FREQS] = {};
+    float magnitudes_avg_sum[NUM_FREQS] = {};
+    float magnitudes_smooth[NUM_FREQS] = {};
+    float max_val_smooth = 0.0f;
+    uint8_t avg_index = 0;
+    float spectrogram_average[NUM_SPECTROGRAM_AVERAGE_SAMPLES][NUM_FREQS] = {};
+    float spectrogram_average_sum[NUM_FREQS] = {};
+    uint8_t spectrogram_average_index = 0;
+
+    void run(const float* raw_in, float gain, stage_output& out) {
+        avg_index = (avg_index + 1) % NUM_AVERAGE_SAMPLES;
+        if (avg_index == 0) {
+            running_mean_resync(&magnitudes_avg[0][0], NUM_AVERAGE_SAMPLES, NUM_FREQS, magnitudes_avg_sum);
+        }
+
+        float max_val = 0.0;
+        for (uint16_t i = 0; i < NUM_FREQS; i++) {
+            float raw = filter_noise(raw_in[i], i);
+            magnitudes_smooth[i] = running_mean_replace(magnitudes_avg_sum[i], magnitudes_avg[avg_index][i], raw, NUM_AVERAGE_SAMPLES);
+            if (magnitudes_smooth[i] > max_val) {
+                max_val = magnitudes_smooth[i];
+            }
+        }
+
+        if (max_val > max_val_smooth) {
+            float delta = max_val - max_val_smooth;
+            max_val_smooth += delta * 0.005;
+        }
+        if (max_val < max_val_smooth) {
+            float delta = max_val_smooth - max_val;
+            max_val_smooth -= delta * 0.005;
+        }
+        if (max_val_smooth < 0.000001) {
+            max_val_smooth = 0.000001;
+        }
+        float autoranger_scale = 1.0 / (max_val_smooth);
+
+        spectrogram_average_index++;
+        if (spectrogram_average_index >= NUM_SPECTROGRAM_AVERAGE_SAMPLES) {
+            spectrogram_average_index = 0;
+            running_mean_resync(&spectrogram_average[0][0], NUM_SPECTROGRAM_AVERAGE_SAMPLES, NUM_FREQS, spectrogram_average_sum);
+        }
+
+        float vu_sum = 0.0f;
+        for (uint16_t i = 0; i < NUM_FREQS; i++) {
+            float magnitude = clip_float(magnitudes_smooth[i] * autoranger_scale);
+            float smooth = running_mean_replace(spectrogram_average_sum[i], spectrogram_average[spectrogram_average_index][i], magnitude, NUM_SPECTROGRAM_AVERAGE_SAMPLES);
+            out.spectrogram[i] = clip_float(magnitude * gain);
+            out.spectrogram_smooth[i] = clip_float(smooth * gain);
+            vu_sum += out.spectrogram_smooth[i];
+        }
+
+        float vu_level_calculated = vu_sum / NUM_FREQS;
+        out.vu_level = vu_level_calculated;
+        out.vu_level_raw = vu_level_calculated * max_val_smooth;
+    }
+};
+
+// Music-like raw magnitudes: noise floor, sustained partials, periodic
+// transients and stretches of silence, with occasional gain changes
+static void next_frame(uint32_t frame, float* raw, float& gain) {
+    const bool silent = (frame / 1500) % 5 == 4;
+    for (int i = 0; i < NUM_FREQS; i++) {
+        float noise = (rand() / (float)RAND_MAX) * 0.002f;
+        float partial = ((i + frame / 200) % 7 == 0) ? 0.05f * (1.0f + sinf(frame * 0.01f + i)) : 0.0f;
+        float transient = (frame % 60 < 3 && i < 12) ? 0.3f : 0.0f;
+        raw[i] = silent ? 0.0f : noise + partial + transient;
+    }
+    if (frame % 2500 == 0) {
+        static const float gains[] = { 1.0f, 0.5f, 2.0f, 1.3f };
+        gain = gains[(frame / 2500) % 4];
+    }
+}
+
+void setUp(void) {
+    srand(1234);
+    for (int i = 0; i < NUM_FREQS; i++) {
+        noise_spectrum[i] = 0.0005f * (i % 5);
+    }
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Fused stage matches the previous implementation frame for frame
+// =============================================================================
+void test_fused_matches_previous(void) {
+    static reference_stage reference;
+    static fused_stage fused;
+    stage_output expected, actual;
+    float raw[NUM_FREQS];
+    float gain = 1.0f;
+
+    double worst = 0.0;
+    uint32_t exact = 0, compared = 0;
+    for (uint32_t frame = 0; frame < NUM_FRAMES; frame++) {
+        next_frame(frame, raw, gain);
+        reference.run(raw, gain, expected);
+        fused.run(raw, gain, actual);
+
+        for (int i = 0; i < NUM_FREQS; i++) {
+            worst = fmax(worst, fabs(expected.spectrogram[i] - actual.spectrogram[i]));
+            worst = fmax(worst, fabs(expected.spectrogram_smooth[i] - actual.spectrogram_smooth[i]));
+            exact += (expected.spectrogram[i] == actual.spectrogram[i]) + (expected.spectrogram_smooth[i] == actual.spectrogram_smooth[i]);
+            compared += 2;
+        }
+        worst = fmax(worst, fabs(expected.vu_level - actual.vu_level));
+        worst = fmax(worst, fabs(expected.vu_level_raw - actual.vu_level_raw));
+    }
+
+    printf("[SMOOTH] %u frames: %.2f%% of values bit-identical, worst difference %.3g\n",
+           NUM_FRAMES, 100.0 * exact / compared, worst);
+    TEST_ASSERT_TRUE(worst < 1e-5);
+}
+
+// =============================================================================
+// TEST 2: Cost per frame, before / after (reported)
+// =============================================================================
+void test_benchmark(void) {
+    static reference_stage reference;
+    static fused_stage fused;
+    stage_output out;
+    float gain = 1.0f;
+    const uint32_t frames = 20000;
+    static float inputs[64][NUM_FREQS];
+    for (int f = 0; f < 64; f++) {
+        next_frame(f * 37, inputs[f], gain);
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t f = 0; f < frames; f++) reference.run(inputs[f & 63], gain, out);
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t f = 0; f < frames; f++) fused.run(inputs[f & 63], gain, out);
+    auto t2 = std::chrono::steady_clock::now();
+
+    double reference_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / frames;
+    double fused_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / frames;
+    printf("[BENCH] per frame: previous %.0f ns, fused %.0f ns (%.1fx)\n", reference_ns, fused_ns, reference_ns / fused_ns);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fused_matches_previous);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}
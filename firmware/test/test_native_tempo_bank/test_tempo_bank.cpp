@@ -0,0 +1,270 @@
+/**
+ * TEST SUITE: Sliding-DFT Tempo Bank (native)
+ *
+ * Validates the recursive tempo bank (tempo_bank.h) against the windowed
+ * Goertzel it replaces (calculate_magnitude_of_tempo()):
+ * - same normalized magnitudes and phases on a beat-like novelty stream
+ *   (within 1% of the peak in range; beats above the range leak into it
+ *   through the truncated window's tail, reproduced within 5%)
+ * - no drift after hours of novelty frames (damped recursion)
+ * - cost per frame (reported): one bank push + 64 reads vs 64 x 2048-sample Goertzels
+ *
+ * Run with: pio test -e native -f test_native_tempo_bank
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include "../../src/audio/tempo_bank.h"
+
+#define NUM_TEMPI 64
+#define NOVELTY_HISTORY_LENGTH 2048
+#define NOVELTY_LOG_HZ 125                  // One novelty sample per 8 ms audio frame
+#define TEMPO_LOW (64-32)
+#define TEMPO_HIGH (192-32)
+
+static float window_lookup[4096];
+static uint16_t tempo_block_size[NUM_TEMPI];
+static uint16_t tempo_dft_bin[NUM_TEMPI];
+static float history[NOVELTY_HISTORY_LENGTH];
+static tempo_bank bank;
+
+// Mirrors init_window_lookup() (float path)
+static void init_window(void) {
+    const float sigma = 0.8f;
+    for (uint16_t i = 0; i < 2048; i++) {
+        float n_minus_halfN = i - 2048 / 2;
+        window_lookup[i] = expf(-0.5f * powf(n_minus_halfN / (sigma * 2048 / 2), 2));
+        window_lookup[4095 - i] = window_lookup[i];
+    }
+}
+
+// Mirrors init_tempo_goertzel_constants()
+static void init_bins(void) {
+    float hz[NUM_TEMPI];
+    for (uint16_t i = 0; i < NUM_TEMPI; i++) {
+        hz[i] = ((TEMPO_HIGH - TEMPO_LOW) * float(i) / NUM_TEMPI + TEMPO_LOW) / 60.0f;
+    }
+    for (uint16_t i = 0; i < NUM_TEMPI; i++) {
+        float left = hz[i == 0 ? i : i - 1];
+        float right = hz[i == NUM_TEMPI - 1 ? i : i + 1];
+        float max_distance_hz = fmaxf(fabsf(left - hz[i]), fabsf(right - hz[i]));
+        uint32_t block_size = NOVELTY_LOG_HZ / (max_distance_hz * 0.5f);
+        tempo_block_size[i] = block_size > NOVELTY_HISTORY_LENGTH ? NOVELTY_HISTORY_LENGTH : block_size;
+        tempo_dft_bin[i] = (int)(0.5f + (tempo_block_size[i] * hz[i]) / NOVELTY_LOG_HZ);
+    }
+
+    float window[NOVELTY_HISTORY_LENGTH];
+    for (uint16_t m = 0; m < NOVELTY_HISTORY_LENGTH; m++) {
+        window[m] = window_lookup[(uint32_t)(m * (4096.0f / NOVELTY_HISTORY_LENGTH))];
+    }
+    TEST_ASSERT_TRUE(tempo_bank_init(bank, NOVELTY_HISTORY_LENGTH, tempo_dft_bin[0], tempo_dft_bin[NUM_TEMPI - 1],
+                                     window, TEMPO_BANK_DAMPING));
+}
+
+// The replaced per-bin Goertzel, over the latest block_size samples
+static void reference_bin(uint16_t bin, float scale, float* magnitude, float* phase) {
+    const uint16_t block_size = tempo_block_size[bin];
+    const float w = (2.0f * M_PI * tempo_dft_bin[bin]) / block_size;
+    const float coeff = 2.0f * cosf(w);
+    const float window_step = 4096.0f / block_size;
+    float q1 = 0, q2 = 0, window_pos = 0;
+    for (uint16_t i = 0; i < block_size; i++) {
+        float sample = history[NOVELTY_HISTORY_LENGTH - block_size + i] * scale;
+        float q0 = coeff * q1 - q2 + sample * window_lookup[(uint32_t)window_pos];
+        q2 = q1;
+        q1 = q0;
+        window_pos += window_step;
+    }
+    float real = q1 - q2 * cosf(w);
+    float imag = q2 * sinf(w);
+    *phase = atan2f(imag, real);
+    *magnitude = sqrtf(q1 * q1 + q2 * q2 - q1 * q2 * coeff) / (block_size / 2.0f);
+}
+
+static void bank_bin(uint16_t bin, float scale, float* magnitude, float* phase) {
+    float real, imag;
+    tempo_bank_read(bank, tempo_dft_bin[bin], scale, &real, &imag);
+    *phase = atan2f(imag, real);
+    *magnitude = sqrtf(real * real + imag * imag) / (tempo_block_size[bin] / 2.0f);
+}
+
+// Beat-like novelty: spikes at `bpm` with timing jitter, plus noise
+static float novelty_sample(uint32_t frame, float bpm) {
+    const float period = NOVELTY_LOG_HZ * 60.0f / bpm;
+    const float position = fmodf((float)frame, period);
+    float value = 0.05f * (rand() / (float)RAND_MAX);
+    if (position < 1.0f) {
+        value += 0.6f + 0.4f * (rand() / (float)RAND_MAX);
+    }
+    return value;
+}
+
+// Mirrors update_novelty_curve(): shift in, feed the bank with the sample leaving
+static void push(float value) {
+    const float leaving = history[0];
+    memmove(history, history + 1, (NOVELTY_HISTORY_LENGTH - 1) * sizeof(float));
+    history[NOVELTY_HISTORY_LENGTH - 1] = value;
+    tempo_bank_push(bank, value, leaving);
+}
+
+static float worst_magnitude_error(float scale, float* worst_phase_error) {
+    float peak = 0.0f, worst = 0.0f;
+    float reference_magnitude[NUM_TEMPI], reference_phase[NUM_TEMPI];
+    for (uint16_t i = 0; i < NUM_TEMPI; i++) {
+        reference_bin(i, scale, &reference_magnitude[i], &reference_phase[i]);
+        peak = fmaxf(peak, reference_magnitude[i]);
+    }
+    *worst_phase_error = 0.0f;
+    for (uint16_t i = 0; i < NUM_TEMPI; i++) {
+        float magnitude, phase;
+        bank_bin(i, scale, &magnitude, &phase);
+        worst = fmaxf(worst, fabsf(magnitude - reference_magnitude[i]) / peak);
+
+        // Phase only matters where there is energy
+        if (reference_magnitude[i] > 0.25f * peak) {
+            float difference = fabsf(phase - reference_phase[i]);
+            difference = fminf(difference, 2.0f * (float)M_PI - difference);
+            *worst_phase_error = fmaxf(*worst_phase_error, difference);
+        }
+    }
+    return worst;
+}
+
+void setUp(void) {
+    srand(3);
+    memset(history, 0, sizeof(history));
+    init_window();
+    init_bins();
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Same magnitudes and phases as the windowed Goertzel
+// =============================================================================
+static void run_tempos(const float* tempos, int count, float* worst, float* worst_phase) {
+    uint32_t frame = 0;
+    *worst = 0.0f;
+    *worst_phase = 0.0f;
+    for (int t = 0; t < count; t++) {
+        for (uint32_t n = 0; n < 1500; n++) {
+            push(novelty_sample(frame++, tempos[t]));
+            if (n % 250 == 249) {
+                float phase_error;
+                *worst = fmaxf(*worst, worst_magnitude_error(1.7f, &phase_error));
+                *worst_phase = fmaxf(*worst_phase, phase_error);
+            }
+        }
+    }
+}
+
+void test_matches_goertzel(void) {
+    const float tempos[] = { 72.0f, 120.0f, 128.0f, 150.0f };
+    float worst, worst_phase;
+    run_tempos(tempos, 4, &worst, &worst_phase);
+
+    printf("[TEMPO] %d bins over DFT bins %u..%u, %d window terms: worst magnitude error %.4f of peak, worst phase error %.4f rad\n",
+           NUM_TEMPI, bank.k_first, bank.k_first + bank.count - 1, TEMPO_BANK_WINDOW_TERMS, worst, worst_phase);
+    TEST_ASSERT_TRUE(worst < 0.01f);
+    TEST_ASSERT_TRUE(worst_phase < 0.02f);
+}
+
+// =============================================================================
+// TEST 2: Beats above the tempo range
+// =============================================================================
+// All the energy sits above the highest bin; what the in-range bins see is
+// leakage through the tail of the truncated Gaussian, which the finite
+// window expansion reproduces less exactly (relative to a small peak)
+void test_out_of_range_tempo(void) {
+    const float tempos[] = { 174.0f };
+    float worst, worst_phase;
+    run_tempos(tempos, 1, &worst, &worst_phase);
+
+    printf("[TEMPO] 174 BPM (above range): worst magnitude error %.4f of in-range peak, worst phase error %.4f rad\n",
+           worst, worst_phase);
+    TEST_ASSERT_TRUE(worst < 0.05f);
+}
+
+// =============================================================================
+// TEST 3: No drift after hours of frames
+// =============================================================================
+void test_long_run_stability(void) {
+    // 4 hours at 50 Hz
+    const uint32_t frames = 4 * 3600 * NOVELTY_LOG_HZ;
+    for (uint32_t n = 0; n < frames; n++) {
+        push(novelty_sample(n, 100.0f + 40.0f * sinf(n * 1e-5f)));
+    }
+    float phase_error;
+    float worst = worst_magnitude_error(1.0f, &phase_error);
+
+    // Silence afterwards must decay to (near) zero, not leave a residue
+    float level = 0.0f;
+    for (uint16_t i = 0; i < bank.count; i++) {
+        level = fmaxf(level, fabsf(bank.state_re[i]) + fabsf(bank.state_im[i]));
+    }
+    for (uint32_t n = 0; n < NOVELTY_HISTORY_LENGTH; n++) {
+        push(0.0f);
+    }
+    float residue = 0.0f;
+    for (uint16_t i = 0; i < bank.count; i++) {
+        residue = fmaxf(residue, fabsf(bank.state_re[i]) + fabsf(bank.state_im[i]));
+    }
+
+    printf("[TEMPO] after %lu frames: worst magnitude error %.4f, phase %.4f rad; residue after silence %.1e of level\n",
+           (unsigned long)frames, worst, phase_error, residue / level);
+    TEST_ASSERT_TRUE(worst < 0.01f);
+    TEST_ASSERT_TRUE(residue < level * 1e-4f);
+}
+
+// =============================================================================
+// TEST 4: Cost per frame
+// =============================================================================
+void test_benchmark(void) {
+    for (uint32_t n = 0; n < NOVELTY_HISTORY_LENGTH; n++) {
+        push(novelty_sample(n, 120.0f));
+    }
+    const uint32_t iterations = 200;
+    volatile float sink = 0.0f;
+    float magnitude, phase;
+
+    // smooth_tempi_curve() ran calculate_tempo_magnitudes() twice, each over all bins
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < iterations; n++) {
+        for (int pass = 0; pass < 2; pass++) {
+            for (uint16_t i = 0; i < NUM_TEMPI; i++) {
+                reference_bin(i, 1.0f, &magnitude, &phase);
+                sink = sink + magnitude;
+            }
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < iterations; n++) {
+        tempo_bank_push(bank, 0.5f, 0.25f);
+        for (uint16_t i = 0; i < NUM_TEMPI; i++) {
+            bank_bin(i, 1.0f, &magnitude, &phase);
+            sink = sink + magnitude;
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double goertzel_us = std::chrono::duration<double, std::micro>(t1 - t0).count() / iterations;
+    double bank_us = std::chrono::duration<double, std::micro>(t2 - t1).count() / iterations;
+    printf("[BENCH] per novelty frame: Goertzel x2 %.1f us, sliding bank %.2f us (%.0fx)\n",
+           goertzel_us, bank_us, goertzel_us / bank_us);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_matches_goertzel);
+    RUN_TEST(test_out_of_range_tempo);
+    RUN_TEST(test_long_run_stability);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}
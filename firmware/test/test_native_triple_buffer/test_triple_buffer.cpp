@@ -0,0 +1,161 @@
+/**
+ * TEST SUITE: Triple-Buffered Snapshot (native)
+ *
+ * Validates the zero-copy snapshot publication (triple_buffer.h):
+ * - the writer never picks the published slot or the one being read
+ * - the reader always gets the newest published frame
+ * - a writer and a reader thread: every frame the reader holds stays
+ *   intact for as long as it holds it, and frames never go backwards
+ * - cost per frame vs the old commit copy + snapshot copy with seqlock check (reported)
+ *
+ * Run with: pio test -e native -f test_native_triple_buffer
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include "../../src/audio/triple_buffer.h"
+
+// About the size of AudioDataSnapshot
+#define FRAME_WORDS 512
+
+static triple_buffer buffer;
+static uint32_t slots[TRIPLE_BUFFER_SLOTS][FRAME_WORDS];
+
+static void fill(uint8_t slot, uint32_t frame) {
+    for (uint32_t i = 0; i < FRAME_WORDS; i++) {
+        slots[slot][i] = frame;
+    }
+}
+
+void setUp(void) {
+    triple_buffer_init(buffer);
+    memset(slots, 0, sizeof(slots));
+}
+
+void tearDown(void) {
+}
+
+// =============================================================================
+// TEST 1: Slot choice, single threaded
+// =============================================================================
+void test_slot_choice(void) {
+    for (uint32_t frame = 1; frame < 100; frame++) {
+        const uint8_t filled = buffer.writing;
+        fill(filled, frame);
+        const uint8_t next = triple_buffer_publish(buffer);
+        TEST_ASSERT_EQUAL_UINT8(filled, buffer.published);
+        TEST_ASSERT_TRUE(next != buffer.published);
+        TEST_ASSERT_TRUE(next != buffer.reading);
+
+        // Read every third frame: always the newest
+        if (frame % 3 == 0) {
+            const uint8_t held = triple_buffer_acquire(buffer);
+            TEST_ASSERT_EQUAL_UINT32(frame, slots[held][0]);
+        }
+        TEST_ASSERT_TRUE(buffer.writing != buffer.reading);
+    }
+}
+
+// =============================================================================
+// TEST 2: Writer and reader threads
+// =============================================================================
+void test_two_threads(void) {
+    const uint32_t frames = 100000;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&]() {
+        for (uint32_t frame = 1; frame <= frames; frame++) {
+            fill(buffer.writing, frame);
+            triple_buffer_publish(buffer);
+            if ((frame & 7) == 0) {
+                std::this_thread::yield();
+            }
+        }
+        done = true;
+    });
+
+    uint32_t reads = 0, torn = 0, backwards = 0, last = 0;
+    while (!done) {
+        const uint8_t held = triple_buffer_acquire(buffer);
+        const uint32_t frame = slots[held][0];
+
+        // Hold the frame for a while (a render pass) and re-check it
+        for (int pass = 0; pass < 4; pass++) {
+            for (uint32_t i = 0; i < FRAME_WORDS; i++) {
+                torn += slots[held][i] != frame;
+            }
+            std::this_thread::yield();
+        }
+        backwards += frame < last;
+        last = frame;
+        reads++;
+    }
+    writer.join();
+
+    printf("[SNAPSHOT] %lu frames published, %lu held by the reader: %lu torn words, %lu went backwards\n",
+           (unsigned long)frames, (unsigned long)reads, (unsigned long)torn, (unsigned long)backwards);
+    TEST_ASSERT_TRUE(reads > 10);
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, backwards);
+}
+
+// =============================================================================
+// TEST 3: Cost per frame
+// =============================================================================
+void test_benchmark(void) {
+    const uint32_t iterations = 200000;
+    static uint32_t back[FRAME_WORDS], front[FRAME_WORDS], local[FRAME_WORDS];
+    volatile uint32_t sequence = 0;
+    volatile uint32_t sink = 0;
+
+    // Old: commit memcpy back -> front, reader memcpy front -> local with sequence check
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < iterations; n++) {
+        back[n & (FRAME_WORDS - 1)] = n;
+        sequence = sequence + 1;
+        __sync_synchronize();
+        memcpy(front, back, sizeof(front));
+        __sync_synchronize();
+        sequence = sequence + 1;
+
+        uint32_t s1, s2;
+        do {
+            s1 = sequence;
+            __sync_synchronize();
+            memcpy(local, front, sizeof(local));
+            __sync_synchronize();
+            s2 = sequence;
+        } while (s1 != s2 || (s1 & 1));
+        sink = sink + local[n & (FRAME_WORDS - 1)];
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // New: publish an index, reader takes a pointer
+    for (uint32_t n = 0; n < iterations; n++) {
+        slots[buffer.writing][n & (FRAME_WORDS - 1)] = n;
+        triple_buffer_publish(buffer);
+        const uint32_t* frame = slots[triple_buffer_acquire(buffer)];
+        sink = sink + frame[n & (FRAME_WORDS - 1)];
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double old_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+    double new_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / iterations;
+    printf("[BENCH] per frame (%u-byte snapshot): copy + seqlock %.0f ns, pointer handoff %.0f ns (%.0fx)\n",
+           (unsigned)sizeof(back), old_ns, new_ns, old_ns / new_ns);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_slot_choice);
+    RUN_TEST(test_two_threads);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+// Host-only WAV helpers for the native suites and the host replay (no Arduino dependencies)
+// Reads PCM 16/24/32-bit and 32-bit float WAV (plain or WAVE_FORMAT_EXTENSIBLE), any
+// channel count, mixed down to mono; writes 16-bit mono PCM. No resampling: the analysis
+// is built for 16 kHz, so convert other rates first (sox in.wav -r 16000 out.wav).
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#define WAV_FORMAT_PCM 1
+#define WAV_FORMAT_FLOAT 3
+#define WAV_FORMAT_EXTENSIBLE 0xFFFE
+
+/**
+ * Decoded WAV file: all channels mixed down to mono float samples in -1.0 to 1.0
+ */
+struct WavData {
+    uint32_t sample_rate = 0;
+    uint16_t channels = 0;               // In the file (samples are mono)
+    uint16_t bits_per_sample = 0;
+    std::vector<float> samples;
+};
+
+static inline uint32_t wav_read_u32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint16_t wav_read_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline void wav_put_u32(uint8_t* p, uint32_t value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+    p[2] = (value >> 16) & 0xFF;
+    p[3] = value >> 24;
+}
+
+static inline void wav_put_u16(uint8_t* p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+// One sample of the given encoding at `p`, -1.0 to 1.0
+static inline float wav_decode_sample(const uint8_t* p, uint16_t format, uint16_t bits) {
+    if (format == WAV_FORMAT_FLOAT) {
+        float value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+    switch (bits) {
+        case 16: return (int16_t)wav_read_u16(p) / 32768.0f;
+        case 24: return (int32_t)((p[0] << 8) | (p[1] << 16) | ((uint32_t)p[2] << 24)) / 2147483648.0f;
+        case 32: return (int32_t)wav_read_u32(p) / 2147483648.0f;
+        default: return 0.0f;
+    }
+}
+
+/**
+ * Load a WAV file
+ *
+ * @param error  if not NULL, set to a reason on failure
+ * @return true on success; false for missing or truncated files and unsupported formats
+ */
+inline bool wav_load(const char* path, WavData& out, const char** error = NULL) {
+    const char* reason = NULL;
+    if (error == NULL) {
+        error = &reason;
+    }
+
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        *error = "cannot open file";
+        return false;
+    }
+
+    std::vector<uint8_t> bytes;
+    uint8_t buffer[65536];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + n);
+    }
+    fclose(f);
+
+    if (bytes.size() < 12 || memcmp(&bytes[0], "RIFF", 4) != 0 || memcmp(&bytes[8], "WAVE", 4) != 0) {
+        *error = "not a RIFF/WAVE file";
+        return false;
+    }
+
+    uint16_t format = 0;
+    uint16_t block_align = 0;
+    bool have_format = false;
+    size_t pos = 12;
+    while (pos + 8 <= bytes.size()) {
+        const uint32_t chunk_size = wav_read_u32(&bytes[pos + 4]);
+        const uint8_t* chunk = &bytes[pos + 8];
+        const size_t body_size = std::min((size_t)chunk_size, bytes.size() - pos - 8);
+
+        if (memcmp(&bytes[pos], "fmt ", 4) == 0 && body_size >= 16) {
+            format = wav_read_u16(chunk);
+            out.channels = wav_read_u16(chunk + 2);
+            out.sample_rate = wav_read_u32(chunk + 4);
+            block_align = wav_read_u16(chunk + 12);
+            out.bits_per_sample = wav_read_u16(chunk + 14);
+            if (format == WAV_FORMAT_EXTENSIBLE && body_size >= 26) {
+                format = wav_read_u16(chunk + 24);      // Sub-format GUID starts with the format code
+            }
+            have_format = true;
+        }
+        else if (memcmp(&bytes[pos], "data", 4) == 0) {
+            if (!have_format) {
+                *error = "data before fmt chunk";
+                return false;
+            }
+            const uint16_t bits = out.bits_per_sample;
+            const bool supported = (format == WAV_FORMAT_PCM && (bits == 16 || bits == 24 || bits == 32)) ||
+                                   (format == WAV_FORMAT_FLOAT && bits == 32);
+            if (!supported || out.channels == 0 || block_align != out.channels * (bits / 8)) {
+                *error = "unsupported encoding (PCM 16/24/32-bit or 32-bit float only)";
+                return false;
+            }
+
+            const uint16_t sample_bytes = bits / 8;
+            const size_t frames = body_size / block_align;
+            out.samples.resize(frames);
+            for (size_t i = 0; i < frames; i++) {
+                float sum = 0.0f;
+                for (uint16_t c = 0; c < out.channels; c++) {
+                    sum += wav_decode_sample(chunk + i * block_align + c * sample_bytes, format, bits);
+                }
+                out.samples[i] = sum / out.channels;
+            }
+            return true;
+        }
+        pos += 8 + chunk_size + (chunk_size & 1);    // Chunks are word-aligned
+    }
+
+    *error = "no data chunk";
+    return false;
+}
+
+/**
+ * Write mono 16-bit PCM WAV
+ *
+ * Samples on the 1/32768 grid (what wav_load() returns for 16-bit files) round-trip exactly
+ */
+inline bool wav_save_mono16(const char* path, const float* samples, size_t count, uint32_t sample_rate) {
+    FILE* f = fopen(path, "wb");
+    if (f == NULL) {
+        return false;
+    }
+
+    const uint32_t data_bytes = (uint32_t)(count * 2);
+    uint8_t header[44];
+    memcpy(header, "RIFF", 4);
+    wav_put_u32(header + 4, 36 + data_bytes);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    wav_put_u32(header + 16, 16);
+    wav_put_u16(header + 20, WAV_FORMAT_PCM);
+    wav_put_u16(header + 22, 1);                // mono
+    wav_put_u32(header + 24, sample_rate);
+    wav_put_u32(header + 28, sample_rate * 2);
+    wav_put_u16(header + 32, 2);
+    wav_put_u16(header + 34, 16);
+    memcpy(header + 36, "data", 4);
+    wav_put_u32(header + 40, data_bytes);
+    bool ok = fwrite(header, 1, sizeof(header), f) == sizeof(header);
+
+    std::vector<uint8_t> data(data_bytes);
+    for (size_t i = 0; i < count; i++) {
+        float s = samples[i] * 32768.0f;
+        s = s > 32767.0f ? 32767.0f : (s < -32768.0f ? -32768.0f : s);
+        wav_put_u16(&data[i * 2], (uint16_t)(int16_t)lrintf(s));
+    }
+    ok = ok && fwrite(data.data(), 1, data.size(), f) == data.size();
+    return fclose(f) == 0 && ok;
+}